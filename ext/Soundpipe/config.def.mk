@@ -1,6 +1,7 @@
 # Modules that don't require external libraries go here
 MODULES= \
 base \
+cache \
 ftbl \
 tevent \
 adsr \
@@ -10,10 +11,12 @@ autowah \
 bal \
 bar \
 biquad \
+biquads \
 biscale \
 blsaw \
 blsquare \
 bltriangle \
+fdline \
 fold \
 bitcrush \
 brown \
@@ -53,6 +56,7 @@ line \
 lpc \
 lpf18 \
 maygate \
+mbcomp \
 metro \
 mincer \
 mode \
@@ -61,6 +65,7 @@ noise \
 nsmp \
 osc \
 oscmorph \
+oversample \
 pan2 \
 panst \
 pareq \
@@ -77,7 +82,9 @@ posc3 \
 progress \
 prop \
 pshift \
+pshift2 \
 ptrack \
+psola \
 randh \
 randi \
 randmt \
@@ -117,8 +124,11 @@ trand \
 tseg \
 tseq \
 vdelay \
+vnoise \
 voc \
+vocbank \
 vocoder \
+wavetable \
 waveset \
 wavin \
 wavout \
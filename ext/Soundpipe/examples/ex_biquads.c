@@ -0,0 +1,45 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_biquads *bq;
+    sp_noise *ns;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT frame[SP_BIQUADS_LANES] = {0};
+
+    sp_noise_compute(sp, ud->ns, NULL, &frame[0]);
+    sp_biquads_compute(sp, ud->bq, frame, frame);
+    sp->out[0] = frame[0];
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+    srand(1234567);
+
+    sp_biquads_create(&ud.bq);
+    sp_noise_create(&ud.ns);
+
+    /* low cut, a mid boost and a high shelf cut on lane 0 */
+    sp_biquads_init(sp, ud.bq, 3);
+    sp_biquads_design(sp, ud.bq, 0, 0, SP_BIQUADS_HIGHPASS, 80, 0.707, 0);
+    sp_biquads_design(sp, ud.bq, 1, 0, SP_BIQUADS_PEAK, 1000, 1.5, 9);
+    sp_biquads_design(sp, ud.bq, 2, 0, SP_BIQUADS_HIGHSHELF, 6000, 0.707, -12);
+    sp_noise_init(sp, ud.ns);
+    ud.ns->amp = 0.3;
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_biquads_destroy(&ud.bq);
+    sp_noise_destroy(&ud.ns);
+
+    sp_destroy(&sp);
+    return 0;
+}
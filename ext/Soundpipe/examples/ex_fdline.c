@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#define BLOCK 64
+
+typedef struct {
+    sp_fdline *del;
+    sp_osc *osc;
+    sp_ftbl *ft;
+    sp_tenv *env;
+    sp_metro *met;
+    SPFLOAT in[BLOCK], time[BLOCK], out[BLOCK];
+    uint32_t pos;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT trig, env, osc;
+    uint32_t n;
+
+    if(ud->pos == 0) {
+        for(n = 0; n < BLOCK; n++) {
+            sp_metro_compute(sp, ud->met, NULL, &trig);
+            sp_tenv_compute(sp, ud->env, &trig, &env);
+            sp_osc_compute(sp, ud->osc, NULL, &osc);
+            ud->in[n] = osc * env;
+            /* 300 ms, chorused by 2 ms at 0.5 Hz */
+            ud->time[n] = sp->sr * (0.3 +
+                0.002 * sin(2 * M_PI * 0.5 * (sp->pos + n) / sp->sr));
+        }
+        sp_fdline_compute_block(sp, ud->del, ud->in, ud->time, ud->out,
+            BLOCK);
+        for(n = 0; n < BLOCK; n++) ud->out[n] = 0.5 * ud->out[n] + ud->in[n];
+    }
+    sp->out[0] = ud->out[ud->pos];
+    ud->pos = (ud->pos + 1) % BLOCK;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+    sp_srand(sp, 1234567);
+
+    sp_fdline_create(&ud.del);
+    sp_osc_create(&ud.osc);
+    sp_ftbl_create(sp, &ud.ft, 2048);
+    sp_tenv_create(&ud.env);
+    sp_metro_create(&ud.met);
+
+    sp_fdline_init(sp, ud.del, 1.0);
+    ud.del->feedback = 0.6;
+    sp_gen_sine(sp, ud.ft);
+    sp_osc_init(sp, ud.osc, ud.ft, 0);
+    ud.osc->freq = 440;
+    sp_tenv_init(sp, ud.env);
+    ud.env->atk = 0.001;
+    ud.env->hold = 0.01;
+    ud.env->rel = 0.1;
+    sp_metro_init(sp, ud.met);
+    ud.met->freq = 0.5;
+    ud.pos = 0;
+
+    sp->len = 44100 * 6;
+    sp_process(sp, &ud, process);
+
+    sp_fdline_destroy(&ud.del);
+    sp_osc_destroy(&ud.osc);
+    sp_ftbl_destroy(&ud.ft);
+    sp_tenv_destroy(&ud.env);
+    sp_metro_destroy(&ud.met);
+
+    sp_destroy(&sp);
+    return 0;
+}
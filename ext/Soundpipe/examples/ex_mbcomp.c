@@ -0,0 +1,47 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_mbcomp *mb;
+    sp_noise *ns;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT in = 0, out1 = 0, out2 = 0;
+
+    sp_noise_compute(sp, ud->ns, NULL, &in);
+    sp_mbcomp_compute(sp, ud->mb, &in, &in, &out1, &out2);
+    sp->out[0] = out1;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    int i;
+    sp_create(&sp);
+    srand(1234567);
+
+    sp_mbcomp_create(&ud.mb);
+    sp_noise_create(&ud.ns);
+
+    sp_mbcomp_init(sp, ud.mb);
+    for(i = 0; i < SP_MBCOMP_BANDS; i++) {
+        ud.mb->thresh[i] = -30;
+        ud.mb->ratio[i] = 4;
+        ud.mb->makeup[i] = 6;
+    }
+    sp_noise_init(sp, ud.ns);
+    ud.ns->amp = 0.5;
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_mbcomp_destroy(&ud.mb);
+    sp_noise_destroy(&ud.ns);
+
+    sp_destroy(&sp);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_oversample *os;
+    sp_dist *dist;
+    sp_osc *osc;
+    sp_ftbl *ft;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT osc = 0, out = 0;
+    SPFLOAT up[4];
+    int i;
+
+    sp_osc_compute(sp, ud->osc, NULL, &osc);
+
+    /* run the distortion at 4 times the rate */
+    sp_oversample_up(sp, ud->os, &osc, up, 1);
+    for(i = 0; i < 4; i++) sp_dist_compute(sp, ud->dist, &up[i], &up[i]);
+    sp_oversample_down(sp, ud->os, up, &out, 1);
+
+    sp->out[0] = out;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+
+    sp_oversample_create(&ud.os);
+    sp_dist_create(&ud.dist);
+    sp_osc_create(&ud.osc);
+    sp_ftbl_create(sp, &ud.ft, 2048);
+
+    sp_oversample_init(sp, ud.os, 4);
+    sp_dist_init(sp, ud.dist);
+    ud.dist->pregain = 4;
+    sp_gen_sine(sp, ud.ft);
+    sp_osc_init(sp, ud.osc, ud.ft, 0);
+    ud.osc->freq = 3000;
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_oversample_destroy(&ud.os);
+    sp_dist_destroy(&ud.dist);
+    sp_osc_destroy(&ud.osc);
+    sp_ftbl_destroy(&ud.ft);
+
+    sp_destroy(&sp);
+    return 0;
+}
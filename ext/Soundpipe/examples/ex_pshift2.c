@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_pshift2 *pshift;
+    sp_diskin *diskin;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT diskin = 0, out1 = 0, out2 = 0;
+    sp_diskin_compute(sp, ud->diskin, NULL, &diskin);
+    sp_pshift2_compute(sp, ud->pshift, &diskin, &diskin, &out1, &out2);
+    sp->out[0] = out1;
+    sp->out[1] = out2;
+}
+
+int main() {
+    srand(1234567);
+    UserData ud;
+    sp_data *sp;
+    sp_createn(&sp, 2);
+
+    sp_pshift2_create(&ud.pshift);
+    sp_diskin_create(&ud.diskin);
+
+    sp_pshift2_init(sp, ud.pshift, 10000);
+    ud.pshift->shift = 7;
+    ud.pshift->window = 500;
+    /* half window size is smoothest sounding */
+    ud.pshift->xfade = 250;
+    sp_diskin_init(sp, ud.diskin, "oneart.wav");
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_pshift2_destroy(&ud.pshift);
+    sp_diskin_destroy(&ud.diskin);
+
+    sp_destroy(&sp);
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_psola *psola;
+    sp_diskin *diskin;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT diskin = 0, out1 = 0, out2 = 0;
+    sp_diskin_compute(sp, ud->diskin, NULL, &diskin);
+    sp_psola_compute(sp, ud->psola, &diskin, &diskin, &out1, &out2);
+    sp->out[0] = out1;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+
+    sp_psola_create(&ud.psola);
+    sp_diskin_create(&ud.diskin);
+
+    /* lowest tracked pitch, sets the latency */
+    sp_psola_init(sp, ud.psola, 80);
+    ud.psola->shift = 7;
+    sp_diskin_init(sp, ud.diskin, "oneart.wav");
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_psola_destroy(&ud.psola);
+    sp_diskin_destroy(&ud.diskin);
+
+    sp_destroy(&sp);
+    return 0;
+}
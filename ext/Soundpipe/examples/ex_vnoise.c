@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+#define BLOCK 64
+
+typedef struct {
+    sp_vnoise *ns;
+    SPFLOAT buf[BLOCK];
+    uint32_t pos;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+
+    if(ud->pos == 0) {
+        /* white, pink, then brown */
+        ud->ns->type = sp->pos * 3 / sp->len;
+        sp_vnoise_compute_block(sp, ud->ns, ud->buf, BLOCK);
+    }
+    sp->out[0] = ud->buf[ud->pos];
+    ud->pos = (ud->pos + 1) % BLOCK;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+    sp_srand(sp, 1234567);
+
+    sp_vnoise_create(&ud.ns);
+    sp_vnoise_init(sp, ud.ns);
+    ud.ns->amp = 0.5;
+    ud.pos = 0;
+
+    sp->len = 44100 * 6;
+    sp_process(sp, &ud, process);
+
+    sp_vnoise_destroy(&ud.ns);
+
+    sp_destroy(&sp);
+    return 0;
+}
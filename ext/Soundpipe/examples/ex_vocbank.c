@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+typedef struct {
+    sp_vocbank *vb;
+    sp_blsaw *saw;
+    sp_noise *ns;
+    sp_osc *lfo;
+    sp_ftbl *ft;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    SPFLOAT car = 0, mod = 0, amp = 0, out = 0;
+
+    sp_blsaw_compute(sp, ud->saw, NULL, &car);
+    sp_osc_compute(sp, ud->lfo, NULL, &amp);
+    sp_noise_compute(sp, ud->ns, NULL, &mod);
+    mod *= 0.5 + 0.5 * amp;
+    sp_vocbank_compute(sp, ud->vb, &car, &mod, &out);
+    sp->out[0] = out * 8;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    sp_create(&sp);
+    srand(1234567);
+
+    sp_vocbank_create(&ud.vb);
+    sp_blsaw_create(&ud.saw);
+    sp_noise_create(&ud.ns);
+    sp_osc_create(&ud.lfo);
+    sp_ftbl_create(sp, &ud.ft, 2048);
+
+    sp_vocbank_init(sp, ud.vb, 32);
+    ud.vb->rel = 0.1;
+    sp_blsaw_init(sp, ud.saw);
+    *ud.saw->freq = 110;
+    *ud.saw->amp = 0.5;
+    sp_noise_init(sp, ud.ns);
+    sp_gen_sine(sp, ud.ft);
+    sp_osc_init(sp, ud.lfo, ud.ft, 0);
+    ud.lfo->freq = 3;
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_vocbank_destroy(&ud.vb);
+    sp_blsaw_destroy(&ud.saw);
+    sp_noise_destroy(&ud.ns);
+    sp_osc_destroy(&ud.lfo);
+    sp_ftbl_destroy(&ud.ft);
+
+    sp_destroy(&sp);
+    return 0;
+}
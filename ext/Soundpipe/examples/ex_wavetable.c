@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "soundpipe.h"
+
+#define SIZE 2048
+#define NVOICES 3
+#define BLOCK 64
+
+typedef struct {
+    sp_wavetable *wt;
+    uint32_t phs[NVOICES];
+    SPFLOAT freq[NVOICES], wtpos[NVOICES], amp[NVOICES];
+    SPFLOAT buf[BLOCK];
+    uint32_t pos;
+} UserData;
+
+void process(sp_data *sp, void *udata) {
+    UserData *ud = udata;
+    int i;
+
+    if(ud->pos == 0) {
+        /* sweep the chord up and morph from saw to square */
+        for(i = 0; i < NVOICES; i++) {
+            ud->freq[i] *= 1.003;
+            ud->wtpos[i] = (SPFLOAT)sp->pos / sp->len;
+        }
+        sp_wavetable_compute(sp, ud->wt, NVOICES, ud->phs,
+            ud->freq, ud->wtpos, ud->amp, ud->buf, BLOCK);
+    }
+    sp->out[0] = ud->buf[ud->pos];
+    ud->pos = (ud->pos + 1) % BLOCK;
+}
+
+int main() {
+    UserData ud;
+    sp_data *sp;
+    SPFLOAT wave[SIZE];
+    int i;
+    sp_create(&sp);
+
+    sp_wavetable_create(&ud.wt);
+    sp_wavetable_init(sp, ud.wt, SIZE, 2);
+
+    /* frame 0 is a saw, frame 1 a square */
+    for(i = 0; i < SIZE; i++) wave[i] = 1 - 2.0 * i / SIZE;
+    sp_wavetable_gen(sp, ud.wt, 0, wave);
+    for(i = 0; i < SIZE; i++) wave[i] = i < SIZE / 2 ? 1 : -1;
+    sp_wavetable_gen(sp, ud.wt, 1, wave);
+
+    for(i = 0; i < NVOICES; i++) {
+        ud.phs[i] = 0;
+        ud.amp[i] = 0.2;
+    }
+    ud.freq[0] = 110;
+    ud.freq[1] = 138.6;
+    ud.freq[2] = 164.8;
+    ud.pos = 0;
+
+    sp->len = 44100 * 5;
+    sp_process(sp, &ud, process);
+
+    sp_wavetable_destroy(&ud.wt);
+
+    sp_destroy(&sp);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdio.h>
+#include <math.h>
 
 #define SP_BUFSIZE 4096
 #ifndef SPFLOAT
@@ -8,6 +9,15 @@
 #define SP_OK 1
 #define SP_NOT_OK 0
 
+/* Builds the function for several instruction sets. The variant for the
+ * CPU is picked once, when the library is loaded. */
+#ifdef HAVE_TARGET_CLONES
+#define SP_TARGET_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SP_TARGET_CLONES
+#endif
+
 #define SP_RANDMAX 2147483648
 
 typedef unsigned long sp_frame;
@@ -46,6 +56,74 @@ int sp_process_spa(sp_data *sp, void *ud, void (*callback)(sp_data *, void *));
 
 SPFLOAT sp_midi2cps(SPFLOAT nn);
 
+/* Fast approximations of log2, exp2 and the functions built on them.
+ * They are branch-free so that loops calling them can be vectorized,
+ * and t_fastmath checks them against libm. The plugins call them too,
+ * so this is the only copy. */
+
+/* log2 of a positive float, max abs error about 6e-6. Zero returns -127. */
+static inline float sp_fast_log2(float x)
+{
+    union { float f; uint32_t i; } v;
+    int32_t e;
+    float t;
+
+    /* split into an exponent and a mantissa in [sqrt(0.5), sqrt(2)) */
+    v.f = x;
+    e = (int32_t)(v.i - 0x3f3504f3) >> 23;
+    v.i -= (uint32_t)e << 23;
+    t = v.f - 1;
+    return (float)e + t * (1.44271348f + t * (-0.721131859f +
+        t * (0.479348018f + t * (-0.367489975f +
+        t * (0.32215481f + t * -0.20659177f)))));
+}
+
+/* 2^x, max relative error about 3e-7. Finite x outside [-125, 126] is
+ * clamped to that range. Clamping is done on the integer part and with
+ * fabs, which keeps it vectorizable. */
+static inline float sp_fast_exp2(float x)
+{
+    union { float f; uint32_t i; } v;
+    int32_t i;
+    float f;
+
+    i = (int32_t)(x + 127.5f);
+    i = i < 2 ? 2 : i;
+    i = i > 253 ? 253 : i;
+    f = x - (float)(i - 127);
+    f = 0.5f * (fabsf(f + 1) - fabsf(f - 1));
+    v.i = (uint32_t)i << 23;
+    return v.f * (1 + f * (0.693147215f + f * (0.240222346f +
+        f * (0.0555030836f + f * (0.00967187507f + f * 0.0013407259f)))));
+}
+
+static inline float sp_fast_exp(float x)
+{
+    return sp_fast_exp2(x * 1.44269504f);
+}
+
+/* x^y for x > 0 */
+static inline float sp_fast_pow(float x, float y)
+{
+    return sp_fast_exp2(y * sp_fast_log2(x));
+}
+
+static inline float sp_fast_lin2db(float x)
+{
+    return sp_fast_log2(x) * 6.02059991f;
+}
+
+static inline float sp_fast_db2lin(float x)
+{
+    return sp_fast_exp2(x * 0.166096405f);
+}
+
+/* max abs error about 3e-7, saturates to +-1 */
+static inline float sp_fast_tanh(float x)
+{
+    return 1 - 2 / (sp_fast_exp2(x * 2.88539008f) + 1);
+}
+
 int sp_set(sp_param *p, SPFLOAT val);
 
 int sp_out(sp_data *sp, uint32_t chan, SPFLOAT val);
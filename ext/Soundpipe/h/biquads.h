@@ -0,0 +1,40 @@
+#define SP_BIQUADS_LANES 4
+
+enum {
+    SP_BIQUADS_BYPASS,
+    SP_BIQUADS_PEAK,
+    SP_BIQUADS_LOWSHELF,
+    SP_BIQUADS_HIGHSHELF,
+    SP_BIQUADS_LOWPASS,
+    SP_BIQUADS_HIGHPASS,
+    SP_BIQUADS_BANDPASS,
+    SP_BIQUADS_NOTCH
+};
+
+typedef struct {
+    SPFLOAT b0[SP_BIQUADS_LANES];
+    SPFLOAT b1[SP_BIQUADS_LANES];
+    SPFLOAT b2[SP_BIQUADS_LANES];
+    SPFLOAT a1[SP_BIQUADS_LANES];
+    SPFLOAT a2[SP_BIQUADS_LANES];
+    SPFLOAT z1[SP_BIQUADS_LANES];
+    SPFLOAT z2[SP_BIQUADS_LANES];
+} sp_biquads_stage;
+
+typedef struct {
+    int nstages;
+    sp_biquads_stage *stage;
+    sp_auxdata buf;
+} sp_biquads;
+
+int sp_biquads_create(sp_biquads **p);
+int sp_biquads_destroy(sp_biquads **p);
+int sp_biquads_init(sp_data *sp, sp_biquads *p, int nstages);
+int sp_biquads_set(sp_data *sp, sp_biquads *p, int stage, int lane,
+    SPFLOAT b0, SPFLOAT b1, SPFLOAT b2, SPFLOAT a1, SPFLOAT a2);
+int sp_biquads_design(sp_data *sp, sp_biquads *p, int stage, int lane,
+    int type, SPFLOAT freq, SPFLOAT q, SPFLOAT gain);
+int sp_biquads_clear(sp_data *sp, sp_biquads *p);
+int sp_biquads_compute(sp_data *sp, sp_biquads *p, SPFLOAT *in, SPFLOAT *out);
+int sp_biquads_compute_block(sp_data *sp, sp_biquads *p,
+    SPFLOAT *in, SPFLOAT *out, uint32_t nframes);
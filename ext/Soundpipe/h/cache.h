@@ -0,0 +1,25 @@
+/* Shared read-only data, see modules/cache.c */
+
+#define SP_CACHE_NPARAMS 4
+
+enum {
+    SP_CACHE_FFT_COS,
+    SP_CACHE_FFT_BITREV,
+    SP_CACHE_PTRACK_SIN,
+    /* kinds from here on are free for users of the library */
+    SP_CACHE_USER = 0x10000
+};
+
+typedef struct {
+    uint32_t kind;
+    uint32_t size;
+    int sr;
+    SPFLOAT params[SP_CACHE_NPARAMS];
+} sp_cache_key;
+
+typedef int (*sp_cache_gen)(void *data, const sp_cache_key *key, void *ud);
+
+const void *sp_cache_get(const sp_cache_key *key, size_t nbytes,
+    sp_cache_gen gen, void *ud);
+void sp_cache_release(const void *data);
+int sp_cache_count(void);
@@ -0,0 +1,19 @@
+#define SP_FDLINE_BLOCK 64
+
+typedef struct {
+    SPFLOAT feedback;
+
+    uint32_t size, mask, wpos;
+    SPFLOAT mindel, maxdel;
+    SPFLOAT *buf;
+    sp_auxdata aux;
+} sp_fdline;
+
+int sp_fdline_create(sp_fdline **p);
+int sp_fdline_destroy(sp_fdline **p);
+int sp_fdline_init(sp_data *sp, sp_fdline *p, SPFLOAT maxdel);
+int sp_fdline_clear(sp_data *sp, sp_fdline *p);
+int sp_fdline_compute(sp_data *sp, sp_fdline *p,
+    SPFLOAT *in, SPFLOAT *del, SPFLOAT *out);
+int sp_fdline_compute_block(sp_data *sp, sp_fdline *p,
+    const SPFLOAT *in, const SPFLOAT *del, SPFLOAT *out, uint32_t nsmps);
@@ -0,0 +1,29 @@
+#define SP_MBCOMP_BANDS SP_BIQUADS_LANES
+#define SP_MBCOMP_BLOCK 64
+
+typedef struct {
+    SPFLOAT freq[SP_MBCOMP_BANDS - 1];
+    SPFLOAT thresh[SP_MBCOMP_BANDS];
+    SPFLOAT ratio[SP_MBCOMP_BANDS];
+    SPFLOAT atk[SP_MBCOMP_BANDS];
+    SPFLOAT rel[SP_MBCOMP_BANDS];
+    SPFLOAT makeup[SP_MBCOMP_BANDS];
+    SPFLOAT gr[SP_MBCOMP_BANDS];
+
+    SPFLOAT prvfreq[SP_MBCOMP_BANDS - 1];
+    SPFLOAT prvatk[SP_MBCOMP_BANDS], prvrel[SP_MBCOMP_BANDS];
+    SPFLOAT atkcoef[SP_MBCOMP_BANDS], relcoef[SP_MBCOMP_BANDS];
+    SPFLOAT env[SP_MBCOMP_BANDS];
+    sp_biquads *xover[2];
+    SPFLOAT *band[2], *gain;
+    sp_auxdata buf;
+} sp_mbcomp;
+
+int sp_mbcomp_create(sp_mbcomp **p);
+int sp_mbcomp_destroy(sp_mbcomp **p);
+int sp_mbcomp_init(sp_data *sp, sp_mbcomp *p);
+int sp_mbcomp_compute(sp_data *sp, sp_mbcomp *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_mbcomp_compute_block(sp_data *sp, sp_mbcomp *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps);
@@ -0,0 +1,25 @@
+#define SP_OVERSAMPLE_MAXSTAGES 3
+#define SP_OVERSAMPLE_MAXTAPS 16
+#define SP_OVERSAMPLE_BLOCK 64
+
+typedef struct {
+    int ntaps;
+    SPFLOAT coefs[SP_OVERSAMPLE_MAXTAPS];
+    SPFLOAT *up, *down_even, *down_odd;
+} sp_oversample_stage;
+
+typedef struct {
+    int factor, nstages;
+    SPFLOAT latency;
+    sp_oversample_stage stage[SP_OVERSAMPLE_MAXSTAGES];
+    SPFLOAT *tmp[2], *odd;
+    sp_auxdata buf;
+} sp_oversample;
+
+int sp_oversample_create(sp_oversample **p);
+int sp_oversample_destroy(sp_oversample **p);
+int sp_oversample_init(sp_data *sp, sp_oversample *p, int factor);
+int sp_oversample_up(sp_data *sp, sp_oversample *p,
+    SPFLOAT *in, SPFLOAT *up, uint32_t nsmps);
+int sp_oversample_down(sp_data *sp, sp_oversample *p,
+    SPFLOAT *up, SPFLOAT *out, uint32_t nsmps);
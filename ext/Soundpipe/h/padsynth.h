@@ -12,3 +12,16 @@ int sp_padsynth_ifft(int N, SPFLOAT *freq_amp,
         SPFLOAT *freq_phase, SPFLOAT *smp); 
 
 int sp_padsynth_normalize(int N, SPFLOAT *smp);
+
+/* PADsynth table, either rendered in memory or mapped from a cache file */
+typedef struct sp_padsynth_tbl {
+    const SPFLOAT *tbl;
+    uint32_t size;
+    void *mem;
+    size_t len;
+    int mapped;
+} sp_padsynth_tbl;
+
+int sp_padsynth_load(sp_data *sp, sp_padsynth_tbl *pt, const char *dir,
+        uint32_t size, const SPFLOAT *amps, int nharm, SPFLOAT f, SPFLOAT bw);
+void sp_padsynth_unload(sp_padsynth_tbl *pt);
@@ -0,0 +1,17 @@
+typedef struct {
+    SPFLOAT shift, window, xfade;
+    SPFLOAT phs, inc;
+    SPFLOAT prvshift, prvwindow;
+    sp_auxdata buf;
+    uint32_t pos, mask;
+} sp_pshift2;
+
+int sp_pshift2_create(sp_pshift2 **p);
+int sp_pshift2_destroy(sp_pshift2 **p);
+int sp_pshift2_init(sp_data *sp, sp_pshift2 *p, SPFLOAT maxwindow);
+int sp_pshift2_clear(sp_data *sp, sp_pshift2 *p);
+int sp_pshift2_compute(sp_data *sp, sp_pshift2 *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_pshift2_compute_block(sp_data *sp, sp_pshift2 *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps);
@@ -0,0 +1,19 @@
+typedef struct {
+    SPFLOAT shift;
+    SPFLOAT minfreq, maxfreq;
+    SPFLOAT sr, period, lag, syn;
+    uint32_t tmax, latency;
+    uint32_t pos, inmask, outmask;
+    sp_auxdata in, out, mono;
+    sp_ptrack *ptrack;
+} sp_psola;
+
+int sp_psola_create(sp_psola **p);
+int sp_psola_destroy(sp_psola **p);
+int sp_psola_init(sp_data *sp, sp_psola *p, SPFLOAT minfreq);
+int sp_psola_clear(sp_data *sp, sp_psola *p);
+int sp_psola_compute(sp_data *sp, sp_psola *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_psola_compute_block(sp_data *sp, sp_psola *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps);
@@ -1,7 +1,8 @@
 typedef struct {
     SPFLOAT freq, amp;
     SPFLOAT asig,size,peak;
-    sp_auxdata signal, prev, sin, spec1, spec2, peakarray;
+    sp_auxdata signal, prev, spec1, spec2, peakarray;
+    const SPFLOAT *sin;
     int numpks;
     int cnt;
     int histcnt;
@@ -21,3 +22,5 @@ int sp_ptrack_create(sp_ptrack **p);
 int sp_ptrack_destroy(sp_ptrack **p);
 int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks);
 int sp_ptrack_compute(sp_data *sp, sp_ptrack *p, SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp);
+int sp_ptrack_compute_block(sp_data *sp, sp_ptrack *p, SPFLOAT *in,
+    uint32_t nsmps, SPFLOAT *freq, SPFLOAT *amp);
@@ -13,3 +13,4 @@ int sp_saturator_create(sp_saturator **p);
 int sp_saturator_destroy(sp_saturator **p);
 int sp_saturator_init(sp_data *sp, sp_saturator *p);
 int sp_saturator_compute(sp_data *sp, sp_saturator *p, SPFLOAT *in, SPFLOAT *out);
+int sp_saturator_shape(sp_data *sp, sp_saturator *p, SPFLOAT *in, SPFLOAT *out);
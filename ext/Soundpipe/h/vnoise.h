@@ -0,0 +1,26 @@
+#define SP_VNOISE_LANES 8
+
+enum {
+    SP_VNOISE_WHITE,
+    SP_VNOISE_PINK,
+    SP_VNOISE_BROWN
+};
+
+typedef struct {
+    SPFLOAT amp;
+    int type;
+
+    uint32_t state[SP_VNOISE_LANES];
+    SPFLOAT pool[SP_VNOISE_LANES];
+    int npool;
+    SPFLOAT pink[SP_VNOISE_LANES], prev;
+    SPFLOAT brown, bcoef, bgain;
+} sp_vnoise;
+
+int sp_vnoise_create(sp_vnoise **p);
+int sp_vnoise_destroy(sp_vnoise **p);
+int sp_vnoise_init(sp_data *sp, sp_vnoise *p);
+int sp_vnoise_seed(sp_data *sp, sp_vnoise *p, uint32_t seed);
+int sp_vnoise_compute(sp_data *sp, sp_vnoise *p, SPFLOAT *in, SPFLOAT *out);
+int sp_vnoise_compute_block(sp_data *sp, sp_vnoise *p,
+    SPFLOAT *out, uint32_t nsmps);
@@ -0,0 +1,32 @@
+#define SP_VOCBANK_LANES 8
+
+/* SP_VOCBANK_LANES bands */
+typedef struct {
+    SPFLOAT b0[SP_VOCBANK_LANES];
+    SPFLOAT a1[SP_VOCBANK_LANES];
+    SPFLOAT a2[SP_VOCBANK_LANES];
+    SPFLOAT env[SP_VOCBANK_LANES];
+    SPFLOAT mz[4][SP_VOCBANK_LANES];
+    SPFLOAT cz[4][SP_VOCBANK_LANES];
+} sp_vocbank_group;
+
+typedef struct {
+    SPFLOAT atk, rel, bwratio, fmin, fmax;
+    int nbands;
+
+    int maxbands, ngroups, nactive;
+    SPFLOAT prvatk, prvrel, prvbwratio, prvfmin, prvfmax;
+    int prvnbands;
+    SPFLOAT kup, kdn;
+    sp_vocbank_group *group;
+    sp_auxdata buf;
+} sp_vocbank;
+
+int sp_vocbank_create(sp_vocbank **p);
+int sp_vocbank_destroy(sp_vocbank **p);
+int sp_vocbank_init(sp_data *sp, sp_vocbank *p, int maxbands);
+int sp_vocbank_clear(sp_data *sp, sp_vocbank *p);
+int sp_vocbank_compute(sp_data *sp, sp_vocbank *p,
+    SPFLOAT *car, SPFLOAT *mod, SPFLOAT *out);
+int sp_vocbank_compute_block(sp_data *sp, sp_vocbank *p,
+    SPFLOAT *car, SPFLOAT *mod, SPFLOAT *out, uint32_t nsmps);
@@ -0,0 +1,19 @@
+typedef struct {
+    uint32_t size, stride, lobits, lomask;
+    SPFLOAT lodiv;
+    int nlevels, nframes;
+    SPFLOAT *tbl;
+    kiss_fftr_cfg fft, ifft;
+    kiss_fft_cpx *spec, *tmp;
+    SPFLOAT *wave;
+    sp_auxdata buf;
+} sp_wavetable;
+
+int sp_wavetable_create(sp_wavetable **p);
+int sp_wavetable_destroy(sp_wavetable **p);
+int sp_wavetable_init(sp_data *sp, sp_wavetable *p, uint32_t size, int nframes);
+int sp_wavetable_gen(sp_data *sp, sp_wavetable *p, int frame, const SPFLOAT *wave);
+int sp_wavetable_level(sp_data *sp, sp_wavetable *p, SPFLOAT freq);
+int sp_wavetable_compute(sp_data *sp, sp_wavetable *p, uint32_t nvoices,
+    uint32_t *phs, const SPFLOAT *freq, const SPFLOAT *wtpos,
+    const SPFLOAT *amp, SPFLOAT *out, uint32_t nsmps);
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "base.h"
+#include "cache.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -416,6 +417,7 @@ static void fft8pt(SPFLOAT *ioptr)
     ioptr[15] = f6i;
 }
 
+SP_TARGET_CLONES
 static void bfR2(SPFLOAT *ioptr, int M, int NDiffU)
 {
     /*** 2nd radix 2 stage ***/
@@ -523,6 +525,7 @@ static void bfR2(SPFLOAT *ioptr, int M, int NDiffU)
     }
 }
 
+SP_TARGET_CLONES
 static void bfR4(SPFLOAT *ioptr, int M, int NDiffU)
 {
     /*** 1 radix 4 stage ***/
@@ -730,6 +733,7 @@ static void bfR4(SPFLOAT *ioptr, int M, int NDiffU)
     *(p0r + posi) = f4i;
 }
 
+SP_TARGET_CLONES
 static void bfstages(SPFLOAT *ioptr, int M, SPFLOAT *Utbl, int Ustride,
                      int NDiffU, int StageCnt)
 {
@@ -1456,6 +1460,7 @@ static void ifft8pt(SPFLOAT *ioptr, SPFLOAT scale)
     ioptr[15] = scale * f6i;
 }
 
+SP_TARGET_CLONES
 static void ibfR2(SPFLOAT *ioptr, int M, int NDiffU)
 {
     /*** 2nd radix 2 stage ***/
@@ -1563,6 +1568,7 @@ static void ibfR2(SPFLOAT *ioptr, int M, int NDiffU)
     }
 }
 
+SP_TARGET_CLONES
 static void ibfR4(SPFLOAT *ioptr, int M, int NDiffU)
 {
     /*** 1 radix 4 stage ***/
@@ -1770,6 +1776,7 @@ static void ibfR4(SPFLOAT *ioptr, int M, int NDiffU)
     *(p0r + posi) = f4i;
 }
 
+SP_TARGET_CLONES
 static void ibfstages(SPFLOAT *ioptr, int M, SPFLOAT *Utbl, int Ustride,
                       int NDiffU, int StageCnt)
 {
@@ -2442,6 +2449,7 @@ static void rfft8pt(SPFLOAT *ioptr)
     ioptr[15] = scale * f6i;
 }
 
+SP_TARGET_CLONES
 static void frstage(SPFLOAT *ioptr, int M, SPFLOAT *Utbl)
 {
     /*      Finish RFFT             */
@@ -2905,6 +2913,7 @@ static void rifft8pt(SPFLOAT *ioptr, SPFLOAT scale)
     ioptr[15] = scale * f6i;
 }
 
+SP_TARGET_CLONES
 static void ifrstage(SPFLOAT *ioptr, int M, SPFLOAT *Utbl)
 {
     /*      Start RIFFT             */
@@ -3084,29 +3093,39 @@ static void riffts1(SPFLOAT *ioptr, int M, SPFLOAT *Utbl, int16_t *BRLow)
     }
 }
 
-void sp_fft_init(sp_fft *fft, int M)
+/* the tables only depend on the size, so instances share them */
+static int gen_cos(void *data, const sp_cache_key *key, void *ud)
 {
-    SPFLOAT *utbl;
-    int16_t *BRLow;
-    int16_t *BRLowCpx;
-    int i;
+    fftCosInit((int)key->size, (SPFLOAT *)data);
+    return SP_OK;
+}
+
+static int gen_bitrev(void *data, const sp_cache_key *key, void *ud)
+{
+    fftBRInit((int)key->size, (int16_t *)data);
+    return SP_OK;
+}
 
-    /* init cos table */
-    utbl = (SPFLOAT*) malloc((POW2(M) / 4 + 1) * sizeof(SPFLOAT));
-    fftCosInit(M, utbl);
+static const void *get_bitrev(int M)
+{
+    sp_cache_key key = {.kind = SP_CACHE_FFT_BITREV, .size = (uint32_t)M};
+
+    return sp_cache_get(&key, POW2(M / 2 - 1) * sizeof(int16_t),
+        gen_bitrev, NULL);
+}
+
+void sp_fft_init(sp_fft *fft, int M)
+{
+    sp_cache_key key = {.kind = SP_CACHE_FFT_COS, .size = (uint32_t)M};
 
-    BRLowCpx =
-      (int16_t*) malloc(POW2(M / 2 - 1) * sizeof(int16_t));
-    fftBRInit(M, BRLowCpx);
+    /* cos table */
+    fft->utbl = (SPFLOAT *)sp_cache_get(&key,
+        (POW2(M) / 4 + 1) * sizeof(SPFLOAT), gen_cos, NULL);
 
-    /* init bit reversed table for real FFT */
-     BRLow =
-      (int16_t*) malloc(POW2((M - 1) / 2 - 1) * sizeof(int16_t));
-    fftBRInit(M - 1, BRLow);
+    fft->BRLowCpx = (int16_t *)get_bitrev(M);
 
-    fft->BRLow = BRLow;
-    fft->BRLowCpx = BRLowCpx;
-    fft->utbl = utbl;
+    /* bit reversed table for real FFT */
+    fft->BRLow = (int16_t *)get_bitrev(M - 1);
 }
 
 void sp_fftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
@@ -3137,7 +3156,7 @@ void sp_ifftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
 
 void sp_fft_destroy(sp_fft *fft)
 {
-    free(fft->utbl);
-    free(fft->BRLow);
-    free(fft->BRLowCpx);
+    sp_cache_release(fft->utbl);
+    sp_cache_release(fft->BRLow);
+    sp_cache_release(fft->BRLowCpx);
 }
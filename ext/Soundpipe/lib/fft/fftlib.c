@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "base.h"
+#include "cache.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -1,26 +1,36 @@
-void sp_fft_init(sp_fft *fft, int M)
+/* the tables only depend on the size, so instances share them */
+static int gen_cos(void *data, const sp_cache_key *key, void *ud)
 {
-    SPFLOAT *utbl;
-    int16_t *BRLow;
-    int16_t *BRLowCpx;
-    int i;
+    fftCosInit((int)key->size, (SPFLOAT *)data);
+    return SP_OK;
+}
+
+static int gen_bitrev(void *data, const sp_cache_key *key, void *ud)
+{
+    fftBRInit((int)key->size, (int16_t *)data);
+    return SP_OK;
+}
 
-    /* init cos table */
-    utbl = (SPFLOAT*) malloc((POW2(M) / 4 + 1) * sizeof(SPFLOAT));
-    fftCosInit(M, utbl);
+static const void *get_bitrev(int M)
+{
+    sp_cache_key key = {.kind = SP_CACHE_FFT_BITREV, .size = (uint32_t)M};
+
+    return sp_cache_get(&key, POW2(M / 2 - 1) * sizeof(int16_t),
+        gen_bitrev, NULL);
+}
+
+void sp_fft_init(sp_fft *fft, int M)
+{
+    sp_cache_key key = {.kind = SP_CACHE_FFT_COS, .size = (uint32_t)M};
 
-    BRLowCpx =
-      (int16_t*) malloc(POW2(M / 2 - 1) * sizeof(int16_t));
-    fftBRInit(M, BRLowCpx);
+    /* cos table */
+    fft->utbl = (SPFLOAT *)sp_cache_get(&key,
+        (POW2(M) / 4 + 1) * sizeof(SPFLOAT), gen_cos, NULL);
 
-    /* init bit reversed table for real FFT */
-     BRLow =
-      (int16_t*) malloc(POW2((M - 1) / 2 - 1) * sizeof(int16_t));
-    fftBRInit(M - 1, BRLow);
+    fft->BRLowCpx = (int16_t *)get_bitrev(M);
 
-    fft->BRLow = BRLow;
-    fft->BRLowCpx = BRLowCpx;
-    fft->utbl = utbl;
+    /* bit reversed table for real FFT */
+    fft->BRLow = (int16_t *)get_bitrev(M - 1);
 }
 
 void sp_fftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
@@ -49,9 +59,9 @@ void sp_ifftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
     riffts1(buf, M, fft->utbl, fft->BRLow);
 }
 
-void sp_fft_destroy(sp_fft *fft) 
+void sp_fft_destroy(sp_fft *fft)
 {
-    free(fft->utbl);
-    free(fft->BRLow);
-    free(fft->BRLowCpx);
+    sp_cache_release(fft->utbl);
+    sp_cache_release(fft->BRLow);
+    sp_cache_release(fft->BRLowCpx);
 }
@@ -11,32 +11,44 @@ int sp_create(sp_data **spp)
 {
     *spp = (sp_data *) malloc(sizeof(sp_data));
     sp_data *sp = *spp;
+    if(sp == NULL) return SP_NOT_OK;
     sprintf(sp->filename, "test.wav");
     sp->nchan = 1;
     SPFLOAT *out = malloc(sizeof(SPFLOAT) * sp->nchan);
+    if(out == NULL) {
+        free(sp);
+        *spp = NULL;
+        return SP_NOT_OK;
+    }
     *out = 0;
     sp->out = out;
     sp->sr = 44100;
     sp->len = 5 * sp->sr;
     sp->pos = 0;
     sp->rand = 0;
-    return 0;
+    return SP_OK;
 }
 
 int sp_createn(sp_data **spp, int nchan)
 {
     *spp = (sp_data *) malloc(sizeof(sp_data));
     sp_data *sp = *spp;
+    if(sp == NULL) return SP_NOT_OK;
     sprintf(sp->filename, "test.wav");
     sp->nchan = nchan;
     SPFLOAT *out = malloc(sizeof(SPFLOAT) * sp->nchan);
+    if(out == NULL) {
+        free(sp);
+        *spp = NULL;
+        return SP_NOT_OK;
+    }
     *out = 0;
     sp->out = out;
     sp->sr = 44100;
     sp->len = 5 * sp->sr;
     sp->pos = 0;
     sp->rand = 0;
-    return 0;
+    return SP_OK;
 }
 
 int sp_destroy(sp_data **spp)
@@ -163,7 +175,7 @@ int sp_auxdata_free(sp_auxdata *aux)
 
 SPFLOAT sp_midi2cps(SPFLOAT nn)
 {
-    return pow(2, (nn - 69.0) / 12.0) * 440.0;
+    return sp_fast_exp2((nn - 69) * (1.0f / 12)) * 440;
 }
 
 int sp_set(sp_param *p, SPFLOAT val) {
@@ -0,0 +1,282 @@
+/*
+ * Biquads
+ *
+ * A cascade of biquad sections in transposed direct form II, running
+ * SP_BIQUADS_LANES independent signals at a time. Each lane has its
+ * own coefficients, so the lanes can be channels (a stereo EQ) or
+ * bands (a crossover). With GCC and clang a frame of lanes is one
+ * vector, so a stage costs the same for 1 lane as for 4.
+ *
+ * Audio is interleaved by lane. The block function runs the stages
+ * two at a time over the whole block, so the coefficients and state
+ * stay in registers and the two recursions can overlap.
+ *
+ * Coefficients follow the RBJ audio EQ cookbook. They are only
+ * computed when sp_biquads_design or sp_biquads_set is called, never
+ * per sample.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+int sp_biquads_create(sp_biquads **p)
+{
+    *p = malloc(sizeof(sp_biquads));
+    return SP_OK;
+}
+
+int sp_biquads_destroy(sp_biquads **p)
+{
+    sp_auxdata_free(&(*p)->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_biquads_init(sp_data *sp, sp_biquads *p, int nstages)
+{
+    int s, l;
+
+    if(nstages < 1) return SP_NOT_OK;
+
+    p->nstages = nstages;
+    sp_auxdata_alloc(&p->buf, nstages * sizeof(sp_biquads_stage));
+    p->stage = p->buf.ptr;
+
+    for(s = 0; s < nstages; s++) {
+        for(l = 0; l < SP_BIQUADS_LANES; l++) {
+            sp_biquads_set(sp, p, s, l, 1, 0, 0, 0, 0);
+        }
+    }
+
+    return SP_OK;
+}
+
+int sp_biquads_set(sp_data *sp, sp_biquads *p, int stage, int lane,
+    SPFLOAT b0, SPFLOAT b1, SPFLOAT b2, SPFLOAT a1, SPFLOAT a2)
+{
+    sp_biquads_stage *st;
+
+    if(stage < 0 || stage >= p->nstages ||
+        lane < 0 || lane >= SP_BIQUADS_LANES) return SP_NOT_OK;
+
+    st = &p->stage[stage];
+    st->b0[lane] = b0;
+    st->b1[lane] = b1;
+    st->b2[lane] = b2;
+    st->a1[lane] = a1;
+    st->a2[lane] = a2;
+
+    return SP_OK;
+}
+
+int sp_biquads_design(sp_data *sp, sp_biquads *p, int stage, int lane,
+    int type, SPFLOAT freq, SPFLOAT q, SPFLOAT gain)
+{
+    double w0, cs, sn, alpha, a, sa;
+    double b0, b1, b2, a0, a1, a2;
+
+    if(freq > sp->sr * 0.49) freq = sp->sr * 0.49;
+    if(freq < 1) freq = 1;
+    if(q < 0.01) q = 0.01;
+
+    w0 = 2 * M_PI * freq / sp->sr;
+    cs = cos(w0);
+    sn = sin(w0);
+    alpha = sn / (2 * q);
+    a = pow(10, gain / 40);
+
+    switch(type) {
+        case SP_BIQUADS_PEAK:
+            b0 = 1 + alpha * a;
+            b1 = -2 * cs;
+            b2 = 1 - alpha * a;
+            a0 = 1 + alpha / a;
+            a1 = -2 * cs;
+            a2 = 1 - alpha / a;
+            break;
+        case SP_BIQUADS_LOWSHELF:
+            sa = 2 * sqrt(a) * alpha;
+            b0 = a * ((a + 1) - (a - 1) * cs + sa);
+            b1 = 2 * a * ((a - 1) - (a + 1) * cs);
+            b2 = a * ((a + 1) - (a - 1) * cs - sa);
+            a0 = (a + 1) + (a - 1) * cs + sa;
+            a1 = -2 * ((a - 1) + (a + 1) * cs);
+            a2 = (a + 1) + (a - 1) * cs - sa;
+            break;
+        case SP_BIQUADS_HIGHSHELF:
+            sa = 2 * sqrt(a) * alpha;
+            b0 = a * ((a + 1) + (a - 1) * cs + sa);
+            b1 = -2 * a * ((a - 1) + (a + 1) * cs);
+            b2 = a * ((a + 1) + (a - 1) * cs - sa);
+            a0 = (a + 1) - (a - 1) * cs + sa;
+            a1 = 2 * ((a - 1) - (a + 1) * cs);
+            a2 = (a + 1) - (a - 1) * cs - sa;
+            break;
+        case SP_BIQUADS_LOWPASS:
+            b0 = (1 - cs) / 2;
+            b1 = 1 - cs;
+            b2 = (1 - cs) / 2;
+            a0 = 1 + alpha;
+            a1 = -2 * cs;
+            a2 = 1 - alpha;
+            break;
+        case SP_BIQUADS_HIGHPASS:
+            b0 = (1 + cs) / 2;
+            b1 = -(1 + cs);
+            b2 = (1 + cs) / 2;
+            a0 = 1 + alpha;
+            a1 = -2 * cs;
+            a2 = 1 - alpha;
+            break;
+        case SP_BIQUADS_BANDPASS:
+            b0 = alpha;
+            b1 = 0;
+            b2 = -alpha;
+            a0 = 1 + alpha;
+            a1 = -2 * cs;
+            a2 = 1 - alpha;
+            break;
+        case SP_BIQUADS_NOTCH:
+            b0 = 1;
+            b1 = -2 * cs;
+            b2 = 1;
+            a0 = 1 + alpha;
+            a1 = -2 * cs;
+            a2 = 1 - alpha;
+            break;
+        default:
+            b0 = a0 = 1;
+            b1 = b2 = a1 = a2 = 0;
+            break;
+    }
+
+    return sp_biquads_set(sp, p, stage, lane,
+        b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0);
+}
+
+int sp_biquads_clear(sp_data *sp, sp_biquads *p)
+{
+    int s;
+
+    for(s = 0; s < p->nstages; s++) {
+        memset(p->stage[s].z1, 0, sizeof(p->stage[s].z1));
+        memset(p->stage[s].z2, 0, sizeof(p->stage[s].z2));
+    }
+
+    return SP_OK;
+}
+
+#ifdef __GNUC__
+/* one frame of lanes, as a GCC/clang vector */
+typedef SPFLOAT lanes __attribute__((vector_size(SP_BIQUADS_LANES * sizeof(SPFLOAT))));
+
+#define LOAD(v, ptr) memcpy(&(v), (ptr), sizeof(lanes))
+#define STORE(ptr, v) memcpy((ptr), &(v), sizeof(lanes))
+
+static void stage_block(sp_biquads_stage *st, SPFLOAT *io, uint32_t nframes)
+{
+    lanes b0, b1, b2, a1, a2, z1, z2, x, y;
+    uint32_t n;
+
+    LOAD(b0, st->b0); LOAD(b1, st->b1); LOAD(b2, st->b2);
+    LOAD(a1, st->a1); LOAD(a2, st->a2);
+    LOAD(z1, st->z1); LOAD(z2, st->z2);
+
+    for(n = 0; n < nframes; n++) {
+        LOAD(x, &io[n * SP_BIQUADS_LANES]);
+        y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        STORE(&io[n * SP_BIQUADS_LANES], y);
+    }
+
+    STORE(st->z1, z1); STORE(st->z2, z2);
+}
+
+/* Two stages in one pass. Each stage's recursion only depends on its
+ * own state, so the CPU can run the first stage of the next frame
+ * while the second stage of this one is still in flight. */
+static void stage_pair_block(sp_biquads_stage *st, SPFLOAT *io, uint32_t nframes)
+{
+    lanes b0, b1, b2, a1, a2, z1, z2;
+    lanes c0, c1, c2, d1, d2, w1, w2;
+    lanes x, y, u;
+    uint32_t n;
+
+    LOAD(b0, st[0].b0); LOAD(b1, st[0].b1); LOAD(b2, st[0].b2);
+    LOAD(a1, st[0].a1); LOAD(a2, st[0].a2);
+    LOAD(z1, st[0].z1); LOAD(z2, st[0].z2);
+    LOAD(c0, st[1].b0); LOAD(c1, st[1].b1); LOAD(c2, st[1].b2);
+    LOAD(d1, st[1].a1); LOAD(d2, st[1].a2);
+    LOAD(w1, st[1].z1); LOAD(w2, st[1].z2);
+
+    for(n = 0; n < nframes; n++) {
+        LOAD(x, &io[n * SP_BIQUADS_LANES]);
+        y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        u = c0 * y + w1;
+        w1 = c1 * y - d1 * u + w2;
+        w2 = c2 * y - d2 * u;
+        STORE(&io[n * SP_BIQUADS_LANES], u);
+    }
+
+    STORE(st[0].z1, z1); STORE(st[0].z2, z2);
+    STORE(st[1].z1, w1); STORE(st[1].z2, w2);
+}
+#else
+static void stage_block(sp_biquads_stage *st, SPFLOAT *io, uint32_t nframes)
+{
+    SPFLOAT x, y;
+    uint32_t n;
+    int l;
+
+    for(l = 0; l < SP_BIQUADS_LANES; l++) {
+        for(n = 0; n < nframes; n++) {
+            x = io[n * SP_BIQUADS_LANES + l];
+            y = st->b0[l] * x + st->z1[l];
+            st->z1[l] = st->b1[l] * x - st->a1[l] * y + st->z2[l];
+            st->z2[l] = st->b2[l] * x - st->a2[l] * y;
+            io[n * SP_BIQUADS_LANES + l] = y;
+        }
+    }
+}
+
+static void stage_pair_block(sp_biquads_stage *st, SPFLOAT *io, uint32_t nframes)
+{
+    stage_block(&st[0], io, nframes);
+    stage_block(&st[1], io, nframes);
+}
+#endif
+
+int sp_biquads_compute_block(sp_data *sp, sp_biquads *p,
+    SPFLOAT *in, SPFLOAT *out, uint32_t nframes)
+{
+    int s;
+
+    /* the stages run in place on the output */
+    if(in != out) {
+        memcpy(out, in, nframes * SP_BIQUADS_LANES * sizeof(SPFLOAT));
+    }
+
+    for(s = 0; s + 1 < p->nstages; s += 2) {
+        stage_pair_block(&p->stage[s], out, nframes);
+    }
+    if(s < p->nstages) {
+        stage_block(&p->stage[s], out, nframes);
+    }
+
+    return SP_OK;
+}
+
+int sp_biquads_compute(sp_data *sp, sp_biquads *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_biquads_compute_block(sp, p, in, out, 1);
+}
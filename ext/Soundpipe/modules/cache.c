@@ -0,0 +1,119 @@
+/*
+ * Cache
+ *
+ * Process-wide, reference-counted store of read-only data, such as
+ * FFT twiddle tables, that many instances would otherwise generate
+ * and keep identical copies of.
+ *
+ * sp_cache_get returns the data for a key, calling gen to fill it in
+ * the first time. The data is shared: callers must not write to it,
+ * and each get must be matched by one sp_cache_release. The data is
+ * freed when the last user releases it.
+ *
+ * This takes a lock and may allocate, so call it when initializing,
+ * not from the audio thread.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "soundpipe.h"
+
+typedef struct sp_cache_entry {
+    struct sp_cache_entry *next;
+    sp_cache_key key;
+    size_t nbytes;
+    int refcount;
+    /* keeps the data aligned for any type */
+    union {
+        double d;
+        int64_t i;
+        void *p;
+    } data[];
+} sp_cache_entry;
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static sp_cache_entry *cache_entries = NULL;
+
+static int key_equal(const sp_cache_key *a, const sp_cache_key *b)
+{
+    int i;
+
+    if(a->kind != b->kind || a->size != b->size || a->sr != b->sr) {
+        return 0;
+    }
+    for(i = 0; i < SP_CACHE_NPARAMS; i++) {
+        if(a->params[i] != b->params[i]) return 0;
+    }
+    return 1;
+}
+
+const void *sp_cache_get(const sp_cache_key *key, size_t nbytes,
+    sp_cache_gen gen, void *ud)
+{
+    sp_cache_entry *e;
+
+    pthread_mutex_lock(&cache_lock);
+
+    for(e = cache_entries; e != NULL; e = e->next) {
+        if(key_equal(&e->key, key) && e->nbytes == nbytes) {
+            e->refcount++;
+            pthread_mutex_unlock(&cache_lock);
+            return e->data;
+        }
+    }
+
+    /* generating under the lock keeps a second user of the same key
+     * from doing it again */
+    e = calloc(1, sizeof(sp_cache_entry) + nbytes);
+    if(e == NULL) {
+        pthread_mutex_unlock(&cache_lock);
+        return NULL;
+    }
+    e->key = *key;
+    e->nbytes = nbytes;
+    if(gen != NULL && gen(e->data, key, ud) != SP_OK) {
+        free(e);
+        pthread_mutex_unlock(&cache_lock);
+        return NULL;
+    }
+    e->refcount = 1;
+    e->next = cache_entries;
+    cache_entries = e;
+
+    pthread_mutex_unlock(&cache_lock);
+    return e->data;
+}
+
+void sp_cache_release(const void *data)
+{
+    sp_cache_entry **pe, *e;
+
+    if(data == NULL) return;
+
+    pthread_mutex_lock(&cache_lock);
+    for(pe = &cache_entries; *pe != NULL; pe = &(*pe)->next) {
+        e = *pe;
+        if((const void *)e->data != data) continue;
+        if(--e->refcount == 0) {
+            *pe = e->next;
+            free(e);
+        }
+        break;
+    }
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/* number of entries in use, for tests */
+int sp_cache_count(void)
+{
+    sp_cache_entry *e;
+    int n = 0;
+
+    pthread_mutex_lock(&cache_lock);
+    for(e = cache_entries; e != NULL; e = e->next) n++;
+    pthread_mutex_unlock(&cache_lock);
+    return n;
+}
@@ -0,0 +1,171 @@
+sptbl["biquads"] = {
+
+    files = {
+        module = "biquads.c",
+        header = "biquads.h",
+        example = "ex_biquads.c",
+    },
+
+    func = {
+        create = "sp_biquads_create",
+        destroy = "sp_biquads_destroy",
+        init = "sp_biquads_init",
+        compute = "sp_biquads_compute",
+        other = {
+            sp_biquads_compute_block = {
+                description = "Filters nframes interleaved frames of SP_BIQUADS_LANES samples. in and out may be the same buffer.",
+                args = {
+                    {
+                        name = "in",
+                        type = "SPFLOAT *",
+                        description = "Interleaved input frames.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Interleaved output frames.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nframes",
+                        type = "uint32_t",
+                        description = "Number of frames.",
+                        default = 64
+                    },
+                }
+            },
+            sp_biquads_design = {
+                description = "Sets the coefficients of one stage of one lane from an RBJ cookbook filter type (SP_BIQUADS_PEAK, _LOWSHELF, _HIGHSHELF, _LOWPASS, _HIGHPASS, _BANDPASS, _NOTCH or _BYPASS).",
+                args = {
+                    {
+                        name = "stage",
+                        type = "int",
+                        description = "Stage index.",
+                        default = 0
+                    },
+                    {
+                        name = "lane",
+                        type = "int",
+                        description = "Lane index.",
+                        default = 0
+                    },
+                    {
+                        name = "type",
+                        type = "int",
+                        description = "Filter type.",
+                        default = "SP_BIQUADS_PEAK"
+                    },
+                    {
+                        name = "freq",
+                        type = "SPFLOAT",
+                        description = "Center or corner frequency, in Hz.",
+                        default = 1000
+                    },
+                    {
+                        name = "q",
+                        type = "SPFLOAT",
+                        description = "Q.",
+                        default = 0.707
+                    },
+                    {
+                        name = "gain",
+                        type = "SPFLOAT",
+                        description = "Gain in dB (peak and shelf types only).",
+                        default = 0
+                    },
+                }
+            },
+            sp_biquads_set = {
+                description = "Sets raw normalized coefficients of one stage of one lane.",
+                args = {
+                    {
+                        name = "stage",
+                        type = "int",
+                        description = "Stage index.",
+                        default = 0
+                    },
+                    {
+                        name = "lane",
+                        type = "int",
+                        description = "Lane index.",
+                        default = 0
+                    },
+                    {
+                        name = "b0",
+                        type = "SPFLOAT",
+                        description = "Feedforward coefficient.",
+                        default = 1
+                    },
+                    {
+                        name = "b1",
+                        type = "SPFLOAT",
+                        description = "Feedforward coefficient.",
+                        default = 0
+                    },
+                    {
+                        name = "b2",
+                        type = "SPFLOAT",
+                        description = "Feedforward coefficient.",
+                        default = 0
+                    },
+                    {
+                        name = "a1",
+                        type = "SPFLOAT",
+                        description = "Feedback coefficient.",
+                        default = 0
+                    },
+                    {
+                        name = "a2",
+                        type = "SPFLOAT",
+                        description = "Feedback coefficient.",
+                        default = 0
+                    },
+                }
+            },
+            sp_biquads_clear = {
+                description = "Resets the filter state of all stages and lanes.",
+                args = {
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "nstages",
+                type = "int",
+                description = "Number of cascaded biquad stages.",
+                default = 1
+            },
+        },
+
+        optional = {
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Cascaded biquads on parallel lanes
+
+A cascade of biquad sections in transposed direct form II that filters SP_BIQUADS_LANES (4) signals at once, each with its own coefficients. Lanes can hold channels or bands. All stages start out as pass-through; set them with sp_biquads_design or sp_biquads_set. sp_biquads_compute filters one frame of SP_BIQUADS_LANES samples.]],
+
+    ninputs = 1,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "in",
+            description = "Input frame (SP_BIQUADS_LANES samples)."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out",
+            description = "Output frame (SP_BIQUADS_LANES samples)."
+        },
+    }
+
+}
@@ -0,0 +1,99 @@
+sptbl["fdline"] = {
+
+    files = {
+        module = "fdline.c",
+        header = "fdline.h",
+        example = "ex_fdline.c",
+    },
+
+    func = {
+        create = "sp_fdline_create",
+        destroy = "sp_fdline_destroy",
+        init = "sp_fdline_init",
+        compute = "sp_fdline_compute",
+        other = {
+            sp_fdline_compute_block = {
+                description = "Delays nsmps samples. The delay is given for each sample. in and out may be the same buffer.",
+                args = {
+                    {
+                        name = "in",
+                        type = "const SPFLOAT *",
+                        description = "Input buffer.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "del",
+                        type = "const SPFLOAT *",
+                        description = "Delay of each sample, in samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Output buffer.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+            sp_fdline_clear = {
+                description = "Clears the delay buffer.",
+                args = {
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "maxdel",
+                type = "SPFLOAT",
+                description = "The maximum delay time, in seconds.",
+                default = 1.0,
+                irate = true
+            },
+        },
+        optional = {
+            {
+                name = "feedback",
+                type = "SPFLOAT",
+                description = "Amount of the output fed back into the delay line.",
+                default = 0.0
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Fractional delay line with feedback, a block at a time
+
+The delay is given per sample, in samples, and read with cubic interpolation. Modulated and static delays run the same code, which vectorizes. Delays are clamped to at least 3 samples.]],
+
+    ninputs = 2,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "in",
+            description = "Signal input."
+        },
+        {
+            name = "del",
+            description = "Delay time, in samples."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out",
+            description = "Signal output."
+        },
+    }
+
+}
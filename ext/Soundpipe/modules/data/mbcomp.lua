@@ -0,0 +1,125 @@
+sptbl["mbcomp"] = {
+
+    files = {
+        module = "mbcomp.c",
+        header = "mbcomp.h",
+        example = "ex_mbcomp.c",
+    },
+
+    func = {
+        create = "sp_mbcomp_create",
+        destroy = "sp_mbcomp_destroy",
+        init = "sp_mbcomp_init",
+        compute = "sp_mbcomp_compute",
+        other = {
+            sp_mbcomp_compute_block = {
+                description = "Compresses nsmps stereo samples.",
+                args = {
+                    {
+                        name = "in1",
+                        type = "SPFLOAT *",
+                        description = "Left input.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "in2",
+                        type = "SPFLOAT *",
+                        description = "Right input.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out1",
+                        type = "SPFLOAT *",
+                        description = "Left output.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out2",
+                        type = "SPFLOAT *",
+                        description = "Right output.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        optional = {
+            {
+                name = "freq",
+                type = "SPFLOAT[3]",
+                description = "Crossover frequencies in Hz, from low to high.",
+                default = "200, 1000, 5000"
+            },
+            {
+                name = "thresh",
+                type = "SPFLOAT[4]",
+                description = "Threshold of each band, in dB.",
+                default = 0
+            },
+            {
+                name = "ratio",
+                type = "SPFLOAT[4]",
+                description = "Ratio of each band.",
+                default = 1
+            },
+            {
+                name = "atk",
+                type = "SPFLOAT[4]",
+                description = "Attack time of each band, in seconds.",
+                default = 0.01
+            },
+            {
+                name = "rel",
+                type = "SPFLOAT[4]",
+                description = "Release time of each band, in seconds.",
+                default = 0.1
+            },
+            {
+                name = "makeup",
+                type = "SPFLOAT[4]",
+                description = "Makeup gain of each band, in dB.",
+                default = 0
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Stereo-linked 4-band compressor
+
+Splits the input with Linkwitz-Riley crossovers built from butlp/buthp sections, compresses each band and sums them back. With every ratio at 1 the output is an allpass-filtered copy of the input. After each call, gr holds the gain reduction of each band in dB.]],
+
+    ninputs = 2,
+    noutputs = 2,
+
+    inputs = {
+        {
+            name = "in1",
+            description = "Left input."
+        },
+        {
+            name = "in2",
+            description = "Right input."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out1",
+            description = "Left output."
+        },
+        {
+            name = "out2",
+            description = "Right output."
+        },
+    }
+
+}
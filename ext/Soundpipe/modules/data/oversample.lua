@@ -0,0 +1,78 @@
+sptbl["oversample"] = {
+
+    files = {
+        module = "oversample.c",
+        header = "oversample.h",
+        example = "ex_oversample.c",
+    },
+
+    func = {
+        create = "sp_oversample_create",
+        destroy = "sp_oversample_destroy",
+        init = "sp_oversample_init",
+        compute = "sp_oversample_up",
+        other = {
+            sp_oversample_down = {
+                description = "Filters and decimates nsmps * factor samples back to nsmps samples.",
+                args = {
+                    {
+                        name = "up",
+                        type = "SPFLOAT *",
+                        description = "Oversampled input (nsmps * factor samples).",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Output samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of output samples.",
+                        default = 64
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "factor",
+                type = "int",
+                description = "Oversampling factor: 2, 4 or 8.",
+                default = 2
+            },
+        },
+
+        optional = {
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Polyphase half-band up/downsampler
+
+Runs nonlinear modules such as dist, saturator or bitcrush at 2, 4 or 8 times the rate, to reduce aliasing. sp_oversample_up writes nsmps * factor samples; process them, then pass them to sp_oversample_down. Modules that depend on the sample rate need an sp_data with sr * factor. The round-trip latency, in samples, is stored in the latency member after init.]],
+
+    ninputs = 1,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "in",
+            description = "Input samples (nsmps)."
+        },
+    },
+
+    outputs = {
+        {
+            name = "up",
+            description = "Oversampled output (nsmps * factor)."
+        },
+    }
+
+}
@@ -0,0 +1,122 @@
+sptbl["pshift2"] = {
+
+    files = {
+        module = "pshift2.c",
+        header = "pshift2.h",
+        example = "ex_pshift2.c",
+    },
+
+    func = {
+        create = "sp_pshift2_create",
+        destroy = "sp_pshift2_destroy",
+        init = "sp_pshift2_init",
+        compute = "sp_pshift2_compute",
+        other = {
+            sp_pshift2_clear = {
+                description = "Clears the delay lines and restarts the window.",
+                args = {
+                }
+            },
+            sp_pshift2_compute_block = {
+                description = "Shifts a block of samples. The parameters are read once per block.",
+                args = {
+                    {
+                        name = "in1",
+                        type = "SPFLOAT *",
+                        description = "Left input samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "in2",
+                        type = "SPFLOAT *",
+                        description = "Right input samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out1",
+                        type = "SPFLOAT *",
+                        description = "Left output samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out2",
+                        type = "SPFLOAT *",
+                        description = "Right output samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "maxwindow",
+                type = "SPFLOAT",
+                description = "Maximum window size (in samples). Sets the size of the delay lines.",
+                default = 10000,
+                irate = true
+            },
+        },
+
+        optional = {
+            {
+                name = "shift",
+                type = "SPFLOAT",
+                description = "Pitch shift (in semitones), range -24/24.",
+                default = 0
+            },
+            {
+                name = "window",
+                type = "SPFLOAT",
+                description ="Window size (in samples), up to maxwindow.",
+                default = 1000
+            },
+            {
+                name = "xfade",
+                type = "SPFLOAT",
+                description ="Crossfade (in samples), max 10000",
+                default = 10
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Stereo time-domain pitch shifter.
+
+Both channels use the same window and crossfade, but have separate delay lines.]],
+
+    ninputs = 2,
+    noutputs = 2,
+
+    inputs = {
+        {
+            name = "input1",
+            description = "Left signal input."
+        },
+        {
+            name = "input2",
+            description = "Right signal input."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out1",
+            description = "Left signal output."
+        },
+        {
+            name = "out2",
+            description = "Right signal output."
+        },
+    }
+
+}
@@ -0,0 +1,110 @@
+sptbl["psola"] = {
+
+    files = {
+        module = "psola.c",
+        header = "psola.h",
+        example = "ex_psola.c",
+    },
+
+    func = {
+        create = "sp_psola_create",
+        destroy = "sp_psola_destroy",
+        init = "sp_psola_init",
+        compute = "sp_psola_compute",
+        other = {
+            sp_psola_clear = {
+                description = "Clears the input and output buffers and restarts the grains.",
+                args = {
+                }
+            },
+            sp_psola_compute_block = {
+                description = "Shifts a block of samples. The pitch is tracked once per ptrack hop instead of every sample.",
+                args = {
+                    {
+                        name = "in1",
+                        type = "SPFLOAT *",
+                        description = "Left input samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "in2",
+                        type = "SPFLOAT *",
+                        description = "Right input samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out1",
+                        type = "SPFLOAT *",
+                        description = "Left output samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out2",
+                        type = "SPFLOAT *",
+                        description = "Right output samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "minfreq",
+                type = "SPFLOAT",
+                description = "Lowest tracked pitch (in Hz). The latency is 2 * sr / minfreq samples.",
+                default = 80,
+                irate = true
+            },
+        },
+
+        optional = {
+            {
+                name = "shift",
+                type = "SPFLOAT",
+                description = "Pitch shift (in semitones), range -24/24.",
+                default = 0
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Pitch-synchronous overlap-add (PSOLA) pitch shifter.
+
+The input period is tracked with ptrack. The latency, in samples, is stored in the latency member after init.]],
+
+    ninputs = 2,
+    noutputs = 2,
+
+    inputs = {
+        {
+            name = "input1",
+            description = "Left signal input."
+        },
+        {
+            name = "input2",
+            description = "Right signal input."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out1",
+            description = "Left signal output."
+        },
+        {
+            name = "out2",
+            description = "Right signal output."
+        },
+    }
+
+}
@@ -11,6 +11,37 @@ sptbl["ptrack"] = {
         destroy = "sp_ptrack_destroy",
         init = "sp_ptrack_init",
         compute = "sp_ptrack_compute",
+        other = {
+            sp_ptrack_compute_block = {
+                description = "Tracks a block of samples. The analysis only runs at hop boundaries, and freq/amp are written once at the end of the block.",
+                args = {
+                    {
+                        name = "in",
+                        type = "SPFLOAT *",
+                        description = "Input samples.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of input samples.",
+                        default = 64
+                    },
+                    {
+                        name = "freq",
+                        type = "SPFLOAT *",
+                        description = "Guessed frequency (in Hz).",
+                        default = "NULL"
+                    },
+                    {
+                        name = "amp",
+                        type = "SPFLOAT *",
+                        description = "Guessed amplitude.",
+                        default = "NULL"
+                    },
+                }
+            },
+        }
     },
 
     params = {
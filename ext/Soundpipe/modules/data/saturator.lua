@@ -11,6 +11,25 @@ sptbl["saturator"] = {
         destroy = "sp_saturator_destroy",
         init = "sp_saturator_init",
         compute = "sp_saturator_compute",
+        other = {
+            sp_saturator_shape = {
+                description = "Applies the waveshaper and DC blocker without the internal 8x resampling, for use at an oversampled rate (see oversample).",
+                args = {
+                    {
+                        name = "in",
+                        type = "SPFLOAT *",
+                        description = "Input sample.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Output sample.",
+                        default = "NULL"
+                    },
+                }
+            },
+        }
     },
 
     params = {
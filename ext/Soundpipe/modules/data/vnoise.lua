@@ -0,0 +1,86 @@
+sptbl["vnoise"] = {
+
+    files = {
+        module = "vnoise.c",
+        header = "vnoise.h",
+        example = "ex_vnoise.c",
+    },
+
+    func = {
+        create = "sp_vnoise_create",
+        destroy = "sp_vnoise_destroy",
+        init = "sp_vnoise_init",
+        compute = "sp_vnoise_compute",
+        other = {
+            sp_vnoise_compute_block = {
+                description = "Fills a buffer with nsmps samples of noise.",
+                args = {
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Output buffer.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+            sp_vnoise_seed = {
+                description = "Restarts the random stream from a seed. sp_vnoise_init seeds it with sp_rand.",
+                args = {
+                    {
+                        name = "seed",
+                        type = "uint32_t",
+                        description = "Seed.",
+                        default = 0
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        optional = {
+            {
+                name = "amp",
+                type = "SPFLOAT",
+                description = "Amplitude.",
+                default = 1.0
+            },
+            {
+                name = "type",
+                type = "int",
+                description = "SP_VNOISE_WHITE, SP_VNOISE_PINK or SP_VNOISE_BROWN.",
+                default = "SP_VNOISE_WHITE"
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[White, pink and brown noise, a block at a time
+
+White noise comes from several xorshift generators running in parallel, which vectorizes. Pink noise filters it with a bank of one-pole filters (Paul Kellet's method), brown noise with a leaky integrator. Unlike sp_noise, sp_pinknoise and sp_brown, it fills whole buffers.]],
+
+    ninputs = 0,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "dummy",
+            description = "This doesn't do anything."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out",
+            description = "Signal output."
+        },
+    }
+
+}
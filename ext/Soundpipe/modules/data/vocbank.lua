@@ -0,0 +1,129 @@
+sptbl["vocbank"] = {
+
+    files = {
+        module = "vocbank.c",
+        header = "vocbank.h",
+        example = "ex_vocbank.c",
+    },
+
+    func = {
+        create = "sp_vocbank_create",
+        destroy = "sp_vocbank_destroy",
+        init = "sp_vocbank_init",
+        compute = "sp_vocbank_compute",
+        other = {
+            sp_vocbank_compute_block = {
+                description = "Processes a block of nsmps samples.",
+                args = {
+                    {
+                        name = "car",
+                        type = "SPFLOAT *",
+                        description = "Carrier (nsmps samples).",
+                        default = "NULL"
+                    },
+                    {
+                        name = "mod",
+                        type = "SPFLOAT *",
+                        description = "Modulator (nsmps samples).",
+                        default = "NULL"
+                    },
+                    {
+                        name = "out",
+                        type = "SPFLOAT *",
+                        description = "Output (nsmps samples). It can be the same buffer as car or mod.",
+                        default = "NULL"
+                    },
+                    {
+                        name = "nsmps",
+                        type = "uint32_t",
+                        description = "Number of samples.",
+                        default = 64
+                    },
+                }
+            },
+            sp_vocbank_clear = {
+                description = "Clears the filter and envelope state.",
+                args = {
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "maxbands",
+                type = "int",
+                description = "Max number of bands. Storage for them is allocated at init.",
+                default = 32
+            },
+        },
+
+        optional = {
+            {
+                name = "nbands",
+                type = "int",
+                description = "Number of bands, up to maxbands.",
+                default = "maxbands"
+            },
+            {
+                name = "atk",
+                type = "SPFLOAT",
+                description = "Attack time of the envelope followers (in seconds).",
+                default = 0.01
+            },
+            {
+                name = "rel",
+                type = "SPFLOAT",
+                description = "Release time of the envelope followers (in seconds).",
+                default = 0.05
+            },
+            {
+                name = "bwratio",
+                type = "SPFLOAT",
+                description = "Width of each band, relative to the spacing between bands.",
+                default = 1
+            },
+            {
+                name = "fmin",
+                type = "SPFLOAT",
+                description = "Center frequency of the lowest band (in Hz).",
+                default = 80
+            },
+            {
+                name = "fmax",
+                type = "SPFLOAT",
+                description = "Center frequency of the highest band (in Hz).",
+                default = 12000
+            },
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Channel vocoder with a vectorized filter bank
+
+A channel vocoder with a configurable number of bands. The bands are filtered SP_VOCBANK_LANES at a time, which makes 32 or more bands practical in real time.]],
+
+    ninputs = 2,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "car",
+            description = "Carrier: the signal that is filtered, usually a synth."
+        },
+        {
+            name = "mod",
+            description = "Modulator: the signal whose spectral envelope is applied to the carrier, usually a voice."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out",
+            description = "Signal output."
+        },
+    }
+
+}
@@ -0,0 +1,89 @@
+sptbl["wavetable"] = {
+
+    files = {
+        module = "wavetable.c",
+        header = "wavetable.h",
+        example = "ex_wavetable.c",
+    },
+
+    func = {
+        create = "sp_wavetable_create",
+        destroy = "sp_wavetable_destroy",
+        init = "sp_wavetable_init",
+        compute = "sp_wavetable_compute",
+        other = {
+            sp_wavetable_gen = {
+                description = "Builds the octave levels of a frame from one cycle of a waveform (size samples). This uses the FFT and is not real-time safe.",
+                args = {
+                    {
+                        name = "frame",
+                        type = "int",
+                        description = "Frame to build, 0 to nframes - 1.",
+                        default = 0
+                    },
+                    {
+                        name = "wave",
+                        type = "const SPFLOAT *",
+                        description = "One cycle of the waveform.",
+                        default = "NULL"
+                    },
+                }
+            },
+            sp_wavetable_level = {
+                description = "Returns the octave level read by a voice at the given frequency.",
+                args = {
+                    {
+                        name = "freq",
+                        type = "SPFLOAT",
+                        description = "Frequency (in Hz).",
+                        default = 440
+                    },
+                }
+            },
+        }
+    },
+
+    params = {
+        mandatory = {
+            {
+                name = "size",
+                type = "uint32_t",
+                description = "Length of a cycle. Must be a power of 2.",
+                default = 2048
+            },
+            {
+                name = "nframes",
+                type = "int",
+                description = "Number of frames (waveforms) to morph between.",
+                default = 1
+            },
+        },
+
+        optional = {
+        }
+    },
+
+    modtype = "module",
+
+    description = [[Band-limited mipmapped wavetable
+
+A wavetable of nframes single-cycle waveforms, each stored as one band-limited table per octave, with a reader for many voices. sp_wavetable_compute sums nvoices voices into nsmps output samples. Each voice has a phase (a 32-bit fraction of a cycle, advanced by the call), a frequency, a wavetable position (0-1, morphing between adjacent frames) and an amplitude. It reads the octave whose harmonics all stay below Nyquist at the voice's frequency, so the output does not alias.]],
+
+    ninputs = 0,
+    noutputs = 1,
+
+    inputs = {
+        {
+            name = "phs",
+            description = "Phase of each voice."
+        },
+    },
+
+    outputs = {
+        {
+            name = "out",
+            description = "Sum of the voices (nsmps)."
+        },
+    }
+
+}
@@ -39,7 +39,7 @@ int sp_dist_compute(sp_data *sp, sp_dist *p, SPFLOAT *in, SPFLOAT *out)
 {
     SPFLOAT pregain = p->pregain, postgain  = p->postgain;
     SPFLOAT shape1 = p->shape1, shape2 = p->shape2;
-    SPFLOAT sig;
+    SPFLOAT sig, a, b, r;
     
     pregain   *=  6.5536;
     postgain  *=  0.61035156;
@@ -47,14 +47,18 @@ int sp_dist_compute(sp_data *sp, sp_dist *p, SPFLOAT *in, SPFLOAT *out)
     shape2    *=  4.096;
 
     /* IV - Dec 28 2002 */
-    shape1 += pregain;
-    shape2 -= pregain;
-    postgain *= 0.5;
     sig = *in;
-    /* Generate tanh distortion and output the result */
-    *out =                          
-    ((exp(sig * shape1) - exp(sig * shape2))
-             / cosh(sig * pregain))
-    * postgain;
+    /* Generate tanh distortion and output the result.
+     *
+     * (exp(sig * (shape1 + pregain)) - exp(sig * (shape2 - pregain)))
+     *     / cosh(sig * pregain)
+     *
+     * is rewritten with a = exp(sig * shape1), b = exp(sig * shape2)
+     * and r = 1 / (1 + exp(2 * sig * pregain)) as 2 * (a - (a + b) * r),
+     * which stays finite when the exponentials saturate. */
+    a = sp_fast_exp(sig * shape1);
+    b = sp_fast_exp(sig * shape2);
+    r = 1 / (1 + sp_fast_exp(2 * sig * pregain));
+    *out = (a - (a + b) * r) * postgain;
     return SP_OK;
 }
@@ -0,0 +1,144 @@
+/*
+ * Fdline
+ *
+ * Fractional delay line with feedback, processed a block at a time.
+ *
+ * The delay time is given per sample, in samples, and read with
+ * 4-point cubic (Catmull-Rom) interpolation, so a modulated delay
+ * runs the same code as a static one.
+ *
+ * The buffer holds a power of 2 number of samples, and every sample
+ * is written twice, at i and i + size. Reading size samples back from
+ * the upper copy then never goes past either end of the buffer, so
+ * within a block the reads need no wrapping. Blocks are only split
+ * where the write position wraps, and, because of the feedback, so
+ * that a block never reads samples it writes itself. The interpolation
+ * loop has no branches and vectorizes with gathers.
+ *
+ * The delay is clamped to [3, size - 3] samples, which keeps the 4
+ * points inside the part of the buffer written before the block.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+int sp_fdline_create(sp_fdline **p)
+{
+    *p = malloc(sizeof(sp_fdline));
+    return SP_OK;
+}
+
+int sp_fdline_destroy(sp_fdline **p)
+{
+    sp_auxdata_free(&(*p)->aux);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_fdline_init(sp_data *sp, sp_fdline *p, SPFLOAT maxdel)
+{
+    uint32_t size = 4;
+
+    while(size < maxdel * sp->sr + 3) size <<= 1;
+
+    p->size = size;
+    p->mask = size - 1;
+    p->wpos = 0;
+    p->mindel = 3;
+    p->maxdel = size - 3;
+    p->feedback = 0;
+
+    sp_auxdata_alloc(&p->aux, 2 * size * sizeof(SPFLOAT));
+    p->buf = p->aux.ptr;
+    return SP_OK;
+}
+
+int sp_fdline_clear(sp_data *sp, sp_fdline *p)
+{
+    memset(p->buf, 0, 2 * p->size * sizeof(SPFLOAT));
+    return SP_OK;
+}
+
+/* reads nsmps samples, the first one being the sample before buf[0] */
+SP_TARGET_CLONES
+static void read_block(const SPFLOAT *restrict buf, SPFLOAT mindel,
+    SPFLOAT maxdel, const SPFLOAT *restrict del, SPFLOAT *restrict out,
+    uint32_t nsmps)
+{
+    uint32_t n;
+    int32_t i, di;
+    SPFLOAT d, f, xm1, x0, x1, x2, c1, c2, c3;
+
+    for(n = 0; n < nsmps; n++) {
+        /* clamp to [mindel, maxdel] with selects, which vectorize
+         * to min/max. Computing it around the middle of the range
+         * would round d to the precision of half the buffer size. */
+        d = del[n];
+        d = d < mindel ? mindel : d;
+        d = d > maxdel ? maxdel : d;
+
+        /* split d, which is positive, so that the cast truncates and
+         * the fraction is exact at any buffer size. buf points size
+         * samples past the oldest sample that can be read, so i is
+         * negative. A whole d gives f = 1, which returns x1. */
+        di = (int32_t)d;
+        f = 1 - (d - (SPFLOAT)di);
+        i = (int32_t)n - di - 1;
+
+        xm1 = buf[i - 1];
+        x0 = buf[i];
+        x1 = buf[i + 1];
+        x2 = buf[i + 2];
+        c1 = 0.5f * (x1 - xm1);
+        c2 = xm1 - 2.5f * x0 + 2 * x1 - 0.5f * x2;
+        c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+        out[n] = ((c3 * f + c2) * f + c1) * f + x0;
+    }
+}
+
+int sp_fdline_compute_block(sp_data *sp, sp_fdline *p,
+    const SPFLOAT *in, const SPFLOAT *del, SPFLOAT *out, uint32_t nsmps)
+{
+    SPFLOAT tmp[SP_FDLINE_BLOCK], dmin, x;
+    SPFLOAT fb = p->feedback;
+    uint32_t n = 0, len, i;
+
+    while(n < nsmps) {
+        len = nsmps - n;
+        if(len > SP_FDLINE_BLOCK) len = SP_FDLINE_BLOCK;
+        if(len > p->size - p->wpos) len = p->size - p->wpos;
+
+        /* do not read what this block writes: the newest point read
+         * at sample i is floor(i - del) + 2 */
+        dmin = p->maxdel;
+        for(i = 0; i < len; i++) {
+            dmin = del[n + i] < dmin ? del[n + i] : dmin;
+        }
+        if(dmin < p->mindel) dmin = p->mindel;
+        if(len > (uint32_t)dmin - 2) len = (uint32_t)dmin - 2;
+
+        read_block(p->buf + p->size + p->wpos, p->mindel, p->maxdel,
+            del + n, tmp, len);
+
+        for(i = 0; i < len; i++) {
+            x = in[n + i] + fb * tmp[i];
+            p->buf[p->wpos + i] = x;
+            p->buf[p->wpos + i + p->size] = x;
+            out[n + i] = tmp[i];
+        }
+
+        p->wpos = (p->wpos + len) & p->mask;
+        n += len;
+    }
+
+    return SP_OK;
+}
+
+int sp_fdline_compute(sp_data *sp, sp_fdline *p,
+    SPFLOAT *in, SPFLOAT *del, SPFLOAT *out)
+{
+    return sp_fdline_compute_block(sp, p, in, del, out, 1);
+}
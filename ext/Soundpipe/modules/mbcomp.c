@@ -0,0 +1,287 @@
+/*
+ * Mbcomp
+ *
+ * Stereo-linked 4-band compressor.
+ *
+ * The crossovers are 4th order Linkwitz-Riley filters: two cascaded
+ * Butterworth sections with the butlp/buthp coefficients. Each band
+ * runs in one lane of an sp_biquads cascade fed with the same input,
+ * with allpass sections for the crossovers it is not split by, so that
+ * the bands sum back to an allpass response:
+ *
+ *   band 0 = LP1 AP2 AP3
+ *   band 1 = HP1 LP2 AP3
+ *   band 2 = HP1 HP2 LP3
+ *   band 3 = HP1 HP2 HP3
+ *
+ * Levels follow each band's peak with separate attack and release
+ * times. The gain computer then runs over the whole block in dB, with
+ * sp_fast_log2 and sp_fast_exp2, in a flat loop that vectorizes.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define ROOT2 (1.4142135623730950488)
+
+/* 20 * log10(2) and its inverse */
+#define DB_PER_LOG2 6.0205999
+#define LOG2_PER_DB 0.16609640
+
+/* stages of each lane: a lowpass/highpass split takes 2 stages, an
+ * allpass 1 */
+#define NSTAGES 6
+
+enum { LP, HP, AP, NONE };
+
+static const int lane_filters[SP_MBCOMP_BANDS][SP_MBCOMP_BANDS - 1] = {
+    {LP, AP, AP},
+    {HP, LP, AP},
+    {HP, HP, LP},
+    {HP, HP, HP}
+};
+
+int sp_mbcomp_create(sp_mbcomp **p)
+{
+    *p = malloc(sizeof(sp_mbcomp));
+    return SP_OK;
+}
+
+int sp_mbcomp_destroy(sp_mbcomp **p)
+{
+    sp_mbcomp *pp = *p;
+    sp_biquads_destroy(&pp->xover[0]);
+    sp_biquads_destroy(&pp->xover[1]);
+    sp_auxdata_free(&pp->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_mbcomp_init(sp_data *sp, sp_mbcomp *p)
+{
+    int i;
+    uint32_t size = SP_MBCOMP_BLOCK * SP_MBCOMP_BANDS;
+
+    p->freq[0] = 200;
+    p->freq[1] = 1000;
+    p->freq[2] = 5000;
+    for(i = 0; i < SP_MBCOMP_BANDS - 1; i++) p->prvfreq[i] = -1;
+
+    for(i = 0; i < SP_MBCOMP_BANDS; i++) {
+        p->thresh[i] = 0;
+        p->ratio[i] = 1;
+        p->atk[i] = 0.01;
+        p->rel[i] = 0.1;
+        p->makeup[i] = 0;
+        p->gr[i] = 0;
+        p->env[i] = 0;
+        p->prvatk[i] = p->prvrel[i] = -1;
+    }
+
+    for(i = 0; i < 2; i++) {
+        sp_biquads_create(&p->xover[i]);
+        sp_biquads_init(sp, p->xover[i], NSTAGES);
+    }
+
+    sp_auxdata_alloc(&p->buf, 3 * size * sizeof(SPFLOAT));
+    p->band[0] = p->buf.ptr;
+    p->band[1] = p->band[0] + size;
+    p->gain = p->band[1] + size;
+
+    return SP_OK;
+}
+
+/* Sets the stages of every lane from the crossover frequencies. Lowpass
+ * and highpass sections use the coefficients of butlp and buthp; the
+ * allpass has the same poles, which is what LP + HP of a Linkwitz-Riley
+ * pair adds up to. */
+static void design(sp_data *sp, sp_mbcomp *p)
+{
+    SPFLOAT coefs[3][3][5];
+    int i, l, c, s, f;
+
+    for(i = 0; i < SP_MBCOMP_BANDS - 1; i++) {
+        double c1, a1, t;
+        SPFLOAT freq = p->freq[i];
+
+        if(freq < 10) freq = 10;
+        if(freq > sp->sr * 0.45) freq = sp->sr * 0.45;
+
+        /* butlp */
+        c1 = 1.0 / tan(M_PI * freq / sp->sr);
+        a1 = 1.0 / (1.0 + ROOT2 * c1 + c1 * c1);
+        coefs[LP][i][0] = a1;
+        coefs[LP][i][1] = 2 * a1;
+        coefs[LP][i][2] = a1;
+        coefs[LP][i][3] = 2.0 * (1.0 - c1 * c1) * a1;
+        coefs[LP][i][4] = (1.0 - ROOT2 * c1 + c1 * c1) * a1;
+
+        /* buthp */
+        t = tan(M_PI * freq / sp->sr);
+        a1 = 1.0 / (1.0 + ROOT2 * t + t * t);
+        coefs[HP][i][0] = a1;
+        coefs[HP][i][1] = -2 * a1;
+        coefs[HP][i][2] = a1;
+        coefs[HP][i][3] = 2.0 * (t * t - 1.0) * a1;
+        coefs[HP][i][4] = (1.0 - ROOT2 * t + t * t) * a1;
+
+        /* allpass */
+        coefs[AP][i][0] = coefs[HP][i][4];
+        coefs[AP][i][1] = coefs[HP][i][3];
+        coefs[AP][i][2] = 1;
+        coefs[AP][i][3] = coefs[HP][i][3];
+        coefs[AP][i][4] = coefs[HP][i][4];
+    }
+
+    for(c = 0; c < 2; c++) {
+        for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+            s = 0;
+            for(i = 0; i < SP_MBCOMP_BANDS - 1; i++) {
+                SPFLOAT *k;
+                f = lane_filters[l][i];
+                k = coefs[f][i];
+                sp_biquads_set(sp, p->xover[c], s++, l,
+                    k[0], k[1], k[2], k[3], k[4]);
+                if(f != AP) {
+                    sp_biquads_set(sp, p->xover[c], s++, l,
+                        k[0], k[1], k[2], k[3], k[4]);
+                }
+            }
+            while(s < NSTAGES) {
+                sp_biquads_set(sp, p->xover[c], s++, l, 1, 0, 0, 0, 0);
+            }
+        }
+    }
+}
+
+static void update(sp_data *sp, sp_mbcomp *p)
+{
+    int i, changed = 0;
+
+    for(i = 0; i < SP_MBCOMP_BANDS - 1; i++) {
+        if(p->freq[i] != p->prvfreq[i]) {
+            p->prvfreq[i] = p->freq[i];
+            changed = 1;
+        }
+    }
+    if(changed) design(sp, p);
+
+    for(i = 0; i < SP_MBCOMP_BANDS; i++) {
+        if(p->atk[i] != p->prvatk[i]) {
+            p->prvatk[i] = p->atk[i];
+            p->atkcoef[i] = p->atk[i] > 0 ?
+                exp(-1.0 / (p->atk[i] * sp->sr)) : 0;
+        }
+        if(p->rel[i] != p->prvrel[i]) {
+            p->prvrel[i] = p->rel[i];
+            p->relcoef[i] = p->rel[i] > 0 ?
+                exp(-1.0 / (p->rel[i] * sp->sr)) : 0;
+        }
+    }
+}
+
+static void compute_chunk(sp_data *sp, sp_mbcomp *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps)
+{
+    SPFLOAT *b1 = p->band[0], *b2 = p->band[1], *gain = p->gain;
+    float slope[SP_MBCOMP_BANDS], thresh[SP_MBCOMP_BANDS];
+    float makeup[SP_MBCOMP_BANDS], over;
+    SPFLOAT env[SP_MBCOMP_BANDS];
+    SPFLOAT atkcoef[SP_MBCOMP_BANDS], relcoef[SP_MBCOMP_BANDS];
+    SPFLOAT lvl, coef;
+    uint32_t n, j, size = nsmps * SP_MBCOMP_BANDS;
+    int l;
+
+    /* split */
+    for(n = 0; n < nsmps; n++) {
+        for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+            b1[n * SP_MBCOMP_BANDS + l] = in1[n];
+            b2[n * SP_MBCOMP_BANDS + l] = in2[n];
+        }
+    }
+    sp_biquads_compute_block(sp, p->xover[0], b1, b1, nsmps);
+    sp_biquads_compute_block(sp, p->xover[1], b2, b2, nsmps);
+
+    /* follow the linked peak level of each band */
+    for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+        env[l] = p->env[l];
+        atkcoef[l] = p->atkcoef[l];
+        relcoef[l] = p->relcoef[l];
+    }
+    for(n = 0; n < nsmps; n++) {
+        for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+            j = n * SP_MBCOMP_BANDS + l;
+            lvl = fabs(b1[j]) > fabs(b2[j]) ? fabs(b1[j]) : fabs(b2[j]);
+            coef = env[l] > lvl ? relcoef[l] : atkcoef[l];
+            env[l] = coef * env[l] + (1 - coef) * lvl;
+            gain[j] = env[l];
+        }
+    }
+    for(l = 0; l < SP_MBCOMP_BANDS; l++) p->env[l] = env[l];
+
+    /* gain computer, in log2 units */
+    for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+        SPFLOAT ratio = p->ratio[l] < 1 ? 1 : p->ratio[l];
+        slope[l] = 1.0f / ratio - 1;
+        thresh[l] = p->thresh[l] * LOG2_PER_DB;
+        makeup[l] = p->makeup[l] * LOG2_PER_DB;
+    }
+    for(n = 0; n < nsmps; n++) {
+        for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+            j = n * SP_MBCOMP_BANDS + l;
+            over = sp_fast_log2(gain[j] + 1e-20f) - thresh[l];
+            /* max(over, 0), written so that it vectorizes */
+            over = 0.5f * (over + fabsf(over)) * slope[l];
+            gain[j] = sp_fast_exp2(over + makeup[l]);
+        }
+    }
+
+    /* sum the bands */
+    for(n = 0; n < nsmps; n++) {
+        SPFLOAT s1 = 0, s2 = 0;
+        for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+            j = n * SP_MBCOMP_BANDS + l;
+            s1 += b1[j] * gain[j];
+            s2 += b2[j] * gain[j];
+        }
+        out1[n] = s1;
+        out2[n] = s2;
+    }
+
+    /* report the gain reduction at the end of the block */
+    for(l = 0; l < SP_MBCOMP_BANDS; l++) {
+        SPFLOAT g = gain[size - SP_MBCOMP_BANDS + l];
+        p->gr[l] = sp_fast_log2(g) * DB_PER_LOG2 - p->makeup[l];
+    }
+}
+
+int sp_mbcomp_compute_block(sp_data *sp, sp_mbcomp *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps)
+{
+    uint32_t n, len;
+
+    update(sp, p);
+
+    for(n = 0; n < nsmps; n += SP_MBCOMP_BLOCK) {
+        len = nsmps - n < SP_MBCOMP_BLOCK ? nsmps - n : SP_MBCOMP_BLOCK;
+        compute_chunk(sp, p, in1 + n, in2 + n, out1 + n, out2 + n, len);
+    }
+
+    return SP_OK;
+}
+
+int sp_mbcomp_compute(sp_data *sp, sp_mbcomp *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_mbcomp_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
@@ -0,0 +1,226 @@
+/*
+ * Oversample
+ *
+ * 2x, 4x or 8x up/downsampler built from cascaded polyphase half-band
+ * FIR stages, to run nonlinear modules (saturator, dist, bitcrush...)
+ * at a higher rate. Half of the taps of a half-band filter are zero,
+ * so each 2x stage only computes the odd phase, as a symmetric sum.
+ *
+ * The filters are Kaiser-windowed sincs. The first stage is the
+ * steepest (passband to 0.4 * sr); the later ones only have to
+ * reject images of an already band-limited signal.
+ *
+ * Audio is processed in blocks, with the tap loop outside the sample
+ * loop so that the inner loop vectorizes.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const int stage_taps[SP_OVERSAMPLE_MAXSTAGES] = {16, 6, 4};
+static const double stage_beta[SP_OVERSAMPLE_MAXSTAGES] = {8.5, 8, 6};
+
+static double bessel_i0(double x)
+{
+    double sum = 1, term = 1;
+    int k;
+
+    for(k = 1; k < 50; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+        if(term < 1e-12 * sum) break;
+    }
+    return sum;
+}
+
+static void design(sp_oversample_stage *st, int ntaps, double beta)
+{
+    double len = 4 * ntaps;
+    double sum = 0;
+    int j;
+
+    st->ntaps = ntaps;
+
+    /* odd taps +-1, +-3, ... of a half-band sinc; the center tap is
+     * 0.5 and the even ones are zero */
+    for(j = 0; j < ntaps; j++) {
+        double n = 2 * j + 1;
+        double r = n / len;
+        double w = bessel_i0(beta * sqrt(1 - 4 * r * r)) / bessel_i0(beta);
+        st->coefs[j] = sin(M_PI * n / 2) / (M_PI * n) * w;
+        sum += st->coefs[j];
+    }
+
+    /* unity gain at DC */
+    for(j = 0; j < ntaps; j++) st->coefs[j] *= 0.25 / sum;
+}
+
+int sp_oversample_create(sp_oversample **p)
+{
+    *p = malloc(sizeof(sp_oversample));
+    return SP_OK;
+}
+
+int sp_oversample_destroy(sp_oversample **p)
+{
+    sp_oversample *pp = *p;
+    sp_auxdata_free(&pp->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_oversample_init(sp_data *sp, sp_oversample *p, int factor)
+{
+    uint32_t size = 0;
+    SPFLOAT *buf;
+    int s, k, n;
+
+    switch(factor) {
+        case 2: p->nstages = 1; break;
+        case 4: p->nstages = 2; break;
+        case 8: p->nstages = 3; break;
+        default: return SP_NOT_OK;
+    }
+    p->factor = factor;
+    p->latency = 0;
+
+    for(s = 0; s < p->nstages; s++) {
+        k = stage_taps[s];
+        n = SP_OVERSAMPLE_BLOCK << s;
+        design(&p->stage[s], k, stage_beta[s]);
+        size += 3 * (2 * k + n);
+        /* (2k - 1) samples at 2^s times the rate */
+        p->latency += (SPFLOAT)(2 * k - 1) / (1 << s);
+    }
+    size += 3 * SP_OVERSAMPLE_BLOCK * factor;
+
+    sp_auxdata_alloc(&p->buf, size * sizeof(SPFLOAT));
+    buf = (SPFLOAT *)p->buf.ptr;
+
+    for(s = 0; s < p->nstages; s++) {
+        k = p->stage[s].ntaps;
+        n = SP_OVERSAMPLE_BLOCK << s;
+        p->stage[s].up = buf;
+        buf += 2 * k + n;
+        p->stage[s].down_even = buf;
+        buf += 2 * k + n;
+        p->stage[s].down_odd = buf;
+        buf += 2 * k + n;
+    }
+    p->tmp[0] = buf;
+    buf += SP_OVERSAMPLE_BLOCK * factor;
+    p->tmp[1] = buf;
+    buf += SP_OVERSAMPLE_BLOCK * factor;
+    p->odd = buf;
+
+    return SP_OK;
+}
+
+SP_TARGET_CLONES
+static void stage_up(sp_oversample_stage *st, SPFLOAT *odd,
+    SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT *buf = st->up;
+    int k = st->ntaps;
+    int i, j;
+
+    memcpy(buf + 2 * k, in, n * sizeof(SPFLOAT));
+
+    for(i = 0; i < n; i++) odd[i] = 0;
+    for(j = 1; j <= k; j++) {
+        SPFLOAT c = 2 * st->coefs[j - 1];
+        SPFLOAT *a = buf + 1 + k - j;
+        SPFLOAT *b = buf + k + j;
+        for(i = 0; i < n; i++) odd[i] += c * (a[i] + b[i]);
+    }
+
+    for(i = 0; i < n; i++) {
+        out[2 * i] = buf[i + k];
+        out[2 * i + 1] = odd[i];
+    }
+
+    memmove(buf, buf + n, 2 * k * sizeof(SPFLOAT));
+}
+
+SP_TARGET_CLONES
+static void stage_down(sp_oversample_stage *st,
+    SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT *even = st->down_even;
+    SPFLOAT *odd = st->down_odd;
+    int k = st->ntaps;
+    int i, j;
+
+    for(i = 0; i < n; i++) {
+        even[2 * k + i] = in[2 * i];
+        odd[2 * k + i] = in[2 * i + 1];
+    }
+
+    for(i = 0; i < n; i++) out[i] = 0.5 * even[i + k + 1];
+    for(j = 1; j <= k; j++) {
+        SPFLOAT c = st->coefs[j - 1];
+        SPFLOAT *a = odd + k + 1 - j;
+        SPFLOAT *b = odd + k + j;
+        for(i = 0; i < n; i++) out[i] += c * (a[i] + b[i]);
+    }
+
+    memmove(even, even + n, 2 * k * sizeof(SPFLOAT));
+    memmove(odd, odd + n, 2 * k * sizeof(SPFLOAT));
+}
+
+int sp_oversample_up(sp_data *sp, sp_oversample *p,
+    SPFLOAT *in, SPFLOAT *up, uint32_t nsmps)
+{
+    uint32_t done = 0, n;
+    SPFLOAT *src, *dst;
+    int s;
+
+    while(done < nsmps) {
+        n = nsmps - done;
+        if(n > SP_OVERSAMPLE_BLOCK) n = SP_OVERSAMPLE_BLOCK;
+
+        src = in + done;
+        for(s = 0; s < p->nstages; s++) {
+            if(s == p->nstages - 1) dst = up + done * p->factor;
+            else dst = p->tmp[s & 1];
+            stage_up(&p->stage[s], p->odd, src, dst, n << s);
+            src = dst;
+        }
+
+        done += n;
+    }
+
+    return SP_OK;
+}
+
+int sp_oversample_down(sp_data *sp, sp_oversample *p,
+    SPFLOAT *up, SPFLOAT *out, uint32_t nsmps)
+{
+    uint32_t done = 0, n;
+    SPFLOAT *src, *dst;
+    int s;
+
+    while(done < nsmps) {
+        n = nsmps - done;
+        if(n > SP_OVERSAMPLE_BLOCK) n = SP_OVERSAMPLE_BLOCK;
+
+        src = up + done * p->factor;
+        for(s = p->nstages - 1; s >= 0; s--) {
+            if(s == 0) dst = out + done;
+            else dst = p->tmp[s & 1];
+            stage_down(&p->stage[s], src, dst, n << s);
+            src = dst;
+        }
+
+        done += n;
+    }
+
+    return SP_OK;
+}
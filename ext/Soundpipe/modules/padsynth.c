@@ -12,13 +12,25 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #include "soundpipe.h"
 
 #ifndef M_PI
 #define M_PI		3.14159265358979323846	
 #endif 
 
+/* sqrt of the cutoff in sp_padsynth_profile */
+#define PROFILE_WIDTH 3.8358
+
+#define CACHE_MAGIC "SPPAD1"
+
 int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps, 
         SPFLOAT f, SPFLOAT bw) 
 {
@@ -38,10 +50,17 @@ int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps,
         SPFLOAT bw_Hz;
         SPFLOAT bwi;
         SPFLOAT fi;
+        int lo, hi;
         bw_Hz = (pow(2.0, bw/1200.0) - 1.0) * f * nh;
         bwi = bw_Hz/(2.0*ps->size);
         fi = f*nh/ps->size;
-        for (i = 0; i < N/2 ; i++) {
+        /* the profile is 0 further than PROFILE_WIDTH * bwi from fi, so
+         * only the bins around the harmonic are computed */
+        lo = (int) floor((fi - PROFILE_WIDTH * bwi) * N) - 2;
+        hi = (int) ceil((fi + PROFILE_WIDTH * bwi) * N) + 2;
+        if (lo < 0) lo = 0;
+        if (hi > N/2) hi = N/2;
+        for (i = lo; i < hi ; i++) {
             SPFLOAT hprofile;
             hprofile = sp_padsynth_profile((i / (SPFLOAT) N) - fi, bwi);
             freq_amp[i] += hprofile*A[nh];
@@ -111,3 +130,195 @@ int sp_padsynth_normalize(int N, SPFLOAT *smp)
     for (i=0;i<N;i++) smp[i]/=max*1.4142;
     return SP_OK;
 }
+
+/*
+ * Disk cache
+ *
+ * sp_padsynth_load keeps the tables it renders in a directory, one file
+ * per table, named after a hash of everything the table depends on. The
+ * file holds a header and the harmonic amplitudes (checked in full when
+ * the file is reused) followed by the table. Reused tables are mapped
+ * read-only, so instances that load the same table share its pages.
+ *
+ * Rendering a large table takes a long time: call this from a worker
+ * thread, never from the audio thread.
+ */
+
+typedef struct {
+    char magic[8];
+    uint32_t size;
+    int32_t sr;
+    uint32_t nharm;
+    uint32_t floatsize;
+    double f;
+    double bw;
+} padsynth_header;
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+#ifndef _WIN32
+static int map_file(sp_padsynth_tbl *pt, const char *path,
+        const void *head, size_t offset, size_t len)
+{
+    struct stat st;
+    void *mem;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return SP_NOT_OK;
+    if (fstat(fd, &st) || (size_t) st.st_size != len) {
+        close(fd);
+        return SP_NOT_OK;
+    }
+    mem = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return SP_NOT_OK;
+
+    /* the header and amplitudes must match exactly, so that a hash
+     * collision or a stale file is never used */
+    if (memcmp(mem, head, offset)) {
+        munmap(mem, len);
+        return SP_NOT_OK;
+    }
+
+    pt->mem = mem;
+    pt->len = len;
+    pt->tbl = (const SPFLOAT *)((const char *) mem + offset);
+    pt->mapped = 1;
+    return SP_OK;
+}
+
+/* writes to a temporary file first, so that other instances never map a
+ * partly written table */
+static int write_file(const char *path, const void *data, size_t len)
+{
+    char tmp[1024];
+    const char *p = data;
+    ssize_t n;
+    int fd;
+
+    if ((size_t) snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path) >=
+            sizeof(tmp)) {
+        return SP_NOT_OK;
+    }
+    fd = mkstemp(tmp);
+    if (fd < 0) return SP_NOT_OK;
+    while (len > 0) {
+        n = write(fd, p, len);
+        if (n <= 0) {
+            close(fd);
+            unlink(tmp);
+            return SP_NOT_OK;
+        }
+        p += n;
+        len -= (size_t) n;
+    }
+    if (close(fd) || rename(tmp, path)) {
+        unlink(tmp);
+        return SP_NOT_OK;
+    }
+    return SP_OK;
+}
+#endif
+
+/* Loads a table of the given size, reusing the one in dir if there is
+ * one. amps holds the amplitude of each harmonic (amps[0] is not used)
+ * and f is the base frequency in cycles per table, as for
+ * sp_gen_padsynth. The phases are seeded from the hash, so the same
+ * parameters always give the same table. dir can be NULL, and the table
+ * is still rendered if the cache can't be read or written. */
+int sp_padsynth_load(sp_data *sp, sp_padsynth_tbl *pt, const char *dir,
+        uint32_t size, const SPFLOAT *amps, int nharm, SPFLOAT f, SPFLOAT bw)
+{
+    padsynth_header hdr;
+    uint64_t hash;
+    size_t offset, len;
+    char *mem;
+    sp_data tmp;
+    sp_ftbl ps, am;
+    char path[1024];
+
+    memset(pt, 0, sizeof(sp_padsynth_tbl));
+    if (size < 2 || nharm < 1) return SP_NOT_OK;
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    hdr.size = size;
+    hdr.sr = sp->sr;
+    hdr.nharm = (uint32_t) nharm;
+    hdr.floatsize = sizeof(SPFLOAT);
+    hdr.f = f;
+    hdr.bw = bw;
+    hash = fnv1a(0xcbf29ce484222325ULL, &hdr, sizeof(hdr));
+    hash = fnv1a(hash, amps, sizeof(SPFLOAT) * nharm);
+
+    offset = sizeof(hdr) + sizeof(SPFLOAT) * nharm;
+    len = offset + sizeof(SPFLOAT) * size;
+    mem = malloc(len);
+    if (mem == NULL) return SP_NOT_OK;
+    memcpy(mem, &hdr, sizeof(hdr));
+    memcpy(mem + sizeof(hdr), amps, sizeof(SPFLOAT) * nharm);
+
+#ifndef _WIN32
+    if (dir != NULL) {
+        snprintf(path, sizeof(path), "%s/%016llx.pad", dir,
+                (unsigned long long) hash);
+        if (map_file(pt, path, mem, offset, len) == SP_OK) {
+            pt->size = size;
+            free(mem);
+            return SP_OK;
+        }
+    }
+#endif
+
+    tmp = *sp;
+    sp_srand(&tmp, (uint32_t) (hash ^ (hash >> 32)));
+    memset(&ps, 0, sizeof(sp_ftbl));
+    memset(&am, 0, sizeof(sp_ftbl));
+    ps.size = size;
+    ps.tbl = (SPFLOAT *)(mem + offset);
+    am.size = (size_t) nharm;
+    am.tbl = (SPFLOAT *)(mem + sizeof(hdr));
+    sp_gen_padsynth(&tmp, &ps, &am, f, bw);
+
+#ifndef _WIN32
+    if (dir != NULL && write_file(path, mem, len) == SP_OK &&
+            map_file(pt, path, mem, offset, len) == SP_OK) {
+        pt->size = size;
+        free(mem);
+        return SP_OK;
+    }
+#else
+    (void) path;
+#endif
+
+    pt->mem = mem;
+    pt->len = len;
+    pt->tbl = (const SPFLOAT *)(mem + offset);
+    pt->size = size;
+    pt->mapped = 0;
+    return SP_OK;
+}
+
+void sp_padsynth_unload(sp_padsynth_tbl *pt)
+{
+#ifndef _WIN32
+    if (pt->mapped) {
+        munmap(pt->mem, pt->len);
+    } else
+#endif
+    {
+        free(pt->mem);
+    }
+    memset(pt, 0, sizeof(sp_padsynth_tbl));
+}
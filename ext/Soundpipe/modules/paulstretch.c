@@ -17,6 +17,34 @@
 #define M_PI		3.14159265358979323846
 #endif
 
+/* Turns the windowsize input samples in buf into a windowed frame with
+ * the same magnitudes and random phases. The result is not scaled by
+ * 1 / windowsize, which is left to the overlap-add. This is the costly
+ * part of the algorithm, and only uses the buffers of p, so that it can
+ * run on another thread than the overlap-add. */
+int sp_paulstretch_frame(sp_data *sp, sp_paulstretch *p, SPFLOAT *buf)
+{
+    uint32_t i;
+    uint32_t windowsize = p->windowsize;
+    SPFLOAT *window = p->window;
+
+    for(i = 0; i < windowsize; i++) {
+        buf[i] *= window[i];
+    }
+    kiss_fftr(p->fft, buf, p->tmp1);
+    for(i = 0; i < windowsize / 2; i++) {
+        SPFLOAT mag = sqrt(p->tmp1[i].r*p->tmp1[i].r + p->tmp1[i].i*p->tmp1[i].i);
+        SPFLOAT ph = ((SPFLOAT)sp_rand(sp) / SP_RANDMAX) * 2 * M_PI;
+        p->tmp1[i].r = mag * cos(ph); 
+        p->tmp1[i].i = mag * sin(ph); 
+    }
+    kiss_fftri(p->ifft, p->tmp1, buf);
+    for(i = 0; i < windowsize; i++) {
+        buf[i] *= window[i];
+    }
+    return SP_OK;
+}
+
 static void compute_block(sp_data *sp, sp_paulstretch *p) {
     uint32_t istart_pos = floor(p->start_pos);
     uint32_t pos; 
@@ -27,7 +55,6 @@ static void compute_block(sp_data *sp, sp_paulstretch *p) {
     SPFLOAT *hinv_buf = p->hinv_buf;
     SPFLOAT *old_windowed_buf= p->old_windowed_buf;
     SPFLOAT *tbl = p->ft->tbl;
-    SPFLOAT *window = p->window;
     SPFLOAT *output= p->output;
     for(i = 0; i < windowsize; i++) {
         /* Loop through buffer */
@@ -38,21 +65,13 @@ static void compute_block(sp_data *sp, sp_paulstretch *p) {
         } 
 
         if(pos < p->ft->size) {
-            buf[i] = tbl[pos] * window[i];
+            buf[i] = tbl[pos];
         } else {
             buf[i] = 0;
         }
     }
-    kiss_fftr(p->fft, buf, p->tmp1);
-    for(i = 0; i < windowsize / 2; i++) {
-        SPFLOAT mag = sqrt(p->tmp1[i].r*p->tmp1[i].r + p->tmp1[i].i*p->tmp1[i].i);
-        SPFLOAT ph = ((SPFLOAT)sp_rand(sp) / SP_RANDMAX) * 2 * M_PI;
-        p->tmp1[i].r = mag * cos(ph); 
-        p->tmp1[i].i = mag * sin(ph); 
-    }
-    kiss_fftri(p->ifft, p->tmp1, buf);
+    sp_paulstretch_frame(sp, p, buf);
     for(i = 0; i < windowsize; i++) {
-        buf[i] *= window[i];
         if(i < half_windowsize) {
             output[i] = (SPFLOAT)(buf[i] + old_windowed_buf[half_windowsize + i]) / windowsize;
             output[i] *= hinv_buf[i];
@@ -83,6 +102,7 @@ int sp_paulstretch_destroy(sp_paulstretch **p)
     return SP_OK;
 }
 
+/* ft can be NULL when only sp_paulstretch_frame is used */
 int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT windowsize, SPFLOAT stretch)
 {
     uint32_t i;
@@ -92,6 +112,8 @@ int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT win
     if(p->windowsize < 16) {
         p->windowsize = 16;
     }
+    /* the real FFT needs an even size */
+    p->windowsize &= ~1U;
     p->half_windowsize = p->windowsize / 2;
     p->displace_pos = (p->windowsize * 0.5) / p->stretch;
 
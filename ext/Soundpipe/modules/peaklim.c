@@ -10,15 +10,6 @@
 #define min(a,b) (((a) < (b)) ? (a) : (b))
 #endif
 
-#ifndef dB
-/* if below -100dB, set to -100dB to prevent taking log of zero */
-#define dB(x) 20.0 * ((x) > 0.00001 ? log10(x) : log10(0.00001))
-#endif
-
-#ifndef dB2lin
-#define dB2lin(x)           pow( 10.0, (x) / 20.0 )
-#endif
-
 int sp_peaklim_create(sp_peaklim **p)
 {
     *p = malloc(sizeof(sp_peaklim));
@@ -71,8 +62,10 @@ int sp_peaklim_compute(sp_data *sp, sp_peaklim *p, SPFLOAT *in, SPFLOAT *out)
     else
         p->level += p->b0_r * ( fabs(*in) - p->level);
 
-    db_gain = min(0.0, dB(dB2lin(p->thresh)/p->level));
-    gain = dB2lin(db_gain);		
+    /* gain reduction in dB, floored at -100dB */
+    db_gain = min(0.0, p->thresh - sp_fast_lin2db(p->level));
+    db_gain = max(db_gain, -100.0);
+    gain = sp_fast_db2lin(db_gain);
 
     *out = *in * gain;
 
@@ -0,0 +1,131 @@
+/*
+ * Pshift2
+ *
+ * Stereo version of pshift. The window phase and the crossfade
+ * gain are computed once per sample for both channels, while each
+ * channel has its own delay line. The two lines are interleaved so
+ * that every tap reads a left/right pair.
+ *
+ * sp_pshift2_compute_block() processes a block with the parameters
+ * read once, and keeps the state in locals for the whole block.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+int sp_pshift2_create(sp_pshift2 **p)
+{
+    *p = malloc(sizeof(sp_pshift2));
+    return SP_OK;
+}
+
+int sp_pshift2_destroy(sp_pshift2 **p)
+{
+    sp_pshift2 *pp = *p;
+    sp_auxdata_free(&pp->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_pshift2_init(sp_data *sp, sp_pshift2 *p, SPFLOAT maxwindow)
+{
+    uint32_t size = 2;
+
+    if(maxwindow < 1) maxwindow = 1;
+
+    /* the second tap reads up to two windows back */
+    while(size < (uint32_t)(2 * maxwindow) + 2) size <<= 1;
+
+    p->mask = size - 1;
+    sp_auxdata_alloc(&p->buf, 2 * size * sizeof(SPFLOAT));
+    p->pos = 0;
+    p->phs = 0;
+    p->shift = 0;
+    p->window = 1000;
+    p->xfade = 10;
+    p->prvshift = -1;
+    p->prvwindow = -1;
+    p->inc = 0;
+    return SP_OK;
+}
+
+int sp_pshift2_clear(sp_data *sp, sp_pshift2 *p)
+{
+    memset(p->buf.ptr, 0, p->buf.size);
+    p->pos = 0;
+    p->phs = 0;
+    return SP_OK;
+}
+
+int sp_pshift2_compute_block(sp_data *sp, sp_pshift2 *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps)
+{
+    SPFLOAT *buf = (SPFLOAT *)p->buf.ptr;
+    SPFLOAT window = p->window;
+    SPFLOAT xfade = p->xfade;
+    SPFLOAT inc, phs, d2, f1, f2, gain;
+    uint32_t mask = p->mask;
+    uint32_t pos = p->pos;
+    uint32_t n, w, a1, b1, a2, b2;
+    int32_t i1, i2;
+
+    if(window < 1) window = 1;
+    if(window > (mask - 1) / 2) window = (mask - 1) / 2;
+
+    if(p->shift != p->prvshift || window != p->prvwindow) {
+        p->inc = (1.f + window) - powf(2.f, p->shift / 12.f);
+        p->prvshift = p->shift;
+        p->prvwindow = window;
+    }
+    inc = p->inc;
+    phs = p->phs;
+
+    for(n = 0; n < nsmps; n++) {
+        /* written before the outputs, which may be the inputs */
+        w = 2 * (pos & mask);
+        buf[w] = in1[n];
+        buf[w + 1] = in2[n];
+
+        phs = fmodf(phs + inc, window);
+
+        if(xfade > 0) {
+            gain = phs / xfade;
+            if(gain > 1) gain = 1;
+        } else {
+            gain = 1;
+        }
+
+        i1 = (int32_t)phs;
+        f1 = phs - i1;
+        d2 = phs + window;
+        i2 = (int32_t)d2;
+        f2 = d2 - i2;
+
+        /* both channels of each tap are next to each other */
+        a1 = 2 * ((pos - i1) & mask);
+        b1 = 2 * ((pos - i1 - 1) & mask);
+        a2 = 2 * ((pos - i2) & mask);
+        b2 = 2 * ((pos - i2 - 1) & mask);
+
+        out1[n] = (buf[a1] * (1 - f1) + buf[b1] * f1) * gain +
+            (buf[a2] * (1 - f2) + buf[b2] * f2) * (1 - gain);
+        out2[n] = (buf[a1 + 1] * (1 - f1) + buf[b1 + 1] * f1) * gain +
+            (buf[a2 + 1] * (1 - f2) + buf[b2 + 1] * f2) * (1 - gain);
+
+        pos++;
+    }
+
+    p->phs = phs;
+    p->pos = pos;
+    return SP_OK;
+}
+
+int sp_pshift2_compute(sp_data *sp, sp_pshift2 *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_pshift2_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
@@ -0,0 +1,208 @@
+/*
+ * PSOLA
+ *
+ * Stereo pitch-synchronous overlap-add pitch shifter. The period of
+ * the mono mix is tracked with ptrack, once per hop. Grains two
+ * periods long are cut around analysis marks spaced one input period
+ * apart, Hann windowed and overlap-added at the shifted period. Both
+ * channels share the marks and the window, and have their own
+ * (interleaved) delay lines.
+ *
+ * The latency is two times the longest period, 2 * sr / minfreq.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAXFREQ 2000
+
+static uint32_t pow2_above(uint32_t n)
+{
+    uint32_t size = 1;
+    while(size < n) size <<= 1;
+    return size;
+}
+
+int sp_psola_create(sp_psola **p)
+{
+    *p = malloc(sizeof(sp_psola));
+    return SP_OK;
+}
+
+int sp_psola_destroy(sp_psola **p)
+{
+    sp_psola *pp = *p;
+    sp_ptrack_destroy(&pp->ptrack);
+    sp_auxdata_free(&pp->in);
+    sp_auxdata_free(&pp->out);
+    sp_auxdata_free(&pp->mono);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_psola_init(sp_data *sp, sp_psola *p, SPFLOAT minfreq)
+{
+    uint32_t hop;
+
+    if(minfreq < 20) minfreq = 20;
+
+    p->sr = sp->sr;
+    p->minfreq = minfreq;
+    p->maxfreq = MAXFREQ;
+    p->tmax = (uint32_t)(sp->sr / minfreq + 0.5);
+    p->latency = 2 * p->tmax;
+
+    /* ptrack needs at least 5 bins of sr / (4 * hop) Hz below
+     * minfreq */
+    hop = pow2_above((uint32_t)(5 * sp->sr / (4 * minfreq)));
+    if(hop < 64) hop = 64;
+    if(hop > 4096) hop = 4096;
+
+    sp_ptrack_create(&p->ptrack);
+    if(sp_ptrack_init(sp, p->ptrack, hop, 20) != SP_OK) {
+        return SP_NOT_OK;
+    }
+
+    /* grains read up to 4 * tmax back and write up to 2 * tmax ahead */
+    p->inmask = pow2_above(4 * p->tmax + 2) - 1;
+    p->outmask = pow2_above(2 * p->tmax + 1) - 1;
+    sp_auxdata_alloc(&p->in, 2 * (p->inmask + 1) * sizeof(SPFLOAT));
+    sp_auxdata_alloc(&p->out, 2 * (p->outmask + 1) * sizeof(SPFLOAT));
+    sp_auxdata_alloc(&p->mono, hop * sizeof(SPFLOAT));
+
+    p->shift = 0;
+    p->period = sp->sr / 100;
+    p->lag = p->latency - p->tmax;
+    p->syn = 0;
+    p->pos = 0;
+    return SP_OK;
+}
+
+int sp_psola_clear(sp_data *sp, sp_psola *p)
+{
+    memset(p->in.ptr, 0, p->in.size);
+    memset(p->out.ptr, 0, p->out.size);
+    p->period = p->sr / 100;
+    p->lag = p->latency - p->tmax;
+    p->syn = 0;
+    p->pos = 0;
+    return SP_OK;
+}
+
+static void add_grain(sp_psola *p, SPFLOAT ratio)
+{
+    SPFLOAT *in = (SPFLOAT *)p->in.ptr;
+    SPFLOAT *out = (SPFLOAT *)p->out.ptr;
+    SPFLOAT period = p->period;
+    SPFLOAT hop = period / ratio;
+    SPFLOAT target = p->latency;
+    SPFLOAT grain, scale;
+    double c, s, cd, sd, tmp;
+    uint32_t half, len, rd, wr, k;
+    int ch;
+
+    /* the grain spans two input periods; when shifting down by more
+     * than an octave the grains no longer overlap */
+    grain = period;
+    if(grain > p->tmax) grain = p->tmax;
+    half = (uint32_t)(grain + 0.5);
+    if(half < 1) half = 1;
+    len = 2 * half;
+    scale = hop < half ? sqrt(hop / half) : 1;
+
+    /* advance the analysis mark pitch-synchronously towards the
+     * input that lines up with the grain center */
+    target -= half;
+    while(p->lag - period >= target) p->lag -= period;
+    if(p->lag > target + 2 * p->tmax || p->lag < target) p->lag = target;
+
+    rd = p->pos - (uint32_t)(p->lag + 0.5) - half;
+    wr = p->pos;
+
+    c = 1;
+    s = 0;
+    cd = cos(2 * M_PI / len);
+    sd = sin(2 * M_PI / len);
+
+    for(k = 0; k < len; k++) {
+        SPFLOAT w = (SPFLOAT)(0.5 - 0.5 * c) * scale;
+        uint32_t ri = 2 * ((rd + k) & p->inmask);
+        uint32_t wi = 2 * ((wr + k) & p->outmask);
+        for(ch = 0; ch < 2; ch++) {
+            out[wi + ch] += in[ri + ch] * w;
+        }
+        tmp = c * cd - s * sd;
+        s = s * cd + c * sd;
+        c = tmp;
+    }
+
+    p->syn += hop;
+}
+
+static void process(sp_psola *p, SPFLOAT *in1, SPFLOAT *in2,
+    SPFLOAT *out1, SPFLOAT *out2, uint32_t nsmps)
+{
+    SPFLOAT *in = (SPFLOAT *)p->in.ptr;
+    SPFLOAT *out = (SPFLOAT *)p->out.ptr;
+    SPFLOAT ratio = pow(2.0, p->shift / 12.0);
+    uint32_t n, i;
+
+    for(n = 0; n < nsmps; n++) {
+        i = 2 * (p->pos & p->inmask);
+        in[i] = in1[n];
+        in[i + 1] = in2[n];
+
+        if(p->syn <= 0) add_grain(p, ratio);
+
+        i = 2 * (p->pos & p->outmask);
+        out1[n] = out[i];
+        out2[n] = out[i + 1];
+        out[i] = 0;
+        out[i + 1] = 0;
+
+        p->pos++;
+        p->syn -= 1;
+        p->lag += 1;
+    }
+}
+
+int sp_psola_compute_block(sp_data *sp, sp_psola *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2,
+    uint32_t nsmps)
+{
+    SPFLOAT *mono = (SPFLOAT *)p->mono.ptr;
+    uint32_t hop = p->ptrack->hopsize;
+    uint32_t done = 0, n, i;
+    SPFLOAT freq, amp;
+
+    while(done < nsmps) {
+        n = nsmps - done;
+        if(n > hop) n = hop;
+
+        for(i = 0; i < n; i++) {
+            mono[i] = (in1[done + i] + in2[done + i]) * 0.5;
+        }
+        sp_ptrack_compute_block(sp, p->ptrack, mono, n, &freq, &amp);
+        if(freq >= p->minfreq && freq <= p->maxfreq) {
+            p->period = p->sr / freq;
+        }
+
+        process(p, in1 + done, in2 + done, out1 + done, out2 + done, n);
+        done += n;
+    }
+
+    return SP_OK;
+}
+
+int sp_psola_compute(sp_data *sp, sp_psola *p,
+    SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    return sp_psola_compute_block(sp, p, in1, in2, out1, out2, 1);
+}
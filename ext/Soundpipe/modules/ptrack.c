@@ -101,7 +101,7 @@ int sp_ptrack_destroy(sp_ptrack **p)
     sp_ptrack *pp = *p;
     sp_auxdata_free(&pp->signal);
     sp_auxdata_free(&pp->prev);
-    sp_auxdata_free(&pp->sin);
+    sp_cache_release(pp->sin);
     sp_auxdata_free(&pp->spec2);
     sp_auxdata_free(&pp->spec1);
     sp_auxdata_free(&pp->peakarray);
@@ -110,9 +110,28 @@ int sp_ptrack_destroy(sp_ptrack **p)
     return SP_OK;
 }
 
+/* half a cycle of complex exponential, shared by instances with the
+ * same hop size */
+static int gen_sin(void *data, const sp_cache_key *key, void *ud)
+{
+    SPFLOAT *tmpb = data;
+    int i, hopsize = key->size, winsize = 2 * hopsize;
+
+    for (i = 0; i < hopsize; i++) {
+        tmpb[2*i] =   (SPFLOAT) cos((M_PI*i)/(winsize));
+        tmpb[2*i+1] = -(SPFLOAT)sin((M_PI*i)/(winsize));
+    }
+    return SP_OK;
+}
+
 int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks)
 {
+    sp_cache_key sin_key = {
+        .kind = SP_CACHE_PTRACK_SIN, .size = (uint32_t)ihopsize
+    };
+
     p->size = ihopsize;
+    p->sin = NULL;
 
     int i, winsize = p->size*2, powtwo, tmp;
     SPFLOAT *tmpb;
@@ -147,7 +166,8 @@ int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks)
 
     sp_auxdata_alloc(&p->signal, p->hopsize * sizeof(SPFLOAT));
     sp_auxdata_alloc(&p->prev, (p->hopsize*2 + 4*FLTLEN)*sizeof(SPFLOAT));
-    sp_auxdata_alloc(&p->sin, (p->hopsize*2)*sizeof(SPFLOAT));
+    p->sin = sp_cache_get(&sin_key, (p->hopsize*2)*sizeof(SPFLOAT),
+        gen_sin, NULL);
     sp_auxdata_alloc(&p->spec2, (winsize*4 + 4*FLTLEN)*sizeof(SPFLOAT));
     sp_auxdata_alloc(&p->spec1, (winsize*4)*sizeof(SPFLOAT));
 
@@ -155,10 +175,6 @@ int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks)
         tmpb[i] = 0.0;
     for (i = 0, tmpb = (SPFLOAT *)p->prev.ptr; i < winsize + 4 * FLTLEN; i++)
         tmpb[i] = 0.0;
-    for (i = 0, tmpb = (SPFLOAT *)p->sin.ptr; i < p->hopsize; i++) {
-        tmpb[2*i] =   (SPFLOAT) cos((M_PI*i)/(winsize));
-        tmpb[2*i+1] = -(SPFLOAT)sin((M_PI*i)/(winsize));
-    }
 
     p->cnt = 0;
     p->numpks = ipeaks;
@@ -183,7 +199,7 @@ static void ptrack(sp_data *sp, sp_ptrack *p)
     SPFLOAT *spec = (SPFLOAT *)p->spec1.ptr;
     SPFLOAT *spectmp = (SPFLOAT *)p->spec2.ptr;
     SPFLOAT *sig = (SPFLOAT *)p->signal.ptr;
-    SPFLOAT *sinus  = (SPFLOAT *)p->sin.ptr;
+    const SPFLOAT *sinus = p->sin;
     SPFLOAT *prev  = (SPFLOAT *)p->prev.ptr;
     PEAK  *peaklist = (PEAK *)p->peakarray.ptr;
     HISTOPEAK histpeak;
@@ -440,3 +456,31 @@ int sp_ptrack_compute(sp_data *sp, sp_ptrack *p, SPFLOAT *in, SPFLOAT *freq, SPF
 
     return SP_OK;
 }
+
+int sp_ptrack_compute_block(sp_data *sp, sp_ptrack *p, SPFLOAT *in,
+    uint32_t nsmps, SPFLOAT *freq, SPFLOAT *amp)
+{
+    SPFLOAT *buf = (SPFLOAT *)p->signal.ptr;
+    int h = p->hopsize;
+    SPFLOAT scale = p->dbfs;
+    uint32_t i = 0, n, j;
+
+    /* copy the input a hop at a time and only run the analysis at
+     * hop boundaries */
+    while (i < nsmps) {
+        if (p->cnt == h) {
+            ptrack(sp,p);
+            p->cnt = 0;
+        }
+        n = h - p->cnt;
+        if (n > nsmps - i) n = nsmps - i;
+        for (j = 0; j < n; j++) buf[p->cnt + j] = in[i + j] * scale;
+        p->cnt += n;
+        i += n;
+    }
+
+    *freq = p->cps;
+    *amp =  exp(p->dbs[p->histcnt] / 20.0 * log(10.0));
+
+    return SP_OK;
+}
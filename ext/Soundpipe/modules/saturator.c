@@ -107,3 +107,19 @@ int sp_saturator_compute(sp_data *sp, sp_saturator *p, SPFLOAT *in, SPFLOAT *out
     }
     return SP_OK;
 }
+
+/* Waveshaper and DC blocker only, without the internal 8x
+ * resampling. Meant to be run at an oversampled rate, e.g. with
+ * sp_oversample. The DC blocker is tuned for 8 * sr, so at other
+ * rates its cutoff moves proportionally. */
+int sp_saturator_shape(sp_data *sp, sp_saturator *p, SPFLOAT *in, SPFLOAT *out)
+{
+    SPFLOAT sig;
+
+    sig = p->drive * *in + p->dcoffset;
+    sig = sig / (1.0 + fabs(sig));
+
+    quad_compute(p->dcblocker[0], &sig, &sig);
+    quad_compute(p->dcblocker[1], &sig, out);
+    return SP_OK;
+}
@@ -0,0 +1,207 @@
+/*
+ * Vnoise
+ *
+ * White, pink and brown noise, a block at a time.
+ *
+ * sp_noise, sp_pinknoise and sp_brown call sp_rand, a scalar LCG, for
+ * every sample. Here SP_VNOISE_LANES xorshift32 generators run side by
+ * side, each giving every SP_VNOISE_LANES-th sample of the stream, so
+ * that filling a buffer with white noise is a loop of shifts and xors
+ * that vectorizes. Values left over from the last group of lanes are
+ * kept for the next call, so the stream does not depend on the block
+ * sizes it is read with.
+ *
+ * Pink noise is Paul Kellet's refined filter: six one-pole lowpass
+ * filters at different frequencies, fed with the white noise and
+ * summed. The filters run in lanes, one vector per sample, instead of
+ * the random row updates of the Voss algorithm in sp_pinknoise.
+ * Brown noise is the white noise through a leaky integrator with a
+ * 10 Hz corner. The levels are about those of sp_pinknoise and sp_brown.
+ *
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* output levels, for an RMS of about 0.14 (pink) and 0.28 (brown) */
+#define PINK_GAIN 0.081
+#define BROWN_RMS 0.28
+
+#define BROWN_FREQ 10
+
+static const SPFLOAT pink_coef[SP_VNOISE_LANES] = {
+    0.99886, 0.99332, 0.96900, 0.86650, 0.55000, -0.7616, 0, 0
+};
+
+static const SPFLOAT pink_gain[SP_VNOISE_LANES] = {
+    0.0555179 * PINK_GAIN, 0.0750759 * PINK_GAIN, 0.1538520 * PINK_GAIN,
+    0.3104856 * PINK_GAIN, 0.5329522 * PINK_GAIN, -0.0168980 * PINK_GAIN,
+    0, 0
+};
+
+int sp_vnoise_create(sp_vnoise **p)
+{
+    *p = malloc(sizeof(sp_vnoise));
+    return SP_OK;
+}
+
+int sp_vnoise_destroy(sp_vnoise **p)
+{
+    free(*p);
+    return SP_OK;
+}
+
+int sp_vnoise_seed(sp_data *sp, sp_vnoise *p, uint32_t seed)
+{
+    int l;
+    uint32_t z;
+
+    /* spread the seed over the lanes with the splitmix32 finalizer,
+     * xorshift needs a non-zero state */
+    for(l = 0; l < SP_VNOISE_LANES; l++) {
+        z = seed + 0x9e3779b9 * (l + 1);
+        z = (z ^ (z >> 16)) * 0x85ebca6b;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35;
+        z ^= z >> 16;
+        p->state[l] = z ? z : 1;
+    }
+    p->npool = 0;
+    return SP_OK;
+}
+
+int sp_vnoise_init(sp_data *sp, sp_vnoise *p)
+{
+    int l;
+    SPFLOAT a;
+
+    p->amp = 1.0;
+    p->type = SP_VNOISE_WHITE;
+
+    sp_vnoise_seed(sp, p, sp_rand(sp));
+
+    for(l = 0; l < SP_VNOISE_LANES; l++) p->pink[l] = 0;
+    p->prev = 0;
+
+    /* uniform noise in [-1, 1) has an RMS of 1 / sqrt(3) */
+    a = exp(-2 * M_PI * BROWN_FREQ / sp->sr);
+    p->brown = 0;
+    p->bcoef = a;
+    p->bgain = BROWN_RMS * sqrt(3 * (1 - a * a));
+    return SP_OK;
+}
+
+/* SP_VNOISE_LANES samples of white noise for each group */
+SP_TARGET_CLONES
+static void white(uint32_t *state, SPFLOAT *restrict out, uint32_t ngroups)
+{
+    uint32_t s[SP_VNOISE_LANES], x, g;
+    int l;
+
+    for(l = 0; l < SP_VNOISE_LANES; l++) s[l] = state[l];
+
+    for(g = 0; g < ngroups; g++) {
+        for(l = 0; l < SP_VNOISE_LANES; l++) {
+            x = s[l];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            s[l] = x;
+            out[g * SP_VNOISE_LANES + l] =
+                (SPFLOAT)(int32_t)x * (1.0f / 2147483648.0f);
+        }
+    }
+
+    for(l = 0; l < SP_VNOISE_LANES; l++) state[l] = s[l];
+}
+
+static void fill_white(sp_vnoise *p, SPFLOAT *out, uint32_t nsmps)
+{
+    uint32_t n = 0, ngroups;
+
+    while(n < nsmps && p->npool > 0) {
+        out[n++] = p->pool[SP_VNOISE_LANES - p->npool--];
+    }
+
+    ngroups = (nsmps - n) / SP_VNOISE_LANES;
+    white(p->state, out + n, ngroups);
+    n += ngroups * SP_VNOISE_LANES;
+
+    if(n < nsmps) {
+        white(p->state, p->pool, 1);
+        p->npool = SP_VNOISE_LANES;
+        while(n < nsmps) {
+            out[n++] = p->pool[SP_VNOISE_LANES - p->npool--];
+        }
+    }
+}
+
+static void pink(sp_vnoise *p, SPFLOAT *out, uint32_t nsmps)
+{
+    SPFLOAT b[SP_VNOISE_LANES], w, prev = p->prev;
+    uint32_t n;
+    int l;
+
+    for(l = 0; l < SP_VNOISE_LANES; l++) b[l] = p->pink[l];
+
+    for(n = 0; n < nsmps; n++) {
+        w = out[n];
+        for(l = 0; l < SP_VNOISE_LANES; l++) {
+            b[l] = pink_coef[l] * b[l] + pink_gain[l] * w;
+        }
+        out[n] = ((b[0] + b[1]) + (b[2] + b[3])) +
+            ((b[4] + b[5]) + (b[6] + b[7])) +
+            (SPFLOAT)(0.5362 * PINK_GAIN) * w +
+            (SPFLOAT)(0.115926 * PINK_GAIN) * prev;
+        prev = w;
+    }
+
+    for(l = 0; l < SP_VNOISE_LANES; l++) p->pink[l] = b[l];
+    p->prev = prev;
+}
+
+static void brown(sp_vnoise *p, SPFLOAT *out, uint32_t nsmps)
+{
+    SPFLOAT b = p->brown, a = p->bcoef, g = p->bgain;
+    uint32_t n;
+
+    for(n = 0; n < nsmps; n++) {
+        b = a * b + g * out[n];
+        out[n] = b;
+    }
+    p->brown = b;
+}
+
+int sp_vnoise_compute_block(sp_data *sp, sp_vnoise *p,
+    SPFLOAT *out, uint32_t nsmps)
+{
+    uint32_t n;
+    SPFLOAT amp = p->amp;
+
+    fill_white(p, out, nsmps);
+
+    switch(p->type) {
+        case SP_VNOISE_PINK:
+            pink(p, out, nsmps);
+            break;
+        case SP_VNOISE_BROWN:
+            brown(p, out, nsmps);
+            break;
+        default:
+            break;
+    }
+
+    if(amp != 1) {
+        for(n = 0; n < nsmps; n++) out[n] *= amp;
+    }
+    return SP_OK;
+}
+
+int sp_vnoise_compute(sp_data *sp, sp_vnoise *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_vnoise_compute_block(sp, p, out, 1);
+}
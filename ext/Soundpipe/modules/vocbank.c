@@ -0,0 +1,197 @@
+/*
+ * Vocbank
+ *
+ * Channel vocoder with a vectorized filter bank.
+ *
+ * The modulator and the carrier go through the same bank of bandpass
+ * filters, spaced logarithmically from fmin to fmax. The level of each
+ * modulator band is followed with separate attack and release times
+ * and sets the gain of the carrier band, and the carrier bands are
+ * summed. Each filter is two cascaded RBJ constant peak gain bandpass
+ * sections, in transposed direct form II.
+ *
+ * Unlike the FAUST vocoder, which runs 16 bands one at a time, the
+ * bands are stored in groups of SP_VOCBANK_LANES, with one array per
+ * coefficient and per state variable in each group, as in sp_biquads.
+ * For each sample the inner loop goes over the lanes of a group with
+ * no branches, so it vectorizes and each vector filters
+ * SP_VOCBANK_LANES bands. The envelope follower picks its coefficient
+ * with fabs instead of a comparison for the same reason. Bands past
+ * nbands, or past 0.45 of the sample rate, have zero coefficients and
+ * stay silent.
+ *
+ * Storage is allocated for maxbands at init. nbands and the other
+ * parameters can change at any time: the coefficients are recomputed
+ * at the start of the next block.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+int sp_vocbank_create(sp_vocbank **p)
+{
+    *p = malloc(sizeof(sp_vocbank));
+    return SP_OK;
+}
+
+int sp_vocbank_destroy(sp_vocbank **p)
+{
+    sp_auxdata_free(&(*p)->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_vocbank_init(sp_data *sp, sp_vocbank *p, int maxbands)
+{
+    if(maxbands < 1) return SP_NOT_OK;
+
+    p->maxbands = maxbands;
+    p->ngroups = (maxbands + SP_VOCBANK_LANES - 1) / SP_VOCBANK_LANES;
+    sp_auxdata_alloc(&p->buf, p->ngroups * sizeof(sp_vocbank_group));
+    p->group = p->buf.ptr;
+
+    p->nbands = maxbands;
+    p->atk = 0.01;
+    p->rel = 0.05;
+    p->bwratio = 1;
+    p->fmin = 80;
+    p->fmax = 12000;
+
+    p->prvnbands = -1;
+    p->prvatk = -1;
+    p->prvrel = -1;
+    return SP_OK;
+}
+
+int sp_vocbank_clear(sp_data *sp, sp_vocbank *p)
+{
+    int g;
+
+    for(g = 0; g < p->ngroups; g++) {
+        sp_vocbank_group *grp = &p->group[g];
+        memset(grp->env, 0, sizeof(grp->env));
+        memset(grp->mz, 0, sizeof(grp->mz));
+        memset(grp->cz, 0, sizeof(grp->cz));
+    }
+    return SP_OK;
+}
+
+static void design(sp_data *sp, sp_vocbank *p)
+{
+    int k, n = p->nbands;
+    SPFLOAT ratio, bw, f, w0, s, alpha;
+    sp_vocbank_group *grp;
+    int l;
+
+    if(n < 1) n = 1;
+    if(n > p->maxbands) n = p->maxbands;
+    p->nactive = (n + SP_VOCBANK_LANES - 1) / SP_VOCBANK_LANES;
+
+    /* bandwidth in octaves: the spacing of the bands times bwratio */
+    ratio = n > 1 ? log2(p->fmax / p->fmin) / (n - 1) : 1;
+    bw = ratio * p->bwratio;
+
+    for(k = 0; k < p->ngroups * SP_VOCBANK_LANES; k++) {
+        grp = &p->group[k / SP_VOCBANK_LANES];
+        l = k % SP_VOCBANK_LANES;
+        f = p->fmin * pow(2, k * ratio);
+        if(k >= n || f >= 0.45 * sp->sr) {
+            grp->b0[l] = grp->a1[l] = grp->a2[l] = 0;
+            continue;
+        }
+        w0 = 2 * M_PI * f / sp->sr;
+        s = sin(w0);
+        alpha = s * sinh(M_LN2 / 2 * bw * w0 / s);
+        grp->b0[l] = alpha / (1 + alpha);
+        grp->a1[l] = -2 * cos(w0) / (1 + alpha);
+        grp->a2[l] = (1 - alpha) / (1 + alpha);
+    }
+
+    p->prvnbands = p->nbands;
+    p->prvbwratio = p->bwratio;
+    p->prvfmin = p->fmin;
+    p->prvfmax = p->fmax;
+}
+
+SP_TARGET_CLONES
+static void filter_bank(sp_vocbank *p,
+    const SPFLOAT *car, const SPFLOAT *mod, SPFLOAT *out, uint32_t nsmps)
+{
+    SPFLOAT kup = p->kup, kdn = p->kdn;
+    SPFLOAT acc[SP_VOCBANK_LANES];
+    SPFLOAT x, c, y, w, d, sum;
+    sp_vocbank_group *grp;
+    int g, l;
+    uint32_t n;
+
+    for(n = 0; n < nsmps; n++) {
+        x = mod[n];
+        c = car[n];
+        for(l = 0; l < SP_VOCBANK_LANES; l++) acc[l] = 0;
+
+        for(g = 0; g < p->nactive; g++) {
+            grp = &p->group[g];
+            for(l = 0; l < SP_VOCBANK_LANES; l++) {
+                /* modulator band and its level */
+                y = grp->b0[l] * x + grp->mz[0][l];
+                grp->mz[0][l] = grp->mz[1][l] - grp->a1[l] * y;
+                grp->mz[1][l] = -grp->b0[l] * x - grp->a2[l] * y;
+                w = y;
+                y = grp->b0[l] * w + grp->mz[2][l];
+                grp->mz[2][l] = grp->mz[3][l] - grp->a1[l] * y;
+                grp->mz[3][l] = -grp->b0[l] * w - grp->a2[l] * y;
+
+                d = fabsf(y) - grp->env[l];
+                grp->env[l] += kup * (d + fabsf(d)) + kdn * (d - fabsf(d));
+
+                /* carrier band */
+                y = grp->b0[l] * c + grp->cz[0][l];
+                grp->cz[0][l] = grp->cz[1][l] - grp->a1[l] * y;
+                grp->cz[1][l] = -grp->b0[l] * c - grp->a2[l] * y;
+                w = y;
+                y = grp->b0[l] * w + grp->cz[2][l];
+                grp->cz[2][l] = grp->cz[3][l] - grp->a1[l] * y;
+                grp->cz[3][l] = -grp->b0[l] * w - grp->a2[l] * y;
+
+                acc[l] += y * grp->env[l];
+            }
+        }
+
+        sum = 0;
+        for(l = 0; l < SP_VOCBANK_LANES; l++) sum += acc[l];
+        out[n] = sum;
+    }
+}
+
+int sp_vocbank_compute_block(sp_data *sp, sp_vocbank *p,
+    SPFLOAT *car, SPFLOAT *mod, SPFLOAT *out, uint32_t nsmps)
+{
+    if(p->nbands != p->prvnbands || p->bwratio != p->prvbwratio ||
+        p->fmin != p->prvfmin || p->fmax != p->prvfmax) {
+        design(sp, p);
+    }
+
+    if(p->atk != p->prvatk || p->rel != p->prvrel) {
+        /* halved, as the follower adds d + fabs(d) = 2 * d when rising */
+        p->kup = 0.5 * (1 - exp(-1.0 / (p->atk * sp->sr)));
+        p->kdn = 0.5 * (1 - exp(-1.0 / (p->rel * sp->sr)));
+        p->prvatk = p->atk;
+        p->prvrel = p->rel;
+    }
+
+    filter_bank(p, car, mod, out, nsmps);
+    return SP_OK;
+}
+
+int sp_vocbank_compute(sp_data *sp, sp_vocbank *p,
+    SPFLOAT *car, SPFLOAT *mod, SPFLOAT *out)
+{
+    return sp_vocbank_compute_block(sp, p, car, mod, out, 1);
+}
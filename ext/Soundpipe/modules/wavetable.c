@@ -0,0 +1,193 @@
+/*
+ * Wavetable
+ *
+ * Band-limited, mipmapped wavetable with a multi-voice reader.
+ *
+ * Each frame of the wavetable is one cycle of a waveform. It is stored
+ * as one table per octave: level l keeps the harmonics up to
+ * size >> (l + 1), so a voice whose phase increment is inc cycles per
+ * sample reads level ceil(log2(inc * size)) and none of its harmonics
+ * go past Nyquist. The levels are made by removing harmonics from the
+ * spectrum of the frame with the FFT, which is too slow for the audio
+ * thread: call sp_wavetable_gen from a worker or at load time.
+ *
+ * The reader runs the voices one after another over the whole block,
+ * with a 32-bit fixed point phase, so that the sample loop has no
+ * branches and vectorizes (with gathers). Morphing between frames
+ * reads two tables, 4 reads per sample.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "soundpipe.h"
+#include "kiss_fftr.h"
+
+#define PHASE_RANGE 4294967296.0
+
+int sp_wavetable_create(sp_wavetable **p)
+{
+    *p = malloc(sizeof(sp_wavetable));
+    return SP_OK;
+}
+
+int sp_wavetable_destroy(sp_wavetable **p)
+{
+    sp_wavetable *pp = *p;
+    kiss_fftr_free(pp->fft);
+    kiss_fftr_free(pp->ifft);
+    sp_auxdata_free(&pp->buf);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_wavetable_init(sp_data *sp, sp_wavetable *p, uint32_t size, int nframes)
+{
+    uint32_t bits = 0;
+    size_t nfloats;
+    char *mem;
+
+    if(size < 4 || (size & (size - 1)) || nframes < 1) {
+        fprintf(stderr, "sp_wavetable: size must be a power of 2\n");
+        return SP_NOT_OK;
+    }
+    while((1U << bits) < size) bits++;
+
+    p->size = size;
+    /* one extra point so that interpolation never wraps */
+    p->stride = size + 1;
+    p->lobits = 32 - bits;
+    p->lomask = (uint32_t)((1ULL << p->lobits) - 1);
+    p->lodiv = 1.0 / (1ULL << p->lobits);
+    p->nlevels = bits;
+    p->nframes = nframes;
+
+    nfloats = (size_t)nframes * p->nlevels * p->stride + size;
+    sp_auxdata_alloc(&p->buf, nfloats * sizeof(SPFLOAT) +
+        2 * (size / 2 + 1) * sizeof(kiss_fft_cpx));
+    mem = p->buf.ptr;
+    p->spec = (kiss_fft_cpx *)mem;
+    p->tmp = p->spec + size / 2 + 1;
+    p->tbl = (SPFLOAT *)(p->tmp + size / 2 + 1);
+    p->wave = p->tbl + (size_t)nframes * p->nlevels * p->stride;
+
+    p->fft = kiss_fftr_alloc(size, 0, NULL, NULL);
+    p->ifft = kiss_fftr_alloc(size, 1, NULL, NULL);
+    return SP_OK;
+}
+
+int sp_wavetable_gen(sp_data *sp, sp_wavetable *p, int frame, const SPFLOAT *wave)
+{
+    uint32_t size = p->size, nbins = size / 2 + 1, k, j, nharm;
+    SPFLOAT scale = 1.0 / size;
+    SPFLOAT *tbl;
+    int l;
+
+    if(frame < 0 || frame >= p->nframes) return SP_NOT_OK;
+
+    memcpy(p->wave, wave, sizeof(SPFLOAT) * size);
+    kiss_fftr(p->fft, p->wave, p->spec);
+
+    for(l = 0; l < p->nlevels; l++) {
+        /* keep DC and the harmonics below Nyquist at the highest
+         * frequency that reads this level */
+        nharm = size >> (l + 1);
+        if(nharm > size / 2 - 1) nharm = size / 2 - 1;
+        for(k = 0; k < nbins; k++) {
+            if(k <= nharm) {
+                p->tmp[k] = p->spec[k];
+            } else {
+                p->tmp[k].r = 0;
+                p->tmp[k].i = 0;
+            }
+        }
+
+        tbl = p->tbl + ((size_t)frame * p->nlevels + l) * p->stride;
+        kiss_fftri(p->ifft, p->tmp, tbl);
+        for(j = 0; j < size; j++) tbl[j] *= scale;
+        tbl[size] = tbl[0];
+    }
+
+    return SP_OK;
+}
+
+/* level read by a voice at the given frequency */
+int sp_wavetable_level(sp_data *sp, sp_wavetable *p, SPFLOAT freq)
+{
+    SPFLOAT x = fabs(freq) * p->size / sp->sr;
+    int l = 0;
+
+    while(l < p->nlevels - 1 && (SPFLOAT)(1U << l) < x) l++;
+    return l;
+}
+
+SP_TARGET_CLONES
+static void read_voice(sp_wavetable *p,
+    const SPFLOAT *restrict ta, const SPFLOAT *restrict tb,
+    uint32_t phs, uint32_t inc, SPFLOAT morph, SPFLOAT amp,
+    SPFLOAT *restrict out, uint32_t nsmps)
+{
+    uint32_t lobits = p->lobits, lomask = p->lomask;
+    SPFLOAT lodiv = p->lodiv;
+    uint32_t n;
+    int32_t idx;
+    SPFLOAT frac, a, b;
+
+    if(ta == tb) {
+        for(n = 0; n < nsmps; n++) {
+            idx = (int32_t)(phs >> lobits);
+            frac = (phs & lomask) * lodiv;
+            a = ta[idx] + (ta[idx + 1] - ta[idx]) * frac;
+            out[n] += a * amp;
+            phs += inc;
+        }
+    } else {
+        for(n = 0; n < nsmps; n++) {
+            idx = (int32_t)(phs >> lobits);
+            frac = (phs & lomask) * lodiv;
+            a = ta[idx] + (ta[idx + 1] - ta[idx]) * frac;
+            b = tb[idx] + (tb[idx + 1] - tb[idx]) * frac;
+            out[n] += (a + (b - a) * morph) * amp;
+            phs += inc;
+        }
+    }
+}
+
+int sp_wavetable_compute(sp_data *sp, sp_wavetable *p, uint32_t nvoices,
+    uint32_t *phs, const SPFLOAT *freq, const SPFLOAT *wtpos,
+    const SPFLOAT *amp, SPFLOAT *out, uint32_t nsmps)
+{
+    uint32_t v, inc;
+    SPFLOAT pos, morph;
+    const SPFLOAT *ta, *tb;
+    int level, frame;
+    size_t framesize = (size_t)p->nlevels * p->stride;
+
+    memset(out, 0, sizeof(SPFLOAT) * nsmps);
+
+    for(v = 0; v < nvoices; v++) {
+        level = sp_wavetable_level(sp, p, freq[v]);
+        inc = (uint32_t)(int64_t)(freq[v] / sp->sr * PHASE_RANGE);
+
+        pos = wtpos[v];
+        pos = pos < 0 ? 0 : pos > 1 ? 1 : pos;
+        pos *= p->nframes - 1;
+        frame = (int)pos;
+        if(frame > p->nframes - 2) frame = p->nframes - 2;
+        if(frame < 0) frame = 0;
+        morph = pos - frame;
+
+        ta = p->tbl + frame * framesize + level * p->stride;
+        if(p->nframes == 1 || morph == 0) {
+            tb = ta;
+        } else {
+            tb = ta + framesize;
+        }
+
+        read_voice(p, ta, tb, phs[v], inc, morph, amp[v], out, nsmps);
+        phs[v] += inc * nsmps;
+    }
+
+    return SP_OK;
+}
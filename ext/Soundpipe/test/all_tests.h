@@ -4,6 +4,7 @@ TEST(t_atone, "atone", "bae03ea296123e33a29211503c30ffc1")
 TEST(t_allpass, "allpass", "aef5f3f109cc70ddf6087ac602f20a9a")
 TEST(t_bal, "bal", "b69e113862b22a053c74ed8334ca2546")
 TEST(t_biquad, "biquad", "0a3d247fe852ceb9ab27955780f510f3")
+TEST(t_biquads, "biquads", "1fe9bdb9f78e286fadcd9eb7aa106d4b")
 TEST(t_biscale, "biscale", "ca7d61430e28ffd58d0b4370660ab34a")
 TEST(t_blsaw, "blsaw", "a554132bb59acd699fe2c4e6180dbc6d")
 TEST(t_blsquare, "blsquare", "2e2466ed808465df5de309822cab6498")
@@ -16,7 +17,7 @@ TEST(t_clip, "clip", "8560d30573c759e0c7874666b641a059")
 TEST(t_comb, "comb", "dfcb2bbb1fcf157485218d6c6bde770f")
 TEST(t_bitcrush, "bitcrush", "0c93a78b75123299f6caac428ef3339e")
 TEST(t_delay, "delay", "bb61353652e27f1bc38e2f15d17f6174")
-TEST(t_dist, "dist", "5dd6a64b8885193f3f483df64bafc0e5")
+TEST(t_dist, "dist", "1d6612f14d9dfad94d7e3d7418ebf155")
 TEST(t_dmetro, "dmetro", "977818bf3207fe5bb358ec5253b20bb9")
 TEST(t_drip, "drip", "1d2b4ada2d286235cb7bf76678e1e964")
 TEST(t_dtrig, "dtrig", "4e4b520cc8b58363d2453cdf4c420871")
@@ -29,7 +30,7 @@ TEST(t_phasor, "phasor", "e0e96fbadf9736d6e7734028f6557555")
 TEST(t_tone, "tone", "5571f4488385f0f221f4ad0a58665b2b")
 TEST(t_noise, "noise", "05d1b638e85626876e2b1e3c2cd01a7c")
 TEST(t_pareq, "pareq", "5a9df59248a8fc15d543a81a8032019c")
-TEST(t_jitter, "jitter", "7b234521c41ce6ac9fe6586590a9ed1c")
+TEST(t_jitter, "jitter", "83bd70547923e68c6eb36513fe7b0120")
 TEST(t_pluck, "pluck", "cb9f40de0f65a34aac283755cf6cc92b")
 TEST(t_lpf18, "lpf18", "e9f83d8e6332bae5454c1c1a820f81ee")
 TEST(t_tbvcf, "tbvcf", "bbeee0e8e747a006acab06a269e7f896")
@@ -42,6 +43,7 @@ TEST(t_reverse, "reverse", "3296a3444115849585e7cb7a25899c7a")
 TEST(t_revsc, "revsc", "e5fcee0007e06587d04d5d6c8bcddbc2")
 TEST(t_rpt, "rpt", "b4e220ce158b626a2e5972782a3ce66b")
 TEST(t_maygate, "maygate", "7147aa5764871be6ec380ebd2d7cd8a1")
+TEST(t_mbcomp, "mbcomp", "382569897ccf3643e9994b80e3a0536b")
 TEST(t_samphold, "samphold", "cafe3a8f9576b62eb57d9e849d4c8901")
 TEST(t_saturator, "saturator", "141c604b99d3db2cebf47c704197f736")
 TEST(t_scale, "scale", "ca7d61430e28ffd58d0b4370660ab34a")
@@ -50,8 +52,10 @@ TEST(t_tenv, "tenv", "3ddfd9bb88d6e12b96dafc291f539da4")
 TEST(t_tenv2, "tenv2", "d4a9ab8ed8f48f4da7714848fb76721a")
 TEST(t_tseq, "tseq", "be3d56a2d11b6f2e86457596285a5374")
 TEST(t_vdelay, "vdelay", "9b1be87c6b579fde2341515f4d82c008")
-TEST(t_mode, "mode", "c7d72851a98e642e6f6881d867fdff14")
+TEST(t_vnoise, "vnoise", "e3c8a46ced8f0a7564aaea0fe1f185ab")
+TEST(t_mode, "mode", "daa56f707aaf1977587cc86c394be516")
 TEST(t_jcrev, "jcrev", "1e7125e4563d588fc8d1b417720087ad")
+TEST(t_fdline, "fdline", "10856bda35dc594c81eb1ab6175aad6b")
 TEST(t_fold, "fold", "d08344b5dc59f220227818278fe43c26")
 TEST(t_gen_sinesum, "gen_sinesum", "8be57d6b8dc27da0dc094ec0802c4145")
 TEST(t_gen_sine, "gen_sine", "26564cbc0556ae9586c7480d4dec2f83")
@@ -61,6 +65,8 @@ TEST(t_gen_vals, "gen_vals", "b40825a6ee05f1219b87f3b30d5f1331")
 TEST(t_gen_xline, "gen_xline", "5c6050443a98326723e1809b67b73a9f")
 TEST(t_gen_line, "gen_line", "9eb3fdbed1598e756ed3b2ce7df03889")
 TEST(t_expon, "expon", "4e7c83be557f938e282c854ba04d4427")
+TEST(t_fastmath, "fastmath", "9b1be87c6b579fde2341515f4d82c008")
+TEST(t_cache, "cache", "41da67313d9fe2cc4e8168c214b5ab01")
 TEST(t_randh, "randh", "cfd39121b73a3621e36a9bef09df1a46")
 TEST(t_trand, "trand", "f1a3ff83bffea276428d2f78a61f2e9c")
 TEST(t_adsr, "adsr", "da408e8528aec4e13f3ec648baf18387")
@@ -70,15 +76,18 @@ TEST(t_crossfade, "crossfade", "bbea7ec7d1d54f628351a8e2ba75b909")
 TEST(t_fof, "fof", "6fbe6de36f0a9b5591ada0e7026e1797")
 TEST(t_fosc, "fosc", "38b9082bbd866f1246a5735c40f60f8e")
 TEST(t_oscmorph, "oscmorph", "d0d7f65716d846eb1fab90d4fa07f8bf")
+TEST(t_oversample, "oversample", "e88bf6bb2d0ddddce9435f67bce8d6ea")
 TEST(t_pshift, "pshift", "166ddd604d7b411e6d53be271b5be973")
+TEST(t_pshift2, "pshift2", "28bcb1721d72aa7fec3388c6f7f60c17")
 TEST(t_sdelay, "sdelay", "3e8e284a51bf96e7dd6fa4b6a1d34f34")
 TEST(t_line, "line", "dec3380002a2e70c9f854f8069525633")
 TEST(t_tblrec, "tblrec", "9cedd52785459aed553fa3faf6f3da0c")
 TEST(t_wpkorg35, "wpkorg35", "2a25ec94d510ac59b430ef858f89fb97")
 TEST(t_tseg, "tseg", "a7bd2bda3b4db43476684c7dd8e81495")
+TEST(t_vocbank, "vocbank", "37a92d763fb9c4c66215519554c2373f")
 TEST(t_vocoder, "vocoder", "d988fcf1e28b165bc64e77d53df20f08")
 TEST(t_fog, "fog", "ab8cf3704db8198845d1726563462156")
-TEST(t_compressor, "compressor", "8b717b24d86669564aaf9ef859fbf62c")
+TEST(t_compressor, "compressor", "55da01babac036445d0c0895cedbc790")
 TEST(t_hilbert, "hilbert", "7c85330d2360d6c7e02f5a41efb6ee3f")
 TEST(t_timer, "timer", "addcd2e6c740921c0829e1db4afdf462")
 TEST(t_autowah, "autowah", "4e4a78480cd24e8bae68672a86d1a58d")
@@ -86,7 +95,8 @@ TEST(t_tabread, "tabread", "9b1be87c6b579fde2341515f4d82c008")
 TEST(t_nsmp, "nsmp", "39212b911808a8059e90d07996342b41")
 TEST(t_zitarev, "zitarev", "1ccae5b4673ab4012d946686323ec484")
 TEST(t_thresh, "thresh", "8d72ab360c9198fb4e469b092349e26d")
-TEST(t_padsynth, "padsynth", "67e7468fc3b13b0e6a29e581efab26b2")
+TEST(t_padsynth, "padsynth", "54ef030cc13e428eb62bb59b2829658b")
+TEST(t_padsynth_cache, "padsynth_cache", "410b3b685c541af5985ce38f27044f60")
 TEST(t_phaser, "phaser", "66b4969e5eacdb27debce0751e34ef6d")
 TEST(t_bar, "bar", "567a8d8b46bcd3c00307b8f714f51c78")
 TEST(t_conv, "conv", "9b1be87c6b579fde2341515f4d82c008")
@@ -101,11 +111,12 @@ TEST(t_tadsr, "tadsr", "9b1be87c6b579fde2341515f4d82c008")
 TEST(t_switch, "switch", "49d42701c018204b9029b236d5f3857a")
 TEST(t_waveset, "waveset", "a6508d38f8e8a5b40b1fcd16f2c6cbe8")
 TEST(t_ptrack, "ptrack", "997c0c9f1cc2760529fd3e86a3106509")
-TEST(t_pdhalf, "pdhalf", "9caabb285a1a1b4f6c2b16f8b709dba5")
+TEST(t_psola, "psola", "453442ebbae4e603921f382acf9a5826")
+TEST(t_pdhalf, "pdhalf", "eb4a0ae3d0a0244cf03372be71728c42")
 TEST(t_pinknoise, "pinknoise", "2d1e37e1611287d6f3505b0bccd26eeb")
 TEST(t_pitchamdf, "pitchamdf", "4d4777f817d5ffb52b299d7dd9197b4a")
 TEST(t_panst, "panst", "e43ae01af73f128255d2bceedbd12eb7")
-TEST(t_peaklim, "peaklim", "63f1990a207cd7f31ebdcb3f6de7f8e3")
+TEST(t_peaklim, "peaklim", "22102fef862438f663e7ae5c3a4fb0c0")
 TEST(t_brown, "brown", "91d7b620d151ad9f4661ce6e3499240f")
 TEST(t_spa, "spa", "311150fe437a3d06f24057b090298a90")
 TEST(t_rspline, "rspline", "d3b3c672faeac7f4824c6863946a737e")
@@ -113,3 +124,4 @@ TEST(t_voc, "voc", "30f7afbb0eba7753fd0891f3cb58c1d5")
 TEST(t_lpc, "lpc", "b08d7bce47c8b63ac1956ffad58b108f")
 TEST(t_smoothdelay, "smoothdelay", "fc1a46df39c40e37aacc019152164717")
 TEST(t_talkbox, "talkbox", "67e3e081d8879ac20f51deb4de69f349")
+TEST(t_wavetable, "wavetable", "73cabcab9a0b6841715d1cd4f4cafe2e")
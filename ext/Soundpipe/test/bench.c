@@ -0,0 +1,217 @@
+#define _POSIX_C_SOURCE 199309L
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+#define PERF(str, desc) int str(sp_bench *bn, sp_data *sp);
+#include "perf_list.h"
+#undef PERF
+
+#define SIZE(x) sizeof(x) / sizeof(*x)
+
+typedef struct {
+    const char *desc;
+    double mean;
+    double stddev;
+    double min;
+} bench_result;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+int sp_bench_create(sp_bench **bn, uint32_t warmup, uint32_t iterations)
+{
+    *bn = malloc(sizeof(sp_bench));
+    sp_bench *bp = *bn;
+    bp->warmup = warmup;
+    bp->iterations = iterations;
+    bp->cur = 0;
+    bp->start = 0;
+    bp->times = calloc(iterations, sizeof(uint64_t));
+    return SP_OK;
+}
+
+int sp_bench_destroy(sp_bench **bn)
+{
+    free((*bn)->times);
+    free(*bn);
+    return SP_OK;
+}
+
+int sp_bench_run(sp_bench *bn)
+{
+    uint64_t end = now_ns();
+
+    if(bn->cur > bn->warmup) {
+        bn->times[bn->cur - 1 - bn->warmup] = end - bn->start;
+    }
+
+    if(bn->cur == bn->warmup + bn->iterations) {
+        bn->cur = 0;
+        return 0;
+    }
+
+    bn->cur++;
+    bn->start = now_ns();
+    return 1;
+}
+
+static void calc_result(sp_bench *bn, uint32_t len, bench_result *res)
+{
+    /* time per sample of 1 unit */
+    double scale = 1.0 / ((double)len * NUM);
+    double sum = 0, sqsum = 0;
+    uint32_t i;
+
+    res->min = bn->times[0] * scale;
+    for(i = 0; i < bn->iterations; i++) {
+        double t = bn->times[i] * scale;
+        sum += t;
+        if(t < res->min) res->min = t;
+    }
+    res->mean = sum / bn->iterations;
+    for(i = 0; i < bn->iterations; i++) {
+        double d = bn->times[i] * scale - res->mean;
+        sqsum += d * d;
+    }
+    res->stddev = bn->iterations > 1 ?
+        sqrt(sqsum / (bn->iterations - 1)) : 0;
+}
+
+static int write_json(const char *filename, bench_result *res, uint32_t nres,
+        uint32_t len, uint32_t warmup, uint32_t iterations)
+{
+    uint32_t n;
+    FILE *fp = fopen(filename, "w");
+
+    if(fp == NULL) {
+        fprintf(stderr, "Could not open %s\n", filename);
+        return 1;
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"sr\": %d,\n", SR);
+    fprintf(fp, "  \"len\": %u,\n", len);
+    fprintf(fp, "  \"units\": %d,\n", NUM);
+    fprintf(fp, "  \"warmup\": %u,\n", warmup);
+    fprintf(fp, "  \"iterations\": %u,\n", iterations);
+    fprintf(fp, "  \"results\": [\n");
+    for(n = 0; n < nres; n++) {
+        fprintf(fp, "    {\"name\": \"%s\", \"ns_per_sample\": %.4f, "
+                "\"stddev\": %.4f, \"min\": %.4f}%s\n",
+                res[n].desc, res[n].mean, res[n].stddev, res[n].min,
+                n + 1 < nres ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    fclose(fp);
+    return 0;
+}
+
+static void print_help(void)
+{
+    printf("Usage: bench [options] [module...]\n");
+    printf("\t-n NUM: timed iterations per module (default 10)\n");
+    printf("\t-w NUM: untimed warmup iterations (default 2)\n");
+    printf("\t-l SEC: seconds of audio per iteration (default %d)\n", LEN);
+    printf("\t-j FILE: also write the results as JSON to FILE\n");
+}
+
+int main(int argc, char *argv[])
+{
+    sp_bench_entry benches [] = {
+#define PERF(str, desc) {str, desc},
+#include "perf_list.h"
+#undef PERF
+    };
+
+    uint32_t n, i;
+    uint32_t warmup = 2;
+    uint32_t iterations = 10;
+    double len_sec = LEN;
+    const char *json = NULL;
+    int argpos = 1;
+    int err = 0;
+    bench_result *res;
+    uint32_t nres = 0;
+    sp_bench *bn;
+    sp_data *sp;
+
+    for(; argpos < argc && argv[argpos][0] == '-'; argpos++) {
+        if(argpos + 1 >= argc) {
+            print_help();
+            return 1;
+        }
+        if(!strcmp(argv[argpos], "-n")) {
+            iterations = atoi(argv[++argpos]);
+        } else if(!strcmp(argv[argpos], "-w")) {
+            warmup = atoi(argv[++argpos]);
+        } else if(!strcmp(argv[argpos], "-l")) {
+            len_sec = atof(argv[++argpos]);
+        } else if(!strcmp(argv[argpos], "-j")) {
+            json = argv[++argpos];
+        } else {
+            print_help();
+            return 1;
+        }
+    }
+
+    if(iterations < 1 || len_sec <= 0) {
+        print_help();
+        return 1;
+    }
+
+    res = calloc(SIZE(benches), sizeof(bench_result));
+
+    printf("# %-14s %12s %10s %12s\n", "module", "ns/sample", "stddev", "min");
+    for(n = 0; n < SIZE(benches); n++) {
+        /* only run the given modules, if any */
+        if(argpos < argc) {
+            for(i = argpos; i < (uint32_t)argc; i++) {
+                if(!strcmp(argv[i], benches[n].desc)) break;
+            }
+            if(i == (uint32_t)argc) continue;
+        }
+
+        sp_create(&sp);
+        sp_srand(sp, 12345);
+        sp->sr = SR;
+        sp->len = (uint32_t)(sp->sr * len_sec);
+        sp_bench_create(&bn, warmup, iterations);
+
+        if(benches[n].func(bn, sp) == SP_OK) {
+            res[nres].desc = benches[n].desc;
+            calc_result(bn, sp->len, &res[nres]);
+            printf("%-16s %12.4f %10.4f %12.4f\n", res[nres].desc,
+                    res[nres].mean, res[nres].stddev, res[nres].min);
+            fflush(stdout);
+            nres++;
+        } else {
+            fprintf(stderr, "%s: failed to set up\n", benches[n].desc);
+            err = 1;
+        }
+
+        sp_bench_destroy(&bn);
+        sp_destroy(&sp);
+    }
+
+    if(json != NULL) {
+        if(write_json(json, res, nres, (uint32_t)(SR * len_sec),
+                warmup, iterations)) {
+            err = 1;
+        }
+    }
+
+    free(res);
+    return err;
+}
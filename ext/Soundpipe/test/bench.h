@@ -0,0 +1,21 @@
+#include <stdint.h>
+
+typedef struct {
+    /* iterations that are run but not timed */
+    uint32_t warmup;
+    uint32_t iterations;
+    uint32_t cur;
+    uint64_t start;
+    /* duration of each timed iteration in nanoseconds */
+    uint64_t *times;
+} sp_bench;
+
+typedef struct {
+    int (* func)(sp_bench *, sp_data *);
+    const char *desc;
+} sp_bench_entry;
+
+int sp_bench_create(sp_bench **bn, uint32_t warmup, uint32_t iterations);
+int sp_bench_destroy(sp_bench **bn);
+/* Times the compute loop. Usage: while(sp_bench_run(bn)) { ... } */
+int sp_bench_run(sp_bench *bn);
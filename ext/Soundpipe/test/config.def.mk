@@ -6,6 +6,7 @@ t_atone \
 t_bal \
 t_bar \
 t_biquad \
+t_biquads \
 t_biscale \
 t_bitcrush \
 t_blsaw \
@@ -16,6 +17,7 @@ t_butbp \
 t_butbr \
 t_buthp \
 t_butlp \
+t_cache \
 t_clip \
 t_comb \
 t_conv \
@@ -29,7 +31,9 @@ t_dtrig \
 t_dust \
 t_eqfil \
 t_expon \
+t_fastmath \
 t_fofilt \
+t_fdline \
 t_fold \
 t_foo \
 t_fof \
@@ -51,6 +55,7 @@ t_line \
 t_lpc \
 t_lpf18 \
 t_maygate \
+t_mbcomp \
 t_metro \
 t_mincer \
 t_mode \
@@ -59,10 +64,12 @@ t_noise \
 t_nsmp \
 t_osc \
 t_oscmorph \
+t_oversample \
 t_pan2 \
 t_panst \
 t_pareq \
 t_padsynth \
+t_padsynth_cache \
 t_paulstretch \
 t_peaklim \
 t_pdhalf \
@@ -75,7 +82,9 @@ t_port \
 t_posc3 \
 t_prop \
 t_pshift \
+t_pshift2 \
 t_ptrack \
+t_psola \
 t_randh \
 t_randi \
 t_random \
@@ -107,11 +116,14 @@ t_trand \
 t_tseq \
 t_tseg \
 t_vdelay \
+t_vnoise \
 t_voc \
+t_vocbank \
 t_vocoder \
 t_compressor \
 t_wpkorg35 \
 t_waveset \
+t_wavetable \
 t_zitarev
 
 PERF=\
@@ -122,6 +134,7 @@ p_autowah \
 p_bal \
 p_bar \
 p_biquad \
+p_biquads \
 p_biscale \
 p_bitcrush \
 p_blsaw \
@@ -149,6 +162,7 @@ p_expon \
 p_fofilt \
 p_fof \
 p_fog \
+p_fdline \
 p_fold \
 p_fosc \
 p_hilbert \
@@ -158,12 +172,14 @@ p_jitter \
 p_line \
 p_lpf18 \
 p_maygate \
+p_mbcomp \
 p_metro \
 p_mincer \
 p_mode \
 p_moogladder \
 p_osc \
 p_oscmorph \
+p_oversample \
 p_paulstretch \
 p_noise \
 p_pan2 \
@@ -180,7 +196,9 @@ p_port \
 p_posc3 \
 p_prop \
 p_pshift \
+p_pshift2 \
 p_ptrack \
+p_psola \
 p_randh \
 p_randi \
 p_random \
@@ -210,7 +228,10 @@ p_tone \
 p_trand \
 p_tseg \
 p_vdelay \
+p_vnoise \
 p_voc \
+p_vocbank \
 p_waveset \
+p_wavetable \
 p_wpkorg35 \
 p_zitarev \
@@ -8,13 +8,9 @@ header=[[
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_FOO(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT in = 0, out = 0;
 ]]
@@ -27,8 +23,10 @@ compute=[[
         sp_FOO_init(sp, unit[u]);
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_FOO_compute(sp, unit[u], &in, &out);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_FOO_compute(sp, unit[u], &in, &out);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_FOO_destroy(&unit[u]);
@@ -36,11 +34,11 @@ compute=[[
 
 
 footer=[[
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 ]]
 
+header = string.gsub(header, "FOO", name)
 compute = string.gsub(compute, "FOO", name)
 
 print(header)
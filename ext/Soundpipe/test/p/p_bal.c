@@ -2,13 +2,9 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_bal(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT in = 0, out = 0, comp = 0;
 
@@ -19,13 +15,14 @@ int main() {
         sp_bal_init(sp, unit[u]);
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_bal_compute(sp, unit[u], &in, &comp, &out);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_bal_compute(sp, unit[u], &in, &comp, &out);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_bal_destroy(&unit[u]);
 
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_biquads(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    int s;
+    SPFLOAT frames[64 * SP_BIQUADS_LANES] = {0};
+
+    sp_biquads *unit[NUM];
+
+    for(u = 0; u < NUM; u++) { 
+        sp_biquads_create(&unit[u]);
+        sp_biquads_init(sp, unit[u], 6);
+        for(s = 0; s < 6; s++) {
+            sp_biquads_design(sp, unit[u], s, 0, SP_BIQUADS_PEAK, 100 + s * 1000, 1, 3);
+            sp_biquads_design(sp, unit[u], s, 1, SP_BIQUADS_PEAK, 100 + s * 1000, 1, 3);
+        }
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_biquads_compute_block(sp, unit[u], frames, frames, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_biquads_destroy(&unit[u]);
+
+    return SP_OK;
+}
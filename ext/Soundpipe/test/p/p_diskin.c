@@ -2,30 +2,33 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_diskin(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT in = 0, out = 0;
 
     sp_diskin *unit[NUM];
+    FILE *fp;
+
+    /* sp_diskin_init() exits if the file is missing */
+    fp = fopen(SAMPDIR "oneart.wav", "rb");
+    if(fp == NULL) return SP_NOT_OK;
+    fclose(fp);
 
     for(u = 0; u < NUM; u++) { 
         sp_diskin_create(&unit[u]);
         sp_diskin_init(sp, unit[u], SAMPDIR "oneart.wav");
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_diskin_compute(sp, unit[u], &in, &out);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_diskin_compute(sp, unit[u], &in, &out);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_diskin_destroy(&unit[u]);
 
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 
@@ -0,0 +1,35 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_fdline(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    SPFLOAT in[64], del[64], out[64];
+
+    sp_fdline *unit[NUM];
+
+    for(t = 0; t < 64; t++) {
+        in[t] = (SPFLOAT)(t % 16) / 16 - 0.5;
+        del[t] = 1000.5 + t * 0.1;
+    }
+
+    for(u = 0; u < NUM; u++) { 
+        sp_fdline_create(&unit[u]);
+        sp_fdline_init(sp, unit[u], 1.0);
+        unit[u]->feedback = 0.5;
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_fdline_compute_block(sp, unit[u], in, del, out, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_fdline_destroy(&unit[u]);
+
+    return SP_OK;
+}
@@ -0,0 +1,36 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_mbcomp(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    int i;
+    SPFLOAT in[64], out1[64], out2[64];
+
+    sp_mbcomp *unit[NUM];
+
+    for(t = 0; t < 64; t++) in[t] = (SPFLOAT)(t % 16) / 16 - 0.5;
+
+    for(u = 0; u < NUM; u++) { 
+        sp_mbcomp_create(&unit[u]);
+        sp_mbcomp_init(sp, unit[u]);
+        for(i = 0; i < SP_MBCOMP_BANDS; i++) {
+            unit[u]->thresh[i] = -20;
+            unit[u]->ratio[i] = 4;
+        }
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_mbcomp_compute_block(sp, unit[u], in, in, out1, out2, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_mbcomp_destroy(&unit[u]);
+
+    return SP_OK;
+}
@@ -0,0 +1,31 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_oversample(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    SPFLOAT in[64] = {0}, out[64];
+    SPFLOAT up[64 * 4];
+
+    sp_oversample *unit[NUM];
+
+    for(u = 0; u < NUM; u++) { 
+        sp_oversample_create(&unit[u]);
+        sp_oversample_init(sp, unit[u], 4);
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_oversample_up(sp, unit[u], in, up, 64);
+                sp_oversample_down(sp, unit[u], up, out, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_oversample_destroy(&unit[u]);
+
+    return SP_OK;
+}
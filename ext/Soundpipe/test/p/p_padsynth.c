@@ -2,30 +2,26 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
-    uint32_t t, u;
-    SPFLOAT in = 0, out = 0;
+#define NHARM 64
 
-    sp_padsynth *unit[NUM];
+/* renders a table as long as the benchmark, without the disk cache, so
+ * that the time per sample is the time per table sample */
+int p_padsynth(sp_bench *bn, sp_data *sp) {
+    uint32_t i;
+    uint32_t size = sp->len & ~1UL;
+    SPFLOAT amps[NHARM];
+    sp_padsynth_tbl pt;
 
-    for(u = 0; u < NUM; u++) { 
-        sp_padsynth_create(&unit[u]);
-        sp_padsynth_init(sp, unit[u]);
-    }
+    amps[0] = 0;
+    for(i = 1; i < NHARM; i++) amps[i] = 1.0 / i;
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_padsynth_compute(sp, unit[u], &in, &out);
+    while(sp_bench_run(bn)) {
+        sp_padsynth_load(sp, &pt, NULL, size, amps, NHARM,
+            220.0 * size / sp->sr, 40);
+        sp_padsynth_unload(&pt);
     }
 
-    for(u = 0; u < NUM; u++) sp_padsynth_destroy(&unit[u]);
-
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
-
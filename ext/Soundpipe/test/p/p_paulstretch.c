@@ -2,34 +2,35 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
-
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
-    uint32_t t, u;
-    SPFLOAT in = 0, out = 0;
-    sp_ftbl *wav;
-
+#include "bench.h"
+
+/* computes the frames for as many output samples as the benchmark, 1
+ * every half window, on noise (the function table loaders are not
+ * built here) */
+int p_paulstretch(sp_bench *bn, sp_data *sp) {
+    uint32_t t, i, u;
+    SPFLOAT *buf;
     sp_paulstretch *unit[NUM];
 
-    sp_ftbl_loadfile(sp, &wav, SAMPDIR "oneart.wav");
-
-    for(u = 0; u < NUM; u++) { 
+    for(u = 0; u < NUM; u++) {
         sp_paulstretch_create(&unit[u]);
-        sp_paulstretch_init(sp, unit[u], wav, 1.0, 10);
+        sp_paulstretch_init(sp, unit[u], NULL, 1.0, 10);
     }
-
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_paulstretch_compute(sp, unit[u], &in, &out);
+    buf = malloc(sizeof(SPFLOAT) * unit[0]->windowsize);
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += unit[0]->half_windowsize) {
+            for(u = 0; u < NUM; u++) {
+                for(i = 0; i < unit[u]->windowsize; i++) {
+                    buf[i] = (SPFLOAT)sp_rand(sp) / SP_RANDMAX - 0.5;
+                }
+                sp_paulstretch_frame(sp, unit[u], buf);
+            }
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_paulstretch_destroy(&unit[u]);
+    free(buf);
 
-    sp_ftbl_destroy(&wav);
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
-
@@ -0,0 +1,30 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_psola(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    SPFLOAT in1[64] = {0}, out1[64];
+    SPFLOAT in2[64] = {0}, out2[64];
+
+    sp_psola *unit[NUM];
+
+    for(u = 0; u < NUM; u++) { 
+        sp_psola_create(&unit[u]);
+        sp_psola_init(sp, unit[u], 80);
+        unit[u]->shift = 7;
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) sp_psola_compute_block(sp, unit[u],
+                    in1, in2, out1, out2, 64);
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_psola_destroy(&unit[u]);
+
+    return SP_OK;
+}
@@ -2,13 +2,9 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_ptrack(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT in = 0, freq = 0, amp = 0;
 
@@ -19,14 +15,15 @@ int main() {
         sp_ptrack_init(sp, unit[u], 512, 20);
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_ptrack_compute(sp, unit[u], &in, 
-                &freq, &amp);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_ptrack_compute(sp, unit[u], &in, 
+                    &freq, &amp);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_ptrack_destroy(&unit[u]);
 
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 
@@ -0,0 +1,30 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_vnoise(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    SPFLOAT out[64];
+
+    sp_vnoise *unit[NUM];
+
+    for(u = 0; u < NUM; u++) { 
+        sp_vnoise_create(&unit[u]);
+        sp_vnoise_init(sp, unit[u]);
+        unit[u]->type = SP_VNOISE_PINK;
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_vnoise_compute_block(sp, unit[u], out, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_vnoise_destroy(&unit[u]);
+
+    return SP_OK;
+}
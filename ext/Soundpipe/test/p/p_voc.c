@@ -3,13 +3,9 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_voc(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT out = 0;
 
@@ -20,13 +16,14 @@ int main() {
         sp_voc_init(sp, unit[u]);
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_voc_compute(sp, unit[u], &out);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_voc_compute(sp, unit[u], &out);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_voc_destroy(&unit[u]);
 
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+int p_vocbank(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u;
+    SPFLOAT car[64], mod[64], out[64];
+
+    sp_vocbank *unit[NUM];
+
+    for(t = 0; t < 64; t++) {
+        car[t] = (SPFLOAT)(t % 16) / 16 - 0.5;
+        mod[t] = (SPFLOAT)(t % 7) / 7 - 0.5;
+    }
+
+    for(u = 0; u < NUM; u++) { 
+        sp_vocbank_create(&unit[u]);
+        sp_vocbank_init(sp, unit[u], 32);
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_vocbank_compute_block(sp, unit[u], car, mod, out, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_vocbank_destroy(&unit[u]);
+
+    return SP_OK;
+}
@@ -0,0 +1,45 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "soundpipe.h"
+#include "config.h"
+#include "bench.h"
+
+#define SIZE 2048
+#define NVOICES 8
+
+int p_wavetable(sp_bench *bn, sp_data *sp) {
+    uint32_t t, u, i;
+    SPFLOAT out[64];
+    SPFLOAT wave[SIZE];
+    uint32_t phs[NVOICES] = {0};
+    SPFLOAT freq[NVOICES], wtpos[NVOICES], amp[NVOICES];
+
+    sp_wavetable *unit[NUM];
+
+    for(i = 0; i < SIZE; i++) wave[i] = 1 - 2.0 * i / SIZE;
+    for(i = 0; i < NVOICES; i++) {
+        freq[i] = 100 * (i + 1);
+        wtpos[i] = 0.3;
+        amp[i] = 0.1;
+    }
+
+    for(u = 0; u < NUM; u++) { 
+        sp_wavetable_create(&unit[u]);
+        sp_wavetable_init(sp, unit[u], SIZE, 2);
+        sp_wavetable_gen(sp, unit[u], 0, wave);
+        sp_wavetable_gen(sp, unit[u], 1, wave);
+    }
+
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t += 64) {
+            for(u = 0; u < NUM; u++) {
+                sp_wavetable_compute(sp, unit[u], NVOICES, phs,
+                    freq, wtpos, amp, out, 64);
+            }
+        }
+    }
+
+    for(u = 0; u < NUM; u++) sp_wavetable_destroy(&unit[u]);
+
+    return SP_OK;
+}
@@ -2,13 +2,9 @@
 #include <stdio.h>
 #include "soundpipe.h"
 #include "config.h"
+#include "bench.h"
 
-int main() {
-    sp_data *sp;
-    sp_create(&sp);
-    sp_srand(sp, 12345);
-    sp->sr = SR;
-    sp->len = sp->sr * LEN;
+int p_zitarev(sp_bench *bn, sp_data *sp) {
     uint32_t t, u;
     SPFLOAT in1 = 0, out1 = 0;
     SPFLOAT in2 = 0, out2 = 0;
@@ -20,14 +16,15 @@ int main() {
         sp_zitarev_init(sp, unit[u]);
     }
 
-    for(t = 0; t < sp->len; t++) {
-        for(u = 0; u < NUM; u++) sp_zitarev_compute(sp, unit[u], 
-                &in1, &in2, &out1, &out2);
+    while(sp_bench_run(bn)) {
+        for(t = 0; t < sp->len; t++) {
+            for(u = 0; u < NUM; u++) sp_zitarev_compute(sp, unit[u], 
+                    &in1, &in2, &out1, &out2);
+        }
     }
 
     for(u = 0; u < NUM; u++) sp_zitarev_destroy(&unit[u]);
 
-    sp_destroy(&sp);
-    return 0;
+    return SP_OK;
 }
 
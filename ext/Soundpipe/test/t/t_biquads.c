@@ -0,0 +1,42 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+typedef struct {
+    sp_biquads *bq;
+    sp_noise *ns;
+} UserData;
+
+int t_biquads(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int fail = 0;
+    UserData ud;
+    SPFLOAT frame[SP_BIQUADS_LANES];
+
+    sp_srand(sp, 12345);
+    sp_biquads_create(&ud.bq);
+    sp_noise_create(&ud.ns);
+
+    sp_biquads_init(sp, ud.bq, 3);
+    sp_biquads_design(sp, ud.bq, 0, 0, SP_BIQUADS_HIGHPASS, 80, 0.707, 0);
+    sp_biquads_design(sp, ud.bq, 1, 0, SP_BIQUADS_PEAK, 1000, 1.5, 9);
+    sp_biquads_design(sp, ud.bq, 2, 0, SP_BIQUADS_HIGHSHELF, 6000, 0.707, -12);
+    sp_noise_init(sp, ud.ns);
+
+    for(n = 0; n < tst->size; n++) {
+        frame[0] = frame[1] = frame[2] = frame[3] = 0;
+        sp_noise_compute(sp, ud.ns, NULL, &frame[0]);
+        sp_biquads_compute(sp, ud.bq, frame, frame);
+        sp_test_add_sample(tst, frame[0]);
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_biquads_destroy(&ud.bq);
+    sp_noise_destroy(&ud.ns);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,90 @@
+#include <math.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define FFTSIZE 1024
+#define NBINS 64
+
+static int gen_ramp(void *data, const sp_cache_key *key, void *ud)
+{
+    SPFLOAT *tbl = data;
+    uint32_t i;
+
+    for(i = 0; i < key->size; i++) tbl[i] = i + key->params[0];
+    (*(int *)ud)++;
+    return SP_OK;
+}
+
+int t_cache(sp_test *tst, sp_data *sp, const char *hash)
+{
+    sp_cache_key key = {SP_CACHE_USER, 16};
+    const SPFLOAT *a, *b, *c;
+    sp_fft fft[2];
+    SPFLOAT buf[FFTSIZE];
+    uint32_t n, i, len;
+    int ngen = 0;
+    int count = sp_cache_count();
+    int fail = 0;
+
+    /* the same key gives the same data, generated once */
+    a = sp_cache_get(&key, 16 * sizeof(SPFLOAT), gen_ramp, &ngen);
+    b = sp_cache_get(&key, 16 * sizeof(SPFLOAT), gen_ramp, &ngen);
+    key.params[0] = 1;
+    c = sp_cache_get(&key, 16 * sizeof(SPFLOAT), gen_ramp, &ngen);
+    if(a != b || a == c || ngen != 2 || a[15] != 15 || c[15] != 16) {
+        fprintf(stderr, "cache: wrong data for the keys\n");
+        fail = 1;
+    }
+    sp_cache_release(a);
+    sp_cache_release(c);
+    if(sp_cache_count() != count + 1) {
+        fprintf(stderr, "cache: entry freed while in use\n");
+        fail = 1;
+    }
+    sp_cache_release(b);
+    if(sp_cache_count() != count) {
+        fprintf(stderr, "cache: entry not freed\n");
+        fail = 1;
+    }
+
+    /* FFTs of the same size share their tables, which outlive the
+     * first of them */
+    sp_fft_init(&fft[0], 10);
+    sp_fft_init(&fft[1], 10);
+    if(fft[0].utbl != fft[1].utbl || fft[0].BRLow != fft[1].BRLow ||
+        fft[0].BRLowCpx != fft[1].BRLowCpx) {
+        fprintf(stderr, "cache: FFT tables not shared\n");
+        fail = 1;
+    }
+    sp_fft_destroy(&fft[0]);
+
+    /* low-pass a saw by zeroing the bins above NBINS */
+    for(n = 0; n < tst->size; n += FFTSIZE) {
+        for(i = 0; i < FFTSIZE; i++) {
+            buf[i] = fmod((n + i) * 220.0 / sp->sr, 1.0) * 2 - 1;
+        }
+        sp_fftr(&fft[1], buf, FFTSIZE);
+        buf[1] = 0;
+        for(i = NBINS; i < FFTSIZE / 2; i++) {
+            buf[2 * i] = 0;
+            buf[2 * i + 1] = 0;
+        }
+        sp_ifftr(&fft[1], buf, FFTSIZE);
+
+        len = tst->size - n < FFTSIZE ? tst->size - n : FFTSIZE;
+        for(i = 0; i < len; i++) sp_test_add_sample(tst, buf[i]);
+    }
+    sp_fft_destroy(&fft[1]);
+
+    if(sp_cache_count() != count) {
+        fprintf(stderr, "cache: FFT tables not freed\n");
+        fail = 1;
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,71 @@
+#include <math.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+/* max errors of the sp_fast_* approximations against libm */
+#define LOG2_MAX_ERR 1e-5
+#define EXP2_MAX_RELERR 5e-7
+#define TANH_MAX_ERR 5e-7
+#define DB_MAX_ERR 1e-4
+
+static int check(const char *name, double err, double max)
+{
+    if(err > max) {
+        fprintf(stderr, "%s: error %g is over %g\n", name, err, max);
+        return 1;
+    }
+    return 0;
+}
+
+int t_fastmath(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int fail = 0;
+    float x;
+    double err, maxerr;
+
+    /* log2 over the whole range of positive normal floats */
+    maxerr = 0;
+    for(x = 1e-37f; x < 1e37f; x *= 1.0001f) {
+        err = fabs(sp_fast_log2(x) - log2(x));
+        if(err > maxerr) maxerr = err;
+    }
+    fail |= check("log2", maxerr, LOG2_MAX_ERR);
+
+    maxerr = 0;
+    for(x = -125; x < 126; x += 0.0001f) {
+        err = fabs(sp_fast_exp2(x) - exp2(x)) / exp2(x);
+        if(err > maxerr) maxerr = err;
+    }
+    fail |= check("exp2", maxerr, EXP2_MAX_RELERR);
+
+    maxerr = 0;
+    for(x = -20; x < 20; x += 0.0001f) {
+        err = fabs(sp_fast_tanh(x) - tanh(x));
+        if(err > maxerr) maxerr = err;
+    }
+    fail |= check("tanh", maxerr, TANH_MAX_ERR);
+
+    /* dB conversions over the range used by dynamics processors */
+    maxerr = 0;
+    for(x = -120; x < 24; x += 0.001f) {
+        err = fabs(sp_fast_lin2db(sp_fast_db2lin(x)) - x);
+        if(err > maxerr) maxerr = err;
+        err = fabs(sp_fast_db2lin(x) - pow(10, x / 20.0)) / pow(10, x / 20.0);
+        if(err > maxerr) maxerr = err;
+    }
+    fail |= check("dB", maxerr, DB_MAX_ERR);
+
+    /* only the error bounds are checked: a hash of the curves would
+     * change with FMA contraction and other compiler flags */
+    for(n = 0; n < tst->size; n++) {
+        sp_test_add_sample(tst, 0);
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
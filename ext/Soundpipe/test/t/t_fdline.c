@@ -0,0 +1,87 @@
+#include <math.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define BLOCK 64
+
+int t_fdline(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n, i;
+    int fail = 0;
+    sp_fdline *dl, *big;
+    sp_noise *ns;
+    SPFLOAT buf[BLOCK], del[BLOCK];
+    SPFLOAT err, maxerr = 0;
+
+    sp_srand(sp, 12345);
+    sp_fdline_create(&dl);
+    sp_fdline_create(&big);
+    sp_noise_create(&ns);
+    sp_fdline_init(sp, dl, 0.1);
+    sp_noise_init(sp, ns);
+
+    /* a sine delayed by a fractional number of samples, processed in
+     * place */
+    for(n = 0; n < 4096; n += BLOCK) {
+        for(i = 0; i < BLOCK; i++) {
+            buf[i] = sin((n + i) * 0.05);
+            del[i] = 100.25;
+        }
+        sp_fdline_compute_block(sp, dl, buf, del, buf, BLOCK);
+        for(i = 0; i < BLOCK && n > 256; i++) {
+            err = fabs(buf[i] - sin((n + i - 100.25) * 0.05));
+            if(err > maxerr) maxerr = err;
+        }
+    }
+    if(maxerr > 1e-4) {
+        fprintf(stderr, "fdline: error %g\n", maxerr);
+        fail = 1;
+    }
+
+    /* a swept delay in a 4 s line, which must be read as finely as a
+     * short one. A low frequency keeps the interpolation error well
+     * below the error of a fraction rounded to 1/64 sample. */
+    sp_fdline_init(sp, big, 4);
+    maxerr = 0;
+    for(n = 0; n < 8192; n += BLOCK) {
+        for(i = 0; i < BLOCK; i++) {
+            buf[i] = sin((n + i) * 0.01);
+            del[i] = 100.3 + (n + i) * 0.0137;
+        }
+        sp_fdline_compute_block(sp, big, buf, del, buf, BLOCK);
+        for(i = 0; i < BLOCK && n > 512; i++) {
+            err = fabs(buf[i] - sin((n + i - del[i]) * 0.01));
+            if(err > maxerr) maxerr = err;
+        }
+    }
+    if(maxerr > 1e-5) {
+        fprintf(stderr, "fdline: error %g with a swept delay\n", maxerr);
+        fail = 1;
+    }
+
+    /* noise through a modulated delay with feedback */
+    sp_fdline_clear(sp, dl);
+    dl->feedback = 0.5;
+    for(n = 0; n < tst->size; n += BLOCK) {
+        for(i = 0; i < BLOCK; i++) {
+            sp_noise_compute(sp, ns, NULL, &buf[i]);
+            if(n > 4410) buf[i] = 0;
+            del[i] = 441 + 200 * sin((n + i) * 0.0005);
+        }
+        sp_fdline_compute_block(sp, dl, buf, del, buf, BLOCK);
+        for(i = 0; i < BLOCK && n + i < tst->size; i++) {
+            sp_test_add_sample(tst, buf[i]);
+        }
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    sp_fdline_destroy(&dl);
+    sp_fdline_destroy(&big);
+    sp_noise_destroy(&ns);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,46 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+typedef struct {
+    sp_mbcomp *mb;
+    sp_noise *ns;
+} UserData;
+
+int t_mbcomp(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int i;
+    int fail = 0;
+    UserData ud;
+    SPFLOAT in = 0, out1 = 0, out2 = 0;
+
+    sp_srand(sp, 12345);
+    sp_mbcomp_create(&ud.mb);
+    sp_noise_create(&ud.ns);
+
+    sp_mbcomp_init(sp, ud.mb);
+    for(i = 0; i < SP_MBCOMP_BANDS; i++) {
+        ud.mb->thresh[i] = -30;
+        ud.mb->ratio[i] = 4;
+        ud.mb->makeup[i] = 6;
+    }
+    sp_noise_init(sp, ud.ns);
+    ud.ns->amp = 0.5;
+
+    for(n = 0; n < tst->size; n++) {
+        in = 0, out1 = 0, out2 = 0;
+        sp_noise_compute(sp, ud.ns, NULL, &in);
+        sp_mbcomp_compute(sp, ud.mb, &in, &in, &out1, &out2);
+        sp_test_add_sample(tst, out1);
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_mbcomp_destroy(&ud.mb);
+    sp_noise_destroy(&ud.ns);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,52 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+typedef struct {
+    sp_oversample *os;
+    sp_dist *dist;
+    sp_osc *osc;
+    sp_ftbl *ft;
+} UserData;
+
+int t_oversample(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int i;
+    int fail = 0;
+    UserData ud;
+    SPFLOAT osc = 0, out = 0;
+    SPFLOAT up[4];
+
+    sp_oversample_create(&ud.os);
+    sp_dist_create(&ud.dist);
+    sp_osc_create(&ud.osc);
+    sp_ftbl_create(sp, &ud.ft, 2048);
+
+    sp_oversample_init(sp, ud.os, 4);
+    sp_dist_init(sp, ud.dist);
+    ud.dist->pregain = 4;
+    sp_gen_sine(sp, ud.ft);
+    sp_osc_init(sp, ud.osc, ud.ft, 0);
+    ud.osc->freq = 3000;
+
+    for(n = 0; n < tst->size; n++) {
+        osc = 0, out = 0;
+        sp_osc_compute(sp, ud.osc, NULL, &osc);
+        sp_oversample_up(sp, ud.os, &osc, up, 1);
+        for(i = 0; i < 4; i++) sp_dist_compute(sp, ud.dist, &up[i], &up[i]);
+        sp_oversample_down(sp, ud.os, up, &out, 1);
+        sp_test_add_sample(tst, out);
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_oversample_destroy(&ud.os);
+    sp_dist_destroy(&ud.dist);
+    sp_osc_destroy(&ud.osc);
+    sp_ftbl_destroy(&ud.ft);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define TBLSIZE 65536
+#define NHARM 32
+
+static void remove_dir(const char *dir)
+{
+    char path[1024];
+    struct dirent *ent;
+    DIR *d = opendir(dir);
+
+    if(d == NULL) return;
+    while((ent = readdir(d)) != NULL) {
+        if(ent->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+int t_padsynth_cache(sp_test *tst, sp_data *sp, const char *hash)
+{
+    char dir[] = "/tmp/sp_padsynth_XXXXXX";
+    SPFLOAT amps[NHARM];
+    sp_padsynth_tbl a, b, c, d;
+    SPFLOAT f = 440.0 * TBLSIZE / sp->sr;
+    SPFLOAT phs = 0, inc, frac;
+    uint32_t n, i;
+    int fail = 0;
+
+    if(mkdtemp(dir) == NULL) {
+        fprintf(stderr, "padsynth_cache: can't create %s\n", dir);
+        return SP_NOT_OK;
+    }
+
+    amps[0] = 0;
+    for(i = 1; i < NHARM; i++) amps[i] = 1.0 / i;
+
+    /* rendered and written on the first load, mapped on the second */
+    sp_padsynth_load(sp, &a, dir, TBLSIZE, amps, NHARM, f, 40);
+    sp_padsynth_load(sp, &b, dir, TBLSIZE, amps, NHARM, f, 40);
+    if(!a.mapped || !b.mapped ||
+            memcmp(a.tbl, b.tbl, sizeof(SPFLOAT) * TBLSIZE)) {
+        fprintf(stderr, "padsynth_cache: table not reused\n");
+        fail = 1;
+    }
+
+    /* the same table is rendered without the cache */
+    sp_padsynth_load(sp, &c, NULL, TBLSIZE, amps, NHARM, f, 40);
+    if(c.mapped || memcmp(a.tbl, c.tbl, sizeof(SPFLOAT) * TBLSIZE)) {
+        fprintf(stderr, "padsynth_cache: tables differ\n");
+        fail = 1;
+    }
+
+    sp_padsynth_load(sp, &d, dir, TBLSIZE, amps, NHARM, f, 80);
+    if(!memcmp(a.tbl, d.tbl, sizeof(SPFLOAT) * TBLSIZE)) {
+        fprintf(stderr, "padsynth_cache: bandwidth ignored\n");
+        fail = 1;
+    }
+
+    /* play the mapped table at 220 Hz */
+    inc = 0.5;
+    for(n = 0; n < tst->size; n++) {
+        i = (uint32_t) phs;
+        frac = phs - i;
+        sp_test_add_sample(tst, b.tbl[i] +
+            (b.tbl[(i + 1) & (TBLSIZE - 1)] - b.tbl[i]) * frac);
+        phs += inc;
+        if(phs >= TBLSIZE) phs -= TBLSIZE;
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    sp_padsynth_unload(&a);
+    sp_padsynth_unload(&b);
+    sp_padsynth_unload(&c);
+    sp_padsynth_unload(&d);
+    remove_dir(dir);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
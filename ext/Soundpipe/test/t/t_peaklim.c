@@ -5,38 +5,52 @@
 
 typedef struct {
     sp_peaklim *peaklim;
-    sp_diskin *diskin;
+    sp_noise *nz;
+    sp_osc *lfo;
+    sp_ftbl *sine;
 } UserData;
 
 int t_peaklim(sp_test *tst, sp_data *sp, const char *hash) 
 {
     uint32_t n;
     int fail = 0;
-    SPFLOAT diskin = 0, peaklim = 0;
+    SPFLOAT noise = 0, lfo = 0, peaklim = 0;
 
     UserData ud;
     sp_srand(sp, 1234567);
 
     sp_peaklim_create(&ud.peaklim);
-    sp_diskin_create(&ud.diskin);
+    sp_noise_create(&ud.nz);
+    sp_osc_create(&ud.lfo);
+    sp_ftbl_create(sp, &ud.sine, 4096);
 
     sp_peaklim_init(sp, ud.peaklim);
     ud.peaklim->atk = 0.1;
     ud.peaklim->rel = 0.1;
     ud.peaklim->thresh = -30;
-    sp_diskin_init(sp, ud.diskin, SAMPDIR "oneart.wav");
+    /* noise swelling from silence to full scale and back, twice a
+     * second, so that the gain goes through attack and release */
+    sp_noise_init(sp, ud.nz);
+    sp_gen_sine(sp, ud.sine);
+    sp_osc_init(sp, ud.lfo, ud.sine, 0);
+    ud.lfo->freq = 2;
+    ud.lfo->amp = 0.5;
 
     for(n = 0; n < tst->size; n++) {
-        diskin = 0; peaklim = 0;
-        sp_diskin_compute(sp, ud.diskin, NULL, &diskin);
-        sp_peaklim_compute(sp, ud.peaklim, &diskin, &peaklim);
+        noise = 0; lfo = 0; peaklim = 0;
+        sp_osc_compute(sp, ud.lfo, NULL, &lfo);
+        ud.nz->amp = 0.5 + lfo;
+        sp_noise_compute(sp, ud.nz, NULL, &noise);
+        sp_peaklim_compute(sp, ud.peaklim, &noise, &peaklim);
         sp_test_add_sample(tst, peaklim);
     }
 
     fail = sp_test_verify(tst, hash);
 
     sp_peaklim_destroy(&ud.peaklim);
-    sp_diskin_destroy(&ud.diskin);
+    sp_noise_destroy(&ud.nz);
+    sp_osc_destroy(&ud.lfo);
+    sp_ftbl_destroy(&ud.sine);
 
     if(fail) return SP_NOT_OK;
     /* fail by default */
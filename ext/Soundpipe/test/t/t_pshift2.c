@@ -0,0 +1,53 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+typedef struct {
+    sp_pshift2 *pshift;
+    sp_noise *nz;
+    sp_osc *osc;
+    sp_ftbl *ft;
+} UserData;
+
+int t_pshift2(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int fail = 0;
+    sp_srand(sp, 1234567);
+    UserData ud;
+
+    SPFLOAT noise = 0, osc = 0, out1 = 0, out2 = 0;
+
+    sp_pshift2_create(&ud.pshift);
+    sp_noise_create(&ud.nz);
+    sp_osc_create(&ud.osc);
+    sp_ftbl_create(sp, &ud.ft, 2048);
+
+    sp_pshift2_init(sp, ud.pshift, 10000);
+    ud.pshift->shift = 7;
+    ud.pshift->window = 500;
+    ud.pshift->xfade = 250;
+    sp_noise_init(sp, ud.nz);
+    sp_gen_sine(sp, ud.ft);
+    sp_osc_init(sp, ud.osc, ud.ft, 0);
+    ud.osc->freq = 440;
+
+    for(n = 0; n < tst->size; n++) {
+        noise = 0, osc = 0, out1 = 0, out2 = 0;
+        sp_noise_compute(sp, ud.nz, NULL, &noise);
+        sp_osc_compute(sp, ud.osc, NULL, &osc);
+        sp_pshift2_compute(sp, ud.pshift, &osc, &noise, &out1, &out2);
+        sp_test_add_sample(tst, out1 + out2);
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_pshift2_destroy(&ud.pshift);
+    sp_noise_destroy(&ud.nz);
+    sp_osc_destroy(&ud.osc);
+    sp_ftbl_destroy(&ud.ft);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,42 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+typedef struct {
+    sp_psola *psola;
+    sp_blsaw *saw;
+} UserData;
+
+int t_psola(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n;
+    int fail = 0;
+    UserData ud;
+
+    SPFLOAT saw = 0, out1 = 0, out2 = 0;
+
+    sp_psola_create(&ud.psola);
+    sp_blsaw_create(&ud.saw);
+
+    sp_psola_init(sp, ud.psola, 80);
+    ud.psola->shift = 7;
+    sp_blsaw_init(sp, ud.saw);
+    *ud.saw->freq = 220;
+    *ud.saw->amp = 0.5;
+
+    for(n = 0; n < tst->size; n++) {
+        saw = 0, out1 = 0, out2 = 0;
+        sp_blsaw_compute(sp, ud.saw, NULL, &saw);
+        sp_psola_compute(sp, ud.psola, &saw, &saw, &out1, &out2);
+        sp_test_add_sample(tst, out1);
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_psola_destroy(&ud.psola);
+    sp_blsaw_destroy(&ud.saw);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,51 @@
+#include <string.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define LEN 1000
+
+int t_vnoise(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n, len;
+    int fail = 0;
+    sp_vnoise *a, *b;
+    SPFLOAT bufa[LEN], bufb[LEN];
+    SPFLOAT out = 0;
+
+    sp_vnoise_create(&a);
+    sp_vnoise_create(&b);
+    sp_vnoise_init(sp, a);
+    sp_vnoise_init(sp, b);
+    a->type = b->type = SP_VNOISE_PINK;
+
+    /* the stream must not depend on the block sizes */
+    sp_vnoise_seed(sp, a, 1234);
+    sp_vnoise_seed(sp, b, 1234);
+    sp_vnoise_compute_block(sp, a, bufa, LEN);
+    for(n = 0, len = 1; n < LEN; n += len, len = len % 13 + 1) {
+        if(n + len > LEN) len = LEN - n;
+        sp_vnoise_compute_block(sp, b, bufb + n, len);
+    }
+    if(memcmp(bufa, bufb, sizeof(bufa))) {
+        fprintf(stderr, "vnoise: blocks of different sizes differ\n");
+        fail = 1;
+    }
+
+    /* white, then pink, then brown */
+    sp_vnoise_seed(sp, a, 5678);
+    for(n = 0; n < tst->size; n++) {
+        a->type = n * 3 / tst->size;
+        sp_vnoise_compute(sp, a, NULL, &out);
+        sp_test_add_sample(tst, out);
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    sp_vnoise_destroy(&a);
+    sp_vnoise_destroy(&b);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,62 @@
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define BLOCK 64
+
+int t_vocbank(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n, i;
+    int fail = 0;
+    sp_vocbank *vb;
+    sp_blsaw *saw;
+    sp_noise *ns;
+    sp_osc *lfo;
+    sp_ftbl *ft;
+    SPFLOAT car[BLOCK], mod[BLOCK], out[BLOCK];
+    SPFLOAT s, amp;
+
+    sp_srand(sp, 12345);
+    sp_vocbank_create(&vb);
+    sp_blsaw_create(&saw);
+    sp_noise_create(&ns);
+    sp_osc_create(&lfo);
+    sp_ftbl_create(sp, &ft, 2048);
+
+    sp_vocbank_init(sp, vb, 32);
+    sp_blsaw_init(sp, saw);
+    *saw->freq = 110;
+    *saw->amp = 0.5;
+    sp_noise_init(sp, ns);
+    sp_gen_sine(sp, ft);
+    sp_osc_init(sp, lfo, ft, 0);
+    lfo->freq = 3;
+
+    /* noise bursts with a moving envelope, vocoding a saw */
+    for(n = 0; n < tst->size; n += BLOCK) {
+        for(i = 0; i < BLOCK; i++) {
+            sp_blsaw_compute(sp, saw, NULL, &car[i]);
+            sp_osc_compute(sp, lfo, NULL, &amp);
+            sp_noise_compute(sp, ns, NULL, &s);
+            mod[i] = s * (0.5 + 0.5 * amp);
+        }
+        /* change the band count half way through */
+        if(n == tst->size / 2 / BLOCK * BLOCK) vb->nbands = 20;
+        sp_vocbank_compute_block(sp, vb, car, mod, out, BLOCK);
+        for(i = 0; i < BLOCK && n + i < tst->size; i++) {
+            sp_test_add_sample(tst, out[i]);
+        }
+    }
+
+    fail = sp_test_verify(tst, hash);
+
+    sp_vocbank_destroy(&vb);
+    sp_blsaw_destroy(&saw);
+    sp_noise_destroy(&ns);
+    sp_osc_destroy(&lfo);
+    sp_ftbl_destroy(&ft);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -0,0 +1,55 @@
+#include <math.h>
+#include "soundpipe.h"
+#include "md5.h"
+#include "tap.h"
+#include "test.h"
+
+#define SIZE 1024
+#define NVOICES 4
+#define BLOCK 64
+
+int t_wavetable(sp_test *tst, sp_data *sp, const char *hash)
+{
+    uint32_t n, i;
+    int fail = 0;
+    sp_wavetable *wt;
+    SPFLOAT wave[SIZE];
+    uint32_t phs[NVOICES] = {0};
+    SPFLOAT freq[NVOICES] = {55, 220, 1760, 7040};
+    SPFLOAT wtpos[NVOICES] = {0, 0.25, 0.5, 1};
+    SPFLOAT amp[NVOICES] = {0.25, 0.25, 0.25, 0.25};
+    SPFLOAT buf[BLOCK];
+
+    sp_wavetable_create(&wt);
+    sp_wavetable_init(sp, wt, SIZE, 2);
+
+    for(i = 0; i < SIZE; i++) wave[i] = 1 - 2.0 * i / SIZE;
+    sp_wavetable_gen(sp, wt, 0, wave);
+    for(i = 0; i < SIZE; i++) wave[i] = i < SIZE / 2 ? 1 : -1;
+    sp_wavetable_gen(sp, wt, 1, wave);
+
+    /* a level must not have harmonics past Nyquist */
+    for(i = 0; i < NVOICES; i++) {
+        if((SIZE >> (sp_wavetable_level(sp, wt, freq[i]) + 1)) * freq[i] >
+            sp->sr / 2) {
+            fprintf(stderr, "level of %g Hz aliases\n", freq[i]);
+            fail = 1;
+        }
+    }
+
+    for(n = 0; n < tst->size; n += BLOCK) {
+        sp_wavetable_compute(sp, wt, NVOICES, phs, freq, wtpos, amp,
+            buf, BLOCK);
+        for(i = 0; i < BLOCK && n + i < tst->size; i++) {
+            sp_test_add_sample(tst, buf[i]);
+        }
+        for(i = 0; i < NVOICES; i++) freq[i] *= 1.0002;
+    }
+
+    fail |= sp_test_verify(tst, hash);
+
+    sp_wavetable_destroy(&wt);
+
+    if(fail) return SP_NOT_OK;
+    else return SP_OK;
+}
@@ -55,6 +55,8 @@ typedef enum PortIndex
 
   /** Outputs. */
   CHORDZ_MIDI_OUT,
+  /** Average DSP load of the plugin. */
+  CHORDZ_DSP_LOAD,
 
   NUM_PORTS,
 } PortIndex;
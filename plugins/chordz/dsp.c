@@ -162,6 +162,10 @@ connect_port (
       self->midi_out =
         (LV2_Atom_Sequence *) data;
       break;
+    case CHORDZ_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
     default:
       break;
     }
@@ -652,10 +656,11 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
 #ifndef RELEASE
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  long int ms = tp.tv_sec * 1000000 + tp.tv_usec;
+  uint64_t start_time = plugin_trace_now ();
 #endif
 
   uint8_t dest[9 * 3];
@@ -714,10 +719,15 @@ run (
     }
 
 #ifndef RELEASE
-  gettimeofday(&tp, NULL);
-  ms = (tp.tv_sec * 1000000 + tp.tv_usec) - ms;
-  printf("us taken %ld\n", ms);
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "us taken %.0f\n",
+    (double) (plugin_trace_now () - start_time) /
+      1000.0);
 #endif
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -732,6 +742,7 @@ cleanup (
   LV2_Handle instance)
 {
   Chordz * self = (Chordz *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
 }
 
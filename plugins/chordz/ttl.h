@@ -175,5 +175,8 @@ print_ttl (FILE * f)
     lv2:symbol \"midi_out\" ;\n\
     lv2:name \"MIDI out\" ;\n\
     rdfs:comment \"MIDI output\" ;\n\
-  ] .\n\n", CHORDZ_MIDI_OUT);
+  ]", CHORDZ_MIDI_OUT);
+
+  plugin_print_dsp_load_ttl (f, CHORDZ_DSP_LOAD);
+  fprintf (f, " .\n\n");
 }
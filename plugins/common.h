@@ -28,19 +28,29 @@
 
 #include PLUGIN_CONFIG
 
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-
-#ifdef TRIAL_VER
 #include <time.h>
+
+#ifdef _WOE32
+#include <malloc.h>
 #endif
 
 #include "lv2/atom/atom.h"
 #include "lv2/atom/forge.h"
+#include "lv2/buf-size/buf-size.h"
 #include "lv2/core/lv2.h"
 #include "lv2/log/log.h"
 #include "lv2/log/logger.h"
 #include "lv2/midi/midi.h"
 #include "lv2/options/options.h"
+#include "lv2/parameters/parameters.h"
+#include "lv2/patch/patch.h"
 #include "lv2/urid/urid.h"
 #include "lv2/time/time.h"
 #include "lv2/worker/worker.h"
@@ -54,12 +64,23 @@ typedef struct PluginUris
   LV2_URID atom_Double;
   LV2_URID atom_Int;
   LV2_URID atom_Long;
+  LV2_URID atom_URID;
+  LV2_URID bufsz_maxBlockLength;
+  LV2_URID bufsz_nominalBlockLength;
+  LV2_URID dsp_load;
+  LV2_URID dsp_load_average;
+  LV2_URID dsp_load_peak;
+  LV2_URID dsp_load_samples_per_sec;
   LV2_URID log_Entry;
   LV2_URID log_Error;
   LV2_URID log_Note;
   LV2_URID log_Trace;
   LV2_URID log_Warning;
   LV2_URID midi_MidiEvent;
+  LV2_URID param_sampleRate;
+  LV2_URID patch_Set;
+  LV2_URID patch_property;
+  LV2_URID patch_value;
   LV2_URID time_Position;
   LV2_URID time_bar;
   LV2_URID time_barBeat;
@@ -70,6 +91,343 @@ typedef struct PluginUris
 
 } PluginUris;
 
+/** Number of records in the trace ring (a power
+ * of 2). */
+#define PLUGIN_TRACE_SIZE 256
+
+/** Max number of arguments of a trace record. */
+#define PLUGIN_TRACE_MAX_ARGS 3
+
+/** Interval at which the trace thread forwards
+ * records, in ms. */
+#define PLUGIN_TRACE_INTERVAL_MS 50
+
+/**
+ * Environment variable with the path of a file to
+ * write trace records to instead of the log.
+ *
+ * Release builds only trace when it is set.
+ */
+#define PLUGIN_TRACE_FILE_ENV "ZPLUGINS_TRACE_FILE"
+
+/**
+ * A log message or measurement pushed from the
+ * audio thread.
+ *
+ * Formatting is left to the trace thread, so the
+ * record only keeps the format and its arguments.
+ */
+typedef struct PluginTraceRecord
+{
+  /** Time of the push, from plugin_trace_now(). */
+  uint64_t        time;
+
+  /** Log level, one of the log_* URIDs. */
+  LV2_URID        level;
+
+  /** printf-style format. Must be a string literal
+   * and only take doubles (%f, %g, ...). */
+  const char *    fmt;
+
+  double          args[PLUGIN_TRACE_MAX_ARGS];
+} PluginTraceRecord;
+
+struct PluginCommon;
+
+/**
+ * Lock-free single-producer, single-consumer ring
+ * of trace records.
+ *
+ * The audio thread pushes with plugin_trace() and
+ * the trace thread forwards the records to the
+ * LV2 log, or to the file in PLUGIN_TRACE_FILE_ENV.
+ */
+typedef struct PluginTrace
+{
+  PluginTraceRecord records[PLUGIN_TRACE_SIZE];
+
+  /** Next record to write, only written by the
+   * audio thread. */
+  atomic_uint     write_idx;
+
+  /** Next record to read, only written by the
+   * trace thread. */
+  atomic_uint     read_idx;
+
+  /** Records dropped because the ring was full. */
+  atomic_uint     num_dropped;
+
+  /** Time of the first record, for printing
+   * relative times. */
+  uint64_t        start_time;
+
+  /** Whether tracing is on for this instance.
+   * Pushes are ignored otherwise. */
+  int             enabled;
+
+  /** Next instance forwarded by the trace
+   * thread. */
+  struct PluginCommon * next;
+} PluginTrace;
+
+/**
+ * Trace thread and file shared by all the instances
+ * of the plugin.
+ */
+typedef struct PluginTraceShared
+{
+  /** Protects everything below except stop. */
+  pthread_mutex_t lock;
+
+  /** Instances with tracing on. */
+  struct PluginCommon * instances;
+
+  /** Number of instances with tracing on. The
+   * first one starts the thread and the last one
+   * stops it. */
+  int             num_instances;
+
+  /** Whether the thread was started and must be
+   * joined. */
+  int             thread_running;
+
+  /** Non-zero to stop the trace thread. */
+  atomic_int      stop;
+
+  pthread_t       thread;
+
+  /** File from PLUGIN_TRACE_FILE_ENV, if any. */
+  FILE *          file;
+} PluginTraceShared;
+
+static inline PluginTraceShared *
+plugin_trace_get_shared (void)
+{
+  static PluginTraceShared shared = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+  };
+  return &shared;
+}
+
+/**
+ * Returns the time in ns from a monotonic clock.
+ *
+ * This is a vDSO call on Linux, so it is safe to
+ * use in the audio thread.
+ */
+static inline uint64_t
+plugin_trace_now (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return
+    (uint64_t) ts.tv_sec * 1000000000ull +
+    (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * Pushes a record to the trace ring.
+ *
+ * RT-safe. Must only be called from the audio
+ * threading class (run(), activate(), ...). If the
+ * ring is full the record is dropped and counted.
+ *
+ * @param level One of the log_* URIDs.
+ * @param fmt A string literal whose conversions
+ *   only take doubles.
+ */
+static inline void
+plugin_trace_push (
+  PluginTrace * self,
+  LV2_URID      level,
+  const char *  fmt,
+  double        arg0,
+  double        arg1,
+  double        arg2)
+{
+  if (!self->enabled)
+    return;
+
+  unsigned int w =
+    atomic_load_explicit (
+      &self->write_idx, memory_order_relaxed);
+  unsigned int r =
+    atomic_load_explicit (
+      &self->read_idx, memory_order_acquire);
+  if (w - r >= PLUGIN_TRACE_SIZE)
+    {
+      atomic_fetch_add_explicit (
+        &self->num_dropped, 1,
+        memory_order_relaxed);
+      return;
+    }
+
+  PluginTraceRecord * rec =
+    &self->records[w & (PLUGIN_TRACE_SIZE - 1)];
+  rec->time = plugin_trace_now ();
+  rec->level = level;
+  rec->fmt = fmt;
+  rec->args[0] = arg0;
+  rec->args[1] = arg1;
+  rec->args[2] = arg2;
+  atomic_store_explicit (
+    &self->write_idx, w + 1, memory_order_release);
+}
+
+/** Time constant of the average DSP load, in
+ * seconds. */
+#define PLUGIN_LOAD_AVERAGE_TIME 1.f
+
+/** Interval between DSP load notifications, in
+ * seconds. */
+#define PLUGIN_LOAD_NOTIFY_INTERVAL 0.5
+
+/**
+ * DSP load of a plugin instance.
+ *
+ * The load is the time spent in run() divided by
+ * the duration of the block, so 1 means the
+ * plugin alone takes the whole budget.
+ */
+typedef struct PluginLoad
+{
+  /** Start time of the current run(). */
+  uint64_t        run_start;
+
+  /** Average load over about
+   * PLUGIN_LOAD_AVERAGE_TIME. */
+  float           average;
+
+  /** Max load since the last notification. */
+  float           peak;
+
+  /** Samples processed per second spent in run(),
+   * over the last notification interval. */
+  float           samples_per_sec;
+
+  /** Time spent in run() and samples processed
+   * since the last notification. */
+  uint64_t        interval_time;
+  uint32_t        interval_samples;
+} PluginLoad;
+
+/** Max number of parameters of a plugin. */
+#define PLUGIN_MAX_PARAMS 64
+
+/**
+ * Control input port that can also be set with
+ * timestamped patch:Set events on the control
+ * port, for sample-accurate automation.
+ *
+ * The parameter URI is the plugin URI, "#" and the
+ * port symbol.
+ */
+typedef struct PluginParamInfo
+{
+  /** Port index. */
+  uint32_t        port;
+
+  /** Port symbol. */
+  const char *    symbol;
+
+  /** Label shown by hosts. */
+  const char *    name;
+
+  float           minimum;
+  float           maximum;
+} PluginParamInfo;
+
+/**
+ * Value of a parameter.
+ */
+typedef struct PluginParam
+{
+  /** Port index. */
+  uint32_t        port;
+
+  /** Parameter URI. */
+  LV2_URID        uri;
+
+  float           minimum;
+  float           maximum;
+
+  /** Port buffer given by the host, or NULL. */
+  const float *   port_data;
+
+  /** Port value when it was last applied, to only
+   * apply it again when the host changes it. */
+  float           last_port_value;
+
+  /** Whether the port value must be applied at the
+   * next block, after connecting the port. */
+  int             port_changed;
+
+  /** Current value, which the plugin reads instead
+   * of the port. */
+  float           value;
+} PluginParam;
+
+/** Duration of the crossfade when the plugin is
+ * bypassed or enabled, in seconds. */
+#define PLUGIN_BYPASS_FADE_TIME 0.005f
+
+/**
+ * Bypass driven by the lv2:enabled port.
+ *
+ * When the port goes off, the output crossfades to
+ * the input over PLUGIN_BYPASS_FADE_TIME, then the
+ * input is copied to the output without running
+ * the DSP. The state of the DSP is frozen while
+ * bypassed, or cleared before fading back in if
+ * the plugin gives a reset function.
+ *
+ * Plugins that report latency set it up with
+ * plugin_bypass_init_latency() so that the input
+ * passed through is delayed like the processed
+ * signal.
+ */
+typedef struct PluginBypass
+{
+  /** Enabled port, or NULL if not connected. */
+  const float *   enabled;
+
+  /** Gain of the processed signal, 1 when enabled
+   * and 0 when bypassed. */
+  float           gain;
+
+  /** Change of the gain per sample while
+   * fading. */
+  float           step;
+
+  /** Whether the current block is crossfaded. */
+  int             fading;
+
+  /** Number of channels passed through. */
+  int             num_channels;
+
+  /** Copy of the input while fading, since the
+   * host may process in place. */
+  float *         dry;
+  size_t          dry_stride;
+
+  /** Delay lines of the input, one after the
+   * other, or NULL if the plugin has no
+   * latency. */
+  float *         delay;
+  uint32_t        delay_mask;
+  uint32_t        delay_pos;
+
+  /** Latency of the plugin, by which the input is
+   * delayed. Set before plugin_bypass_begin(). */
+  uint32_t        latency;
+
+  /** Clears the state of the DSP before fading
+   * back in, or NULL to keep it. Must be
+   * RT-safe. */
+  void (*reset) (void * user_data);
+  void *          reset_data;
+} PluginBypass;
+
 /**
  * Group of variables needed by all plugins and their
  * UIs.
@@ -99,6 +457,50 @@ typedef struct PluginCommon
   /** Plugin samplerate. */
   double          samplerate;
 
+  /** Max number of samples per run(), from
+   * bufsz:maxBlockLength, or
+   * PLUGIN_DEFAULT_BLOCK_LENGTH if the host does
+   * not give one. */
+  uint32_t        max_block_length;
+
+  /** Usual number of samples per run(), from
+   * bufsz:nominalBlockLength, or 0 if unknown. */
+  uint32_t        nominal_block_length;
+
+  /** Scratch buffers of max_block_length floats
+   * each, allocated in one block by
+   * plugin_common_alloc_scratch(). */
+  float *         scratch;
+
+  /** Number of scratch buffers. */
+  int             num_scratch_bufs;
+
+  /** Distance between 2 scratch buffers, in
+   * floats. */
+  size_t          scratch_stride;
+
+  /** Trace ring, for logging from run(). */
+  PluginTrace     trace;
+
+  /** DSP load of this instance. */
+  PluginLoad      load;
+
+  /** DSP load output port, or NULL if not
+   * connected. */
+  float *         dsp_load;
+
+  /** Sequence opened in the notify port by
+   * plugin_run_begin(). */
+  LV2_Atom_Forge_Frame notify_frame;
+  int             notify_open;
+
+  /** Parameters, set up by plugin_params_init(). */
+  PluginParam     params[PLUGIN_MAX_PARAMS];
+  int             num_params;
+
+  /** Bypass, set up by plugin_bypass_init(). */
+  PluginBypass    bypass;
+
 #ifdef TRIAL_VER
   clock_t         instantiation_time;
 #endif
@@ -118,6 +520,61 @@ get_time_since_instantiation (
 }
 #endif
 
+/**
+ * Compiles the function for AVX-512, AVX2 and the
+ * baseline instruction set.
+ *
+ * The variant matching the CPU is resolved once when
+ * the plugin library is loaded, so hot loops can use
+ * wider vectors without raising the minimum CPU
+ * requirements of the release build.
+ */
+#ifdef HAVE_TARGET_CLONES
+#define TARGET_CLONES \
+  __attribute__ (( \
+    target_clones ("avx512f", "avx2", "default")))
+#else
+#define TARGET_CLONES
+#endif
+
+/**
+ * Allocates zeroed memory aligned to the given
+ * alignment (a power of 2).
+ *
+ * Used for plugin structs that contain arrays
+ * processed with SIMD instructions.
+ *
+ * Must be freed with plugin_aligned_free().
+ */
+static inline void *
+plugin_aligned_calloc (
+  size_t alignment,
+  size_t size)
+{
+  void * ptr = NULL;
+#ifdef _WOE32
+  ptr = _aligned_malloc (size, alignment);
+#else
+  if (posix_memalign (&ptr, alignment, size))
+    ptr = NULL;
+#endif
+  if (ptr)
+    memset (ptr, 0, size);
+
+  return ptr;
+}
+
+static inline void
+plugin_aligned_free (
+  void * ptr)
+{
+#ifdef _WOE32
+  _aligned_free (ptr);
+#else
+  free (ptr);
+#endif
+}
+
 static inline void
 map_common_uris (
   LV2_URID_Map* map,
@@ -133,13 +590,22 @@ map_common_uris (
   MAP (atom_Double, LV2_ATOM__Double);
   MAP (atom_Int, LV2_ATOM__Int);
   MAP (atom_Long, LV2_ATOM__Long);
+  MAP (atom_URID, LV2_ATOM__URID);
   MAP (atom_eventTransfer, LV2_ATOM__eventTransfer);
+  MAP (bufsz_maxBlockLength, LV2_BUF_SIZE__maxBlockLength);
+  MAP (
+    bufsz_nominalBlockLength,
+    LV2_BUF_SIZE__nominalBlockLength);
   MAP (log_Entry, LV2_LOG__Entry);
   MAP (log_Error, LV2_LOG__Error);
   MAP (log_Note, LV2_LOG__Note);
   MAP (log_Trace, LV2_LOG__Trace);
   MAP (log_Warning, LV2_LOG__Warning);
   MAP (midi_MidiEvent, LV2_MIDI__MidiEvent);
+  MAP (param_sampleRate, LV2_PARAMETERS__sampleRate);
+  MAP (patch_Set, LV2_PATCH__Set);
+  MAP (patch_property, LV2_PATCH__property);
+  MAP (patch_value, LV2_PATCH__value);
   MAP (time_Position, LV2_TIME__Position);
   MAP (time_bar, LV2_TIME__bar);
   MAP (time_barBeat, LV2_TIME__barBeat);
@@ -148,69 +614,1401 @@ map_common_uris (
   MAP (time_frame, LV2_TIME__frame);
   MAP (time_speed, LV2_TIME__speed);
 
+  /* custom URIs */
+  MAP (dsp_load, PROJECT_URI "#dsp_load");
+  MAP (
+    dsp_load_average, PROJECT_URI "#dsp_load_average");
+  MAP (dsp_load_peak, PROJECT_URI "#dsp_load_peak");
+  MAP (
+    dsp_load_samples_per_sec,
+    PROJECT_URI "#dsp_load_samples_per_sec");
+
 #undef MAP
 }
 
+typedef enum SyncRate
+{
+  SYNC_1_128,
+  SYNC_1_64,
+  SYNC_1_32,
+  SYNC_1_16,
+  SYNC_1_8,
+  SYNC_1_4,
+  SYNC_1_2,
+  SYNC_1_1,
+  SYNC_2_1,
+  SYNC_4_1,
+  SYNC_8_1,
+  SYNC_16_1,
+  SYNC_32_1,
+  SYNC_64_1,
+  SYNC_128_1,
+  NUM_SYNC_RATES,
+} SyncRate;
+
+typedef enum SyncRateType
+{
+  SYNC_TYPE_NORMAL,
+  SYNC_TYPE_DOTTED,
+  SYNC_TYPE_TRIPLET,
+  NUM_SYNC_RATE_TYPES,
+} SyncRateType;
+
 /**
- * @param with_worker 1 to add the worker feature.
- *
- * @return Non-zero on fail.
+ * Returns the length of the given sync rate in
+ * whole notes.
  */
-static inline int
-plugin_common_instantiate (
-  PluginCommon *              self,
-  const LV2_Feature * const * features,
-  int                         with_worker)
+static inline float
+sync_rate_to_float (
+  SyncRate     rate,
+  SyncRateType type)
 {
-#ifdef TRIAL_VER
-  self->instantiation_time = clock ();
+  float r = 0.01f;
+  switch (rate)
+    {
+    case SYNC_1_128:
+      r = 1.f / 128.f;
+      break;
+    case SYNC_1_64:
+      r = 1.f / 64.f;
+      break;
+    case SYNC_1_32:
+      r = 1.f / 32.f;
+      break;
+    case SYNC_1_16:
+      r = 1.f / 16.f;
+      break;
+    case SYNC_1_8:
+      r = 1.f / 8.f;
+      break;
+    case SYNC_1_4:
+      r = 1.f / 4.f;
+      break;
+    case SYNC_1_2:
+      r = 1.f / 2.f;
+      break;
+    case SYNC_1_1:
+      r = 1.f;
+      break;
+    case SYNC_2_1:
+      r = 2.f;
+      break;
+    case SYNC_4_1:
+      r = 4.f;
+      break;
+    case SYNC_8_1:
+      r = 8.f;
+      break;
+    case SYNC_16_1:
+      r = 16.f;
+      break;
+    case SYNC_32_1:
+      r = 32.f;
+      break;
+    case SYNC_64_1:
+      r = 64.f;
+      break;
+    case SYNC_128_1:
+      r = 128.f;
+      break;
+    default:
+      break;
+    }
+
+  switch (type)
+    {
+    case SYNC_TYPE_NORMAL:
+      break;
+    case SYNC_TYPE_DOTTED:
+      r *= 1.5f;
+      break;
+    case SYNC_TYPE_TRIPLET:
+      r *= (2.f / 3.f);
+      break;
+    default:
+      break;
+    }
+
+  return r;
+}
+
+typedef struct HostPosition
+{
+  float     bpm;
+
+  /** Current global frame. */
+  long      frame;
+
+  /** Transport speed (0.0 is stopped, 1.0 is
+   * normal playback, -1.0 is reverse playback,
+   * etc.). */
+  float     speed;
+
+  int       beat_unit;
+} HostPosition;
+
+/**
+ * Updates the position inside HostPosition with
+ * the given time_Position atom object.
+ */
+static inline void
+plugin_update_host_position (
+  PluginUris *            uris,
+  HostPosition *          host_pos,
+  const LV2_Atom_Object * obj)
+{
+  /* Received new transport position/speed */
+  LV2_Atom *beat = NULL,
+           *bpm = NULL,
+           *beat_unit = NULL,
+           *speed = NULL,
+           *frame = NULL;
+  lv2_atom_object_get (
+    obj, uris->time_barBeat, &beat,
+    uris->time_beatUnit, &beat_unit,
+    uris->time_beatsPerMinute, &bpm,
+    uris->time_frame, &frame,
+    uris->time_speed, &speed, NULL);
+  if (bpm && bpm->type == uris->atom_Float)
+    {
+      /* Tempo changed, update BPM */
+      host_pos->bpm = ((LV2_Atom_Float*)bpm)->body;
+     }
+  if (speed && speed->type == uris->atom_Float)
+    {
+      /* Speed changed, e.g. 0 (stop) to 1 (play) */
+      host_pos->speed =
+        ((LV2_Atom_Float *) speed)->body;
+    }
+  if (beat_unit && beat_unit->type == uris->atom_Int)
+    {
+      host_pos->beat_unit =
+        ((LV2_Atom_Int *) beat_unit)->body;
+    }
+  if (frame && frame->type == uris->atom_Long)
+    {
+      host_pos->frame =
+        ((LV2_Atom_Int *) frame)->body;
+    }
+  if (beat && beat->type == uris->atom_Float)
+    {
+      /*const float bar_beats =*/
+        /*((LV2_Atom_Float *) beat)->body;*/
+      /*self->beat_offset = fmodf (bar_beats, 1.f);*/
+    }
+}
+
+/**
+ * Pushes a record to the trace ring of the given
+ * PluginCommon, with up to PLUGIN_TRACE_MAX_ARGS
+ * double arguments.
+ *
+ * Use instead of printf() and lv2_log_*() in
+ * run().
+ */
+#define plugin_trace(pl_common,lvl,fmt,...) \
+  plugin_trace_push_va ( \
+    &(pl_common)->trace, \
+    (pl_common)->uris.log_##lvl, fmt, \
+    ##__VA_ARGS__, 0.0, 0.0, 0.0)
+
+#define plugin_trace_push_va(trace,lvl,fmt,a0,a1,a2,...) \
+  plugin_trace_push ( \
+    trace, lvl, fmt, (double) (a0), (double) (a1), \
+    (double) (a2))
+
+#if defined (__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
 #endif
 
-#define HAVE_FEATURE(x) \
-  (!strcmp(features[i]->URI, x))
+static inline int
+plugin_trace_log (
+  PluginCommon * self,
+  LV2_URID       level,
+  const char *   fmt,
+  ...)
+{
+  va_list args;
+  va_start (args, fmt);
+  int ret =
+    lv2_log_vprintf (&self->logger, level, fmt, args);
+  va_end (args);
+  return ret;
+}
 
-  for (int i = 0; features[i]; ++i)
+/**
+ * Forwards the pushed records to the log or the
+ * trace file.
+ *
+ * Not RT-safe. Called with the lock of
+ * PluginTraceShared held.
+ */
+static inline void
+plugin_trace_flush (
+  PluginCommon * self)
+{
+  PluginTrace * trace = &self->trace;
+  FILE * file = plugin_trace_get_shared ()->file;
+  unsigned int r =
+    atomic_load_explicit (
+      &trace->read_idx, memory_order_relaxed);
+  unsigned int w =
+    atomic_load_explicit (
+      &trace->write_idx, memory_order_acquire);
+  for (; r != w; r++)
     {
-      if (HAVE_FEATURE (LV2_URID__map))
+      const PluginTraceRecord * rec =
+        &trace->records[r & (PLUGIN_TRACE_SIZE - 1)];
+      if (!trace->start_time)
+        trace->start_time = rec->time;
+
+      char msg[512];
+      snprintf (
+        msg, sizeof (msg), rec->fmt,
+        rec->args[0], rec->args[1], rec->args[2]);
+      double ms =
+        (double) (rec->time - trace->start_time) /
+        1000000.0;
+      if (file)
         {
-          self->map =
-            (LV2_URID_Map*) features[i]->data;
+          fprintf (
+            file, "[%s %.3f] %s",
+            PLUGIN_NAME, ms, msg);
         }
-      else if (HAVE_FEATURE (LV2_LOG__log))
+      else
         {
-          self->log =
-            (LV2_Log_Log *) features[i]->data;
+          plugin_trace_log (
+            self, rec->level, "[%.3f] %s", ms, msg);
         }
-      else if (HAVE_FEATURE (LV2_OPTIONS__options))
+    }
+  atomic_store_explicit (
+    &trace->read_idx, r, memory_order_release);
+
+  unsigned int dropped =
+    atomic_exchange_explicit (
+      &trace->num_dropped, 0,
+      memory_order_relaxed);
+  if (dropped)
+    {
+      if (file)
         {
-          self->options =
-            (LV2_Options_Option*) features[i]->data;
+          fprintf (
+            file,
+            "[%s] %u trace records dropped\n",
+            PLUGIN_NAME, dropped);
         }
-
-      if (with_worker)
+      else
         {
-          if (HAVE_FEATURE (LV2_WORKER__schedule))
-            {
-              self->schedule =
-                (LV2_Worker_Schedule *) features[i]->data;
-            }
+          lv2_log_warning (
+            &self->logger,
+            "%u trace records dropped\n", dropped);
         }
     }
-#undef HAVE_FEATURE
+  if (file)
+    fflush (file);
+}
 
-  if (!self->map)
+#if defined (__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * Opens the file in PLUGIN_TRACE_FILE_ENV, if set
+ * and not open yet.
+ *
+ * Called with the lock held.
+ */
+static inline void
+plugin_trace_open_file (
+  PluginTraceShared * shared)
+{
+  const char * path = getenv (PLUGIN_TRACE_FILE_ENV);
+  if (!shared->file && path && *path)
+    shared->file = fopen (path, "a");
+}
+
+static inline void *
+plugin_trace_thread (
+  void * data)
+{
+  PluginTraceShared * shared =
+    (PluginTraceShared *) data;
+  const struct timespec interval = {
+    0, PLUGIN_TRACE_INTERVAL_MS * 1000000L };
+
+  while (!atomic_load (&shared->stop))
     {
-      lv2_log_error (
-        &self->logger, "Missing feature urid:map\n");
-      return -1;
+      nanosleep (&interval, NULL);
+
+      /* plugin_trace_cleanup() joins this thread
+       * with the lock held, so skip the cycle
+       * instead of waiting for it */
+      if (pthread_mutex_trylock (&shared->lock))
+        continue;
+      for (PluginCommon * inst = shared->instances;
+           inst; inst = inst->trace.next)
+        {
+          plugin_trace_flush (inst);
+        }
+      pthread_mutex_unlock (&shared->lock);
     }
-  else if (with_worker && !self->schedule)
+
+  return NULL;
+}
+
+/**
+ * Turns tracing on for the instance in debug
+ * builds, or when PLUGIN_TRACE_FILE_ENV is set.
+ *
+ * The first instance opens the trace file and
+ * starts the trace thread, so plugin_trace() only
+ * writes to the ring. Call after the logger is set
+ * up.
+ */
+static inline void
+plugin_trace_init (
+  PluginCommon * self)
+{
+#ifdef RELEASE
+  const char * path = getenv (PLUGIN_TRACE_FILE_ENV);
+  if (!path || !*path)
+    return;
+#endif
+
+  PluginTraceShared * shared =
+    plugin_trace_get_shared ();
+  pthread_mutex_lock (&shared->lock);
+  if (shared->num_instances++ == 0)
     {
-      lv2_log_error (
-        &self->logger,
-        "Missing feature work:schedule\n");
-      return -1;
+      plugin_trace_open_file (shared);
+      atomic_store (&shared->stop, 0);
+      shared->thread_running =
+        !pthread_create (
+          &shared->thread, NULL,
+          plugin_trace_thread, shared);
     }
+  self->trace.enabled = 1;
+  self->trace.next = shared->instances;
+  shared->instances = self;
+  pthread_mutex_unlock (&shared->lock);
+}
+
+/**
+ * Forwards the remaining records of the instance
+ * and stops the trace thread after the last
+ * instance.
+ */
+static inline void
+plugin_trace_cleanup (
+  PluginCommon * self)
+{
+  if (!self->trace.enabled)
+    return;
+
+  PluginTraceShared * shared =
+    plugin_trace_get_shared ();
+  pthread_mutex_lock (&shared->lock);
+  for (PluginCommon ** inst = &shared->instances;
+       *inst; inst = &(*inst)->trace.next)
+    {
+      if (*inst == self)
+        {
+          *inst = self->trace.next;
+          break;
+        }
+    }
+  plugin_trace_flush (self);
+  self->trace.enabled = 0;
+
+  if (--shared->num_instances == 0)
+    {
+      if (shared->thread_running)
+        {
+          atomic_store (&shared->stop, 1);
+          pthread_join (shared->thread, NULL);
+          shared->thread_running = 0;
+        }
+      if (shared->file)
+        {
+          fclose (shared->file);
+          shared->file = NULL;
+        }
+    }
+  pthread_mutex_unlock (&shared->lock);
+}
+
+/**
+ * To be called at the start of run().
+ *
+ * Starts measuring the DSP load and opens a
+ * sequence in the notify port, which the plugin
+ * can append events to with the forge.
+ */
+static inline void
+plugin_run_begin (
+  PluginCommon *      self,
+  LV2_Atom_Sequence * notify)
+{
+  self->load.run_start = plugin_trace_now ();
+
+  self->notify_open = 0;
+  if (notify)
+    {
+      lv2_atom_forge_set_buffer (
+        &self->forge, (uint8_t *) notify,
+        notify->atom.size);
+      self->notify_open =
+        lv2_atom_forge_sequence_head (
+          &self->forge, &self->notify_frame, 0) != 0;
+    }
+}
+
+/**
+ * To be called at the end of run().
+ *
+ * Updates the DSP load and its output port, sends
+ * it to the notify port every
+ * PLUGIN_LOAD_NOTIFY_INTERVAL and closes the
+ * sequence.
+ */
+static inline void
+plugin_run_end (
+  PluginCommon * self,
+  uint32_t       n_samples)
+{
+  PluginLoad * load = &self->load;
+  uint64_t elapsed =
+    plugin_trace_now () - load->run_start;
+
+  if (n_samples > 0 && self->samplerate > 0.0)
+    {
+      float block_time =
+        (float) n_samples / (float) self->samplerate;
+      float cur =
+        ((float) elapsed * 1e-9f) / block_time;
+      /* close to 1 - exp (-block_time / average
+       * time) without needing libm */
+      float coeff =
+        block_time /
+        (block_time + PLUGIN_LOAD_AVERAGE_TIME);
+      load->average += (cur - load->average) * coeff;
+      if (cur > load->peak)
+        load->peak = cur;
+      load->interval_time += elapsed;
+      load->interval_samples += n_samples;
+    }
+
+  if (self->dsp_load)
+    *self->dsp_load = load->average;
+
+  if (load->interval_samples >=
+        PLUGIN_LOAD_NOTIFY_INTERVAL * self->samplerate)
+    {
+      load->samples_per_sec =
+        load->interval_time > 0 ?
+          (float)
+          ((double) load->interval_samples * 1e9 /
+           (double) load->interval_time) :
+          0.f;
+
+      if (self->notify_open)
+        {
+          LV2_Atom_Forge * forge = &self->forge;
+          PluginUris * uris = &self->uris;
+          LV2_Atom_Forge_Frame frame;
+          lv2_atom_forge_frame_time (
+            forge, n_samples > 0 ? n_samples - 1 : 0);
+          lv2_atom_forge_object (
+            forge, &frame, 0, uris->dsp_load);
+          lv2_atom_forge_key (
+            forge, uris->dsp_load_average);
+          lv2_atom_forge_float (forge, load->average);
+          lv2_atom_forge_key (
+            forge, uris->dsp_load_peak);
+          lv2_atom_forge_float (forge, load->peak);
+          lv2_atom_forge_key (
+            forge, uris->dsp_load_samples_per_sec);
+          lv2_atom_forge_float (
+            forge, load->samples_per_sec);
+          lv2_atom_forge_pop (forge, &frame);
+        }
+
+      load->peak = 0.f;
+      load->interval_time = 0;
+      load->interval_samples = 0;
+    }
+
+  if (self->notify_open)
+    {
+      lv2_atom_forge_pop (
+        &self->forge, &self->notify_frame);
+      self->notify_open = 0;
+    }
+}
+
+/**
+ * Prints the TTL of the DSP load output port.
+ */
+static inline void
+plugin_print_dsp_load_ttl (
+  FILE * f,
+  int    index)
+{
+  fprintf (f,
+" , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"dsp_load\" ;\n\
+    lv2:name \"DSP Load\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum 0.000000 ;\n\
+    lv2:maximum 1.000000 ;\n\
+    lv2:portProperty lv2:connectionOptional ;\n\
+    lv2:portProperty pprop:notOnGUI ;\n\
+    rdfs:comment \"Average time spent processing, relative to the block duration\" ;\n\
+  ]", index);
+}
+
+/**
+ * Sets up the parameters of the plugin.
+ *
+ * To be called in instantiate(), before any port
+ * is connected.
+ */
+static inline void
+plugin_params_init (
+  PluginCommon *          self,
+  const PluginParamInfo * infos,
+  int                     num_infos)
+{
+  self->num_params = 0;
+  for (int i = 0;
+       i < num_infos && i < PLUGIN_MAX_PARAMS; i++)
+    {
+      PluginParam * param = &self->params[i];
+      char uri[600];
+      snprintf (
+        uri, sizeof (uri), "%s#%s", PLUGIN_URI,
+        infos[i].symbol);
+      param->port = infos[i].port;
+      param->uri =
+        self->map->map (self->map->handle, uri);
+      param->minimum = infos[i].minimum;
+      param->maximum = infos[i].maximum;
+      param->port_data = NULL;
+      param->port_changed = 1;
+      param->value = infos[i].minimum;
+      self->num_params++;
+    }
+}
+
+/**
+ * To be called in connect_port().
+ *
+ * @return The buffer the plugin should read: the
+ *   value of the parameter if the port is a
+ *   parameter, otherwise @p data.
+ */
+static inline const float *
+plugin_params_connect (
+  PluginCommon * self,
+  uint32_t       port,
+  void *         data)
+{
+  for (int i = 0; i < self->num_params; i++)
+    {
+      PluginParam * param = &self->params[i];
+      if (param->port != port)
+        continue;
+
+      if (param->port_data != data)
+        {
+          param->port_data = (const float *) data;
+          param->port_changed = 1;
+        }
+      return &param->value;
+    }
+
+  return (const float *) data;
+}
+
+/**
+ * Applies the port values that changed since the
+ * last block.
+ *
+ * To be called at the start of run(), before
+ * reading the control port.
+ */
+static inline void
+plugin_params_begin (
+  PluginCommon * self)
+{
+  for (int i = 0; i < self->num_params; i++)
+    {
+      PluginParam * param = &self->params[i];
+      if (!param->port_data)
+        continue;
+
+      float val = *param->port_data;
+      if (param->port_changed ||
+          val != param->last_port_value)
+        {
+          param->value = val;
+          param->last_port_value = val;
+          param->port_changed = 0;
+        }
+    }
+}
+
+/**
+ * Returns the index of the parameter set by the
+ * given event, or -1 if it is not a patch:Set of
+ * one of the parameters.
+ *
+ * @param value Set to the new value, clamped to
+ *   the range of the parameter.
+ */
+static inline int
+plugin_params_get_event (
+  PluginCommon *         self,
+  const LV2_Atom_Event * ev,
+  float *                value)
+{
+  PluginUris * uris = &self->uris;
+  if (!lv2_atom_forge_is_object_type (
+         &self->forge, ev->body.type))
+    return -1;
+
+  const LV2_Atom_Object * obj =
+    (const LV2_Atom_Object *) &ev->body;
+  if (obj->body.otype != uris->patch_Set)
+    return -1;
+
+  const LV2_Atom * property = NULL;
+  const LV2_Atom * val = NULL;
+  lv2_atom_object_get (
+    obj, uris->patch_property, &property,
+    uris->patch_value, &val, 0);
+  if (!property || !val ||
+      property->type != uris->atom_URID)
+    return -1;
+
+  float fval;
+  if (val->type == uris->atom_Float)
+    fval = ((const LV2_Atom_Float *) val)->body;
+  else if (val->type == uris->atom_Double)
+    fval =
+      (float) ((const LV2_Atom_Double *) val)->body;
+  else if (val->type == uris->atom_Int)
+    fval = (float) ((const LV2_Atom_Int *) val)->body;
+  else if (val->type == uris->atom_Long)
+    fval =
+      (float) ((const LV2_Atom_Long *) val)->body;
+  else
+    return -1;
+
+  LV2_URID key =
+    ((const LV2_Atom_URID *) property)->body;
+  for (int i = 0; i < self->num_params; i++)
+    {
+      PluginParam * param = &self->params[i];
+      if (param->uri == key)
+        {
+          if (fval < param->minimum)
+            fval = param->minimum;
+          else if (fval > param->maximum)
+            fval = param->maximum;
+          *value = fval;
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/**
+ * Handles the parameter events of the control port
+ * and calls @p process for each part of the block
+ * between them, so that each part sees the values
+ * at its start.
+ *
+ * Other events are ignored, so plugins that need
+ * them handle them before calling this.
+ *
+ * @param process Processes @p nframes samples
+ *   starting at @p offset, or NULL to only apply
+ *   the events (when bypassed).
+ */
+static inline void
+plugin_params_run (
+  PluginCommon *            self,
+  const LV2_Atom_Sequence * control,
+  uint32_t                  n_samples,
+  void *                    user_data,
+  void (*process) (
+    void *   user_data,
+    uint32_t offset,
+    uint32_t nframes))
+{
+  plugin_params_begin (self);
+
+  uint32_t processed = 0;
+  if (control)
+    {
+      LV2_ATOM_SEQUENCE_FOREACH (control, ev)
+        {
+          float val;
+          int idx =
+            plugin_params_get_event (self, ev, &val);
+          if (idx < 0)
+            continue;
+
+          uint32_t ev_frames =
+            (uint32_t) ev->time.frames;
+          if (ev_frames > n_samples)
+            ev_frames = n_samples;
+          if (process && ev_frames > processed)
+            {
+              process (
+                user_data, processed,
+                ev_frames - processed);
+              processed = ev_frames;
+            }
+          self->params[idx].value = val;
+        }
+    }
+
+  if (process && processed < n_samples)
+    {
+      process (
+        user_data, processed, n_samples - processed);
+    }
+}
+
+/**
+ * Prints the TTL declaring the parameters.
+ *
+ * To be called after the last port, instead of
+ * ending the plugin description.
+ */
+static inline void
+plugin_print_params_ttl (
+  FILE *                  f,
+  const PluginParamInfo * infos,
+  int                     num_infos)
+{
+  fprintf (f, " ;\n  patch:writable ");
+  for (int i = 0; i < num_infos; i++)
+    {
+      fprintf (
+        f, "%s<" PLUGIN_URI "#%s>",
+        i == 0 ? "" : " ,\n    ", infos[i].symbol);
+    }
+  fprintf (f, " .\n");
+
+  for (int i = 0; i < num_infos; i++)
+    {
+      fprintf (f,
+"\n<" PLUGIN_URI "#%s>\n\
+  a lv2:Parameter ;\n\
+  rdfs:label \"%s\" ;\n\
+  rdfs:range atom:Float ;\n\
+  lv2:minimum %f ;\n\
+  lv2:maximum %f .\n",
+        infos[i].symbol, infos[i].name,
+        (double) infos[i].minimum,
+        (double) infos[i].maximum);
+    }
+}
+
+/** Max block length used when the host does not
+ * give one. */
+#define PLUGIN_DEFAULT_BLOCK_LENGTH 4096
+
+/** Alignment of scratch buffers, in bytes. */
+#define PLUGIN_SCRATCH_ALIGNMENT 64
+
+/**
+ * Returns the value of an integer option, or 0 if
+ * it is not an integer.
+ */
+static inline int64_t
+plugin_common_get_int_option (
+  PluginCommon *             self,
+  const LV2_Options_Option * opt)
+{
+  if (opt->type == self->uris.atom_Int)
+    return *(const int32_t *) opt->value;
+  else if (opt->type == self->uris.atom_Long)
+    return *(const int64_t *) opt->value;
+
+  return 0;
+}
+
+/**
+ * Reads the block lengths and the samplerate from
+ * the options given by the host.
+ */
+static inline void
+plugin_common_parse_options (
+  PluginCommon * self)
+{
+  self->max_block_length =
+    PLUGIN_DEFAULT_BLOCK_LENGTH;
+  self->nominal_block_length = 0;
+  if (!self->options)
+    return;
+
+  PluginUris * uris = &self->uris;
+  for (const LV2_Options_Option * opt =
+         self->options;
+       opt->key || opt->value; opt++)
+    {
+      if (opt->context != LV2_OPTIONS_INSTANCE)
+        continue;
+
+      if (opt->key == uris->bufsz_maxBlockLength)
+        {
+          int64_t val =
+            plugin_common_get_int_option (
+              self, opt);
+          if (val > 0)
+            self->max_block_length =
+              (uint32_t) val;
+        }
+      else if (opt->key ==
+                 uris->bufsz_nominalBlockLength)
+        {
+          int64_t val =
+            plugin_common_get_int_option (
+              self, opt);
+          if (val > 0)
+            self->nominal_block_length =
+              (uint32_t) val;
+        }
+      else if (opt->key == uris->param_sampleRate)
+        {
+          /* only used if the host passed no rate
+           * to instantiate() */
+          double rate = 0.0;
+          if (opt->type == uris->atom_Float)
+            rate = *(const float *) opt->value;
+          else if (opt->type == uris->atom_Double)
+            rate = *(const double *) opt->value;
+          if (self->samplerate <= 0.0 && rate > 0.0)
+            self->samplerate = rate;
+        }
+    }
+
+  /* a nominal length longer than the max is
+   * bogus */
+  if (self->nominal_block_length >
+        self->max_block_length)
+    self->nominal_block_length = 0;
+}
+
+/**
+ * Allocates the scratch arena: the given number of
+ * buffers of max_block_length floats each, aligned
+ * for SIMD.
+ *
+ * Call from instantiate(). run() then gets the
+ * buffers with plugin_common_get_scratch() and
+ * must process at most max_block_length samples at
+ * a time.
+ *
+ * @return Non-zero on fail.
+ */
+static inline int
+plugin_common_alloc_scratch (
+  PluginCommon * self,
+  int            num_bufs)
+{
+  /* round each buffer up to the alignment */
+  const size_t align =
+    PLUGIN_SCRATCH_ALIGNMENT / sizeof (float);
+  self->scratch_stride =
+    ((self->max_block_length + align - 1) / align) *
+    align;
+  self->scratch =
+    plugin_aligned_calloc (
+      PLUGIN_SCRATCH_ALIGNMENT,
+      self->scratch_stride * (size_t) num_bufs *
+        sizeof (float));
+  if (!self->scratch)
+    {
+      lv2_log_error (
+        &self->logger,
+        "Failed to allocate %d scratch buffers of "
+        "%u samples\n",
+        num_bufs, self->max_block_length);
+      return -1;
+    }
+  self->num_scratch_bufs = num_bufs;
+
+  return 0;
+}
+
+/**
+ * Returns the scratch buffer at the given index.
+ */
+static inline float *
+plugin_common_get_scratch (
+  PluginCommon * self,
+  int            idx)
+{
+  return
+    self->scratch +
+    (size_t) idx * self->scratch_stride;
+}
+
+/**
+ * Sets up the bypass.
+ *
+ * Call from instantiate(), after
+ * plugin_common_instantiate().
+ *
+ * @param num_channels Number of channels passed
+ *   through when bypassed.
+ * @param reset Function that clears the DSP state
+ *   before fading back in, or NULL to keep the
+ *   state as it was.
+ *
+ * @return Non-zero on fail.
+ */
+static inline int
+plugin_bypass_init (
+  PluginCommon * self,
+  int            num_channels,
+  void (*reset) (void * user_data),
+  void *         reset_data)
+{
+  PluginBypass * bypass = &self->bypass;
+  bypass->gain = 1.f;
+  bypass->step =
+    1.f /
+    (PLUGIN_BYPASS_FADE_TIME *
+     (float) self->samplerate);
+  bypass->num_channels = num_channels;
+  bypass->reset = reset;
+  bypass->reset_data = reset_data;
+
+  const size_t align =
+    PLUGIN_SCRATCH_ALIGNMENT / sizeof (float);
+  bypass->dry_stride =
+    ((self->max_block_length + align - 1) / align) *
+    align;
+  bypass->dry =
+    plugin_aligned_calloc (
+      PLUGIN_SCRATCH_ALIGNMENT,
+      bypass->dry_stride * (size_t) num_channels *
+        sizeof (float));
+  if (!bypass->dry)
+    {
+      lv2_log_error (
+        &self->logger,
+        "Failed to allocate the bypass buffers\n");
+      return -1;
+    }
+
+  return 0;
+}
+
+/**
+ * Sets up the delay of the input passed through,
+ * for plugins that report latency.
+ *
+ * Call from instantiate(), after
+ * plugin_bypass_init().
+ *
+ * @param max_latency Highest latency the plugin
+ *   reports, in samples.
+ *
+ * @return Non-zero on fail.
+ */
+static inline int
+plugin_bypass_init_latency (
+  PluginCommon * self,
+  uint32_t       max_latency)
+{
+  PluginBypass * bypass = &self->bypass;
+  uint32_t size = 1;
+  while (size <= max_latency)
+    size <<= 1;
+
+  bypass->delay_mask = size - 1;
+  bypass->delay_pos = 0;
+  bypass->latency = 0;
+  bypass->delay =
+    plugin_aligned_calloc (
+      PLUGIN_SCRATCH_ALIGNMENT,
+      (size_t) size *
+        (size_t) bypass->num_channels *
+        sizeof (float));
+  if (!bypass->delay)
+    {
+      lv2_log_error (
+        &self->logger,
+        "Failed to allocate the bypass delay\n");
+      return -1;
+    }
+
+  return 0;
+}
+
+/**
+ * Passes the inputs through the delay lines into
+ * the dry buffers, in parts of at most
+ * max_block_length samples, and copies each part
+ * to the outputs if @p out is not NULL.
+ *
+ * All the inputs of a part are read before the
+ * outputs are written, so they may share buffers.
+ */
+static inline void
+plugin_bypass_delay (
+  PluginCommon *        self,
+  const float * const * in,
+  float * const *       out,
+  uint32_t              n_samples)
+{
+  PluginBypass * bypass = &self->bypass;
+  uint32_t mask = bypass->delay_mask;
+  uint32_t latency =
+    bypass->latency > mask ? mask : bypass->latency;
+  uint32_t delay_pos = bypass->delay_pos;
+
+  for (uint32_t pos = 0; pos < n_samples;
+       pos += self->max_block_length)
+    {
+      uint32_t len = n_samples - pos;
+      if (len > self->max_block_length)
+        len = self->max_block_length;
+      for (int i = 0; i < bypass->num_channels; i++)
+        {
+          float * delay =
+            &bypass->delay[(size_t) i * (mask + 1)];
+          float * dry =
+            &bypass->dry[(size_t) i * bypass->dry_stride];
+          for (uint32_t j = 0; j < len; j++)
+            {
+              delay[(delay_pos + j) & mask] =
+                in[i][pos + j];
+              dry[j] =
+                delay[(delay_pos + j - latency) & mask];
+            }
+        }
+      delay_pos += len;
+
+      if (!out)
+        continue;
+
+      for (int i = 0; i < bypass->num_channels; i++)
+        {
+          memcpy (
+            &out[i][pos],
+            &bypass->dry[(size_t) i * bypass->dry_stride],
+            len * sizeof (float));
+        }
+    }
+
+  bypass->delay_pos = delay_pos;
+}
+
+/**
+ * Copies the inputs to the outputs.
+ *
+ * The host may connect an output to the buffer of
+ * another input, e.g. left and right crossed, so
+ * in that case the inputs go through the dry
+ * buffers.
+ */
+static inline void
+plugin_bypass_copy (
+  PluginCommon *        self,
+  const float * const * in,
+  float * const *       out,
+  uint32_t              n_samples)
+{
+  PluginBypass * bypass = &self->bypass;
+  int num_channels = bypass->num_channels;
+
+  int crossed = 0;
+  for (int i = 0; i < num_channels; i++)
+    for (int j = 0; j < num_channels; j++)
+      if (i != j && out[i] == in[j])
+        crossed = 1;
+
+  if (!crossed)
+    {
+      for (int i = 0; i < num_channels; i++)
+        {
+          if (out[i] != in[i])
+            {
+              memcpy (
+                out[i], in[i],
+                n_samples * sizeof (float));
+            }
+        }
+      return;
+    }
+
+  for (uint32_t pos = 0; pos < n_samples;
+       pos += self->max_block_length)
+    {
+      uint32_t len = n_samples - pos;
+      if (len > self->max_block_length)
+        len = self->max_block_length;
+      for (int i = 0; i < num_channels; i++)
+        {
+          memcpy (
+            &bypass->dry[(size_t) i * bypass->dry_stride],
+            &in[i][pos], len * sizeof (float));
+        }
+      for (int i = 0; i < num_channels; i++)
+        {
+          memcpy (
+            &out[i][pos],
+            &bypass->dry[(size_t) i * bypass->dry_stride],
+            len * sizeof (float));
+        }
+    }
+}
+
+/**
+ * To be called in run() before processing.
+ *
+ * Starts a crossfade if the enabled port changed.
+ *
+ * @return 1 if the plugin is bypassed, in which
+ *   case the input was copied to the output and
+ *   the plugin must not process the block.
+ */
+static inline int
+plugin_bypass_begin (
+  PluginCommon *        self,
+  const float * const * in,
+  float * const *       out,
+  uint32_t              n_samples)
+{
+  PluginBypass * bypass = &self->bypass;
+  int enabled =
+    !bypass->enabled || *bypass->enabled > 0.5f;
+  float target = enabled ? 1.f : 0.f;
+
+  bypass->fading = 0;
+  if (bypass->gain == target ||
+      n_samples > self->max_block_length)
+    {
+      /* no crossfade for blocks longer than the
+       * host said they would be */
+      if (bypass->gain == 0.f && enabled &&
+          bypass->reset)
+        {
+          bypass->reset (bypass->reset_data);
+        }
+      bypass->gain = target;
+      if (enabled)
+        {
+          /* keep the delay lines filled for the
+           * next crossfade */
+          if (bypass->delay)
+            plugin_bypass_delay (
+              self, in, NULL, n_samples);
+          return 0;
+        }
+
+      if (bypass->delay)
+        plugin_bypass_delay (self, in, out, n_samples);
+      else
+        plugin_bypass_copy (self, in, out, n_samples);
+      return 1;
+    }
+
+  if (bypass->gain == 0.f && bypass->reset)
+    {
+      bypass->reset (bypass->reset_data);
+    }
+
+  bypass->fading = 1;
+  if (bypass->delay)
+    {
+      plugin_bypass_delay (self, in, NULL, n_samples);
+      return 0;
+    }
+  for (int i = 0; i < bypass->num_channels; i++)
+    {
+      memcpy (
+        &bypass->dry[(size_t) i * bypass->dry_stride],
+        in[i], n_samples * sizeof (float));
+    }
+
+  return 0;
+}
+
+/**
+ * To be called in run() after processing, if
+ * plugin_bypass_begin() returned 0.
+ *
+ * Crossfades the output with the input if the
+ * plugin is being bypassed or enabled.
+ */
+static inline void
+plugin_bypass_end (
+  PluginCommon *  self,
+  float * const * out,
+  uint32_t        n_samples)
+{
+  PluginBypass * bypass = &self->bypass;
+  if (!bypass->fading)
+    return;
+
+  int enabled =
+    !bypass->enabled || *bypass->enabled > 0.5f;
+  float step = enabled ? bypass->step : - bypass->step;
+  float gain = bypass->gain;
+  for (int i = 0; i < bypass->num_channels; i++)
+    {
+      const float * dry =
+        &bypass->dry[(size_t) i * bypass->dry_stride];
+      gain = bypass->gain;
+      for (uint32_t j = 0; j < n_samples; j++)
+        {
+          gain += step;
+          gain = gain > 1.f ? 1.f : gain;
+          gain = gain < 0.f ? 0.f : gain;
+          out[i][j] =
+            dry[j] + (out[i][j] - dry[j]) * gain;
+        }
+    }
+  bypass->gain = gain;
+  bypass->fading = 0;
+}
+
+/**
+ * Prints the TTL of the enabled port.
+ */
+static inline void
+plugin_print_enabled_ttl (
+  FILE * f,
+  int    index)
+{
+  fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:designation lv2:enabled ;\n\
+    lv2:symbol \"enabled\" ;\n\
+    lv2:name \"Enabled\" ;\n\
+    lv2:default 1 ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum 1 ;\n\
+    lv2:portProperty lv2:toggled ;\n\
+  ]", index);
+}
+
+/**
+ * Frees the memory allocated by PluginCommon.
+ */
+static inline void
+plugin_common_cleanup (
+  PluginCommon * self)
+{
+  plugin_trace_cleanup (self);
+
+  if (self->scratch)
+    {
+      plugin_aligned_free (self->scratch);
+      self->scratch = NULL;
+    }
+  if (self->bypass.dry)
+    {
+      plugin_aligned_free (self->bypass.dry);
+      self->bypass.dry = NULL;
+    }
+  if (self->bypass.delay)
+    {
+      plugin_aligned_free (self->bypass.delay);
+      self->bypass.delay = NULL;
+    }
+}
+
+/**
+ * @param with_worker 1 to add the worker feature.
+ *
+ * @return Non-zero on fail.
+ */
+static inline int
+plugin_common_instantiate (
+  PluginCommon *              self,
+  const LV2_Feature * const * features,
+  int                         with_worker)
+{
+#ifdef TRIAL_VER
+  self->instantiation_time = clock ();
+#endif
+
+#define HAVE_FEATURE(x) \
+  (!strcmp(features[i]->URI, x))
+
+  for (int i = 0; features[i]; ++i)
+    {
+      if (HAVE_FEATURE (LV2_URID__map))
+        {
+          self->map =
+            (LV2_URID_Map*) features[i]->data;
+        }
+      else if (HAVE_FEATURE (LV2_LOG__log))
+        {
+          self->log =
+            (LV2_Log_Log *) features[i]->data;
+        }
+      else if (HAVE_FEATURE (LV2_OPTIONS__options))
+        {
+          self->options =
+            (LV2_Options_Option*) features[i]->data;
+        }
+
+      if (with_worker)
+        {
+          if (HAVE_FEATURE (LV2_WORKER__schedule))
+            {
+              self->schedule =
+                (LV2_Worker_Schedule *) features[i]->data;
+            }
+        }
+    }
+#undef HAVE_FEATURE
+
+  /* plugins set it up again after mapping their
+   * URIs, but the errors below and the trace
+   * thread need it now */
+  lv2_log_logger_init (
+    &self->logger, self->map, self->log);
+
+  if (!self->map)
+    {
+      lv2_log_error (
+        &self->logger, "Missing feature urid:map\n");
+      return -1;
+    }
+  else if (with_worker && !self->schedule)
+    {
+      lv2_log_error (
+        &self->logger,
+        "Missing feature work:schedule\n");
+      return -1;
+    }
+
+  /* the options are needed before the plugin maps
+   * its own URIs */
+  map_common_uris (self->map, &self->uris);
+  plugin_common_parse_options (self);
+
+  plugin_trace_init (self);
 
   return 0;
 }
@@ -51,10 +51,33 @@ typedef enum PortIndex
   /** Outputs. */
   COMPRESSOR_STEREO_OUT_L,
   COMPRESSOR_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  COMPRESSOR_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  COMPRESSOR_ENABLED,
 
   NUM_PORTS,
 } PortIndex;
 
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo compressor_params[] = {
+  { COMPRESSOR_ATTACK, "attack",
+    "Attack", 0.000001f, 10.f },
+  { COMPRESSOR_RELEASE, "release",
+    "Release", 0.000001f, 10.f },
+  { COMPRESSOR_RATIO, "ratio",
+    "Ratio", 1.f, 40.f },
+  { COMPRESSOR_THRESHOLD, "threshold",
+    "Threshold", -80.f, 0.f },
+};
+
+#define COMPRESSOR_NUM_PARAMS \
+  ((int) (sizeof (compressor_params) / \
+          sizeof (compressor_params[0])))
+
 /**
  * Group of variables needed by both the DSP and
  * the UI.
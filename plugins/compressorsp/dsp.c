@@ -76,6 +76,14 @@ instantiate (
   /* map uris */
   map_uris (pl_common->map, &self->common);
 
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, compressor_params, COMPRESSOR_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, NULL, NULL))
+    goto fail;
+
   /* init atom forge */
   lv2_atom_forge_init (
     &pl_common->forge, pl_common->map);
@@ -87,6 +95,7 @@ instantiate (
   return (LV2_Handle) self;
 
 fail:
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
   return NULL;
 }
@@ -116,16 +125,24 @@ connect_port (
       self->stereo_in_r = (const float *) data;
       break;
     case COMPRESSOR_ATTACK:
-      self->attack = (const float *) data;
+      self->attack =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case COMPRESSOR_RELEASE:
-      self->release = (const float *) data;
+      self->release =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case COMPRESSOR_RATIO:
-      self->ratio = (const float *) data;
+      self->ratio =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case COMPRESSOR_THRESHOLD:
-      self->threshold = (const float *) data;
+      self->threshold =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case COMPRESSOR_STEREO_OUT_L:
       self->stereo_out_l = (float *) data;
@@ -133,6 +150,14 @@ connect_port (
     case COMPRESSOR_STEREO_OUT_R:
       self->stereo_out_r = (float *) data;
       break;
+    case COMPRESSOR_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case COMPRESSOR_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
     default:
       break;
     }
@@ -149,12 +174,45 @@ activate (
   sp_compressor_init (self->sp, self->compressor);
 }
 
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Compressor * self = (Compressor *) user_data;
+
+  *self->compressor->ratio = *self->ratio;
+  *self->compressor->thresh = *self->threshold;
+  *self->compressor->atk = *self->attack;
+  *self->compressor->rel = *self->release;
+  for (uint32_t i = offset; i < offset + nframes; i++)
+    {
+      /* read both inputs before writing, since the
+       * host may connect an output to either of
+       * them */
+      float in_l = self->stereo_in_l[i];
+      float in_r = self->stereo_in_r[i];
+      sp_compressor_compute (
+        self->sp, self->compressor,
+        &in_l, &self->stereo_out_l[i]);
+      sp_compressor_compute (
+        self->sp, self->compressor,
+        &in_r, &self->stereo_out_r[i]);
+    }
+}
+
 static void
 run (
   LV2_Handle instance,
   uint32_t n_samples)
 {
   Compressor * self = (Compressor *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
 
 #ifdef TRIAL_VER
   if (get_time_since_instantiation (
@@ -162,41 +220,46 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
 #if 0
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  long int ms = tp.tv_sec * 1000000 + tp.tv_usec;
+  uint64_t start_time = plugin_trace_now ();
 #endif
 
-  /* read incoming events from host and UI */
-  LV2_ATOM_SEQUENCE_FOREACH (
-    self->control, ev)
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
     {
-      /* TODO */
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
     }
-
-  /* compress */
-  *self->compressor->ratio = *self->ratio;
-  *self->compressor->thresh = *self->threshold;
-  *self->compressor->atk = *self->attack;
-  *self->compressor->rel = *self->release;
-  for (uint32_t i = 0; i < n_samples; i++)
+  else
     {
-      float current_in = self->stereo_in_l[i];
-      sp_compressor_compute (
-        self->sp, self->compressor,
-        &current_in, &self->stereo_out_l[i]);
-      current_in = self->stereo_in_r[i];
-      sp_compressor_compute (
-        self->sp, self->compressor,
-        &current_in, &self->stereo_out_r[i]);
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
     }
 
 #if 0
-  gettimeofday(&tp, NULL);
-  ms = (tp.tv_sec * 1000000 + tp.tv_usec) - ms;
-  printf("us taken %ld\n", ms);
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "us taken %.0f\n",
+    (double) (plugin_trace_now () - start_time) /
+      1000.0);
 #endif
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -214,6 +277,7 @@ cleanup (
   LV2_Handle instance)
 {
   Compressor * self = (Compressor *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
 }
 
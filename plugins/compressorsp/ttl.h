@@ -26,6 +26,7 @@ print_ttl (FILE * f)
 @prefix log:  <http://lv2plug.in/ns/ext/log#> .\n\
 @prefix lv2:  <http://lv2plug.in/ns/lv2core#> .\n\
 @prefix midi: <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
 @prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
 @prefix rdf:  <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
 @prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n\
@@ -131,7 +132,7 @@ print_ttl (FILE * f)
     lv2:index 9 ;\n\
     lv2:symbol \"stereo_out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n",
+  ]",
     /* attack */
     0.1, 0.000001, 10.0,
     /* release */
@@ -140,4 +141,9 @@ print_ttl (FILE * f)
     1.0, 1.0, 40.0,
     /* threshold */
     0.0, -80.0, 0.0);
+
+  plugin_print_dsp_load_ttl (f, COMPRESSOR_DSP_LOAD);
+  plugin_print_enabled_ttl (f, COMPRESSOR_ENABLED);
+  plugin_print_params_ttl (
+    f, compressor_params, COMPRESSOR_NUM_PARAMS);
 }
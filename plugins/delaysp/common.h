@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_DELAY_COMMON_H__
+#define __Z_DELAY_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include "../common.h"
+
+/** Max delay time in seconds, allocated at
+ * activation. */
+#define DELAY_MAX_TIME 4.f
+
+typedef struct DelayUris
+{
+} DelayUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  DELAY_CONTROL,
+  /** Plugin to UI communication. */
+  DELAY_NOTIFY,
+
+  DELAY_STEREO_IN_L,
+  DELAY_STEREO_IN_R,
+
+  /** Whether to follow the host tempo. */
+  DELAY_SYNC,
+  /** Delay times in ms, used when not synced. */
+  DELAY_TIME_L,
+  DELAY_TIME_R,
+  /** Delay times when synced. */
+  DELAY_SYNC_RATE_L,
+  DELAY_SYNC_RATE_R,
+  DELAY_SYNC_RATE_TYPE,
+  DELAY_FEEDBACK,
+  DELAY_MIX,
+
+  /** Outputs. */
+  DELAY_STEREO_OUT_L,
+  DELAY_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  DELAY_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  DELAY_ENABLED,
+
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo delay_params[] = {
+  { DELAY_SYNC, "sync",
+    "Sync", 0.f, 1.f },
+  { DELAY_TIME_L, "time_l",
+    "Time L", 1.f, 4000.f },
+  { DELAY_TIME_R, "time_r",
+    "Time R", 1.f, 4000.f },
+  { DELAY_SYNC_RATE_L, "sync_rate_l",
+    "Sync Rate L", 0.f, 14.f },
+  { DELAY_SYNC_RATE_R, "sync_rate_r",
+    "Sync Rate R", 0.f, 14.f },
+  { DELAY_SYNC_RATE_TYPE, "sync_rate_type",
+    "Sync Rate Type", 0.f, 2.f },
+  { DELAY_FEEDBACK, "feedback",
+    "Feedback", 0.f, 0.99f },
+  { DELAY_MIX, "mix",
+    "Mix", 0.f, 1.f },
+};
+
+#define DELAY_NUM_PARAMS \
+  ((int) (sizeof (delay_params) / \
+          sizeof (delay_params[0])))
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct DelayCommon
+{
+  /** URIs. */
+  DelayUris       uris;
+
+  PluginCommon    pl_common;
+
+  /** Host transport, for syncing. */
+  HostPosition    host_pos;
+
+} DelayCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map* urid_map,
+  DelayCommon * delay_common)
+{
+  map_common_uris (
+    urid_map, &delay_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  delay_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+
+#undef MAP
+}
+
+#endif
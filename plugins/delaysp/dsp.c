@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+/** Time constant of the delay time smoothing, in
+ * seconds. */
+#define DELAY_SMOOTH_TIME 0.05f
+
+typedef struct Delay
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * stereo_in_l;
+  const float * stereo_in_r;
+  const float * sync;
+  const float * time[2];
+  const float * sync_rate[2];
+  const float * sync_rate_type;
+  const float * feedback;
+  const float * mix;
+
+  /* outputs */
+  float *       stereo_out_l;
+  float *       stereo_out_r;
+
+  DelayCommon   common;
+
+  sp_data *     sp;
+  sp_fdline *   fdline[2];
+
+  /** Current (smoothed) delay times in samples, or
+   * negative before the first run. */
+  float         cur_delay[2];
+
+} Delay;
+
+/**
+ * Clears the delay lines, so that old echoes are
+ * not heard when the plugin is enabled again.
+ */
+static void
+reset (
+  void * user_data)
+{
+  Delay * self = (Delay *) user_data;
+
+  for (int i = 0; i < 2; i++)
+    {
+      sp_fdline_clear (self->sp, self->fdline[i]);
+      self->cur_delay[i] = -1.f;
+    }
+}
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  Delay * self = calloc (1, sizeof (Delay));
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 0);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, delay_params, DELAY_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, reset, self))
+    goto fail;
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  /* delay times and the delayed signal of each
+   * channel */
+  if (plugin_common_alloc_scratch (pl_common, 3))
+    goto fail;
+
+  return (LV2_Handle) self;
+
+fail:
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  Delay * self = (Delay *) instance;
+
+  switch ((PortIndex) port)
+    {
+    case DELAY_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case DELAY_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case DELAY_STEREO_IN_L:
+      self->stereo_in_l = (const float *) data;
+      break;
+    case DELAY_STEREO_IN_R:
+      self->stereo_in_r = (const float *) data;
+      break;
+    case DELAY_SYNC:
+      self->sync =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_TIME_L:
+    case DELAY_TIME_R:
+      self->time[port - DELAY_TIME_L] =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_SYNC_RATE_L:
+    case DELAY_SYNC_RATE_R:
+      self->sync_rate[port - DELAY_SYNC_RATE_L] =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_SYNC_RATE_TYPE:
+      self->sync_rate_type =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_FEEDBACK:
+      self->feedback =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_MIX:
+      self->mix =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case DELAY_STEREO_OUT_L:
+      self->stereo_out_l = (float *) data;
+      break;
+    case DELAY_STEREO_OUT_R:
+      self->stereo_out_r = (float *) data;
+      break;
+    case DELAY_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case DELAY_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  Delay * self = (Delay*) instance;
+
+  sp_create (&self->sp);
+  self->sp->sr = (int) GET_SAMPLERATE (self);
+  for (int i = 0; i < 2; i++)
+    {
+      sp_fdline_create (&self->fdline[i]);
+      sp_fdline_init (
+        self->sp, self->fdline[i], DELAY_MAX_TIME);
+      self->cur_delay[i] = -1.f;
+    }
+}
+
+/**
+ * Returns the delay time of the given channel in
+ * samples.
+ *
+ * Synced times follow the host tempo, and fall
+ * back to the time in ms when the host does not
+ * send any.
+ */
+static float
+get_target_delay (
+  Delay * self,
+  int     ch)
+{
+  float sr = (float) GET_SAMPLERATE (self);
+  HostPosition * host_pos = &self->common.host_pos;
+  float secs = *self->time[ch] * 0.001f;
+  if (*self->sync > 0.5f &&
+      host_pos->beat_unit != 0 &&
+      host_pos->bpm > 0.f)
+    {
+      float sync_rate_float =
+        sync_rate_to_float (
+          (SyncRate)
+          math_round_float_to_int (
+            *self->sync_rate[ch]),
+          (SyncRateType)
+          math_round_float_to_int (
+            *self->sync_rate_type));
+      secs =
+        (60.f * (float) host_pos->beat_unit *
+         sync_rate_float) / host_pos->bpm;
+    }
+
+  return CLAMP (secs, 0.f, DELAY_MAX_TIME) * sr;
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Delay * self = (Delay *) user_data;
+  PluginCommon * pl_common = &self->common.pl_common;
+  float fb = CLAMP (*self->feedback, 0.f, 0.99f);
+  float mix = CLAMP (*self->mix, 0.f, 1.f);
+  const float * in[2] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[2] = {
+    self->stereo_out_l, self->stereo_out_r };
+
+  /* one-pole smoothing of the delay time, stepped
+   * every SP_FDLINE_BLOCK samples and ramped
+   * linearly in between */
+  float smooth_coeff =
+    1.f -
+    sp_fast_exp (
+      - (float) SP_FDLINE_BLOCK /
+      (DELAY_SMOOTH_TIME *
+       (float) GET_SAMPLERATE (self)));
+
+  float target[2];
+  for (int ch = 0; ch < 2; ch++)
+    {
+      self->fdline[ch]->feedback = fb;
+      target[ch] = get_target_delay (self, ch);
+      if (self->cur_delay[ch] < 0.f)
+        self->cur_delay[ch] = target[ch];
+    }
+
+  float * del =
+    plugin_common_get_scratch (pl_common, 0);
+  float * wet[2] = {
+    plugin_common_get_scratch (pl_common, 1),
+    plugin_common_get_scratch (pl_common, 2) };
+  uint32_t end = offset + nframes;
+  for (uint32_t pos = offset; pos < end;
+       pos += pl_common->max_block_length)
+    {
+      uint32_t len =
+        MIN (end - pos, pl_common->max_block_length);
+
+      /* delay both channels before writing, since
+       * the host may connect an output to either
+       * input */
+      for (int ch = 0; ch < 2; ch++)
+        {
+          for (uint32_t j = 0; j < len;
+               j += SP_FDLINE_BLOCK)
+            {
+              /* parameter changes can cut the last
+               * step short, so scale its
+               * coefficient */
+              uint32_t step_len =
+                MIN (len - j, SP_FDLINE_BLOCK);
+              float start = self->cur_delay[ch];
+              float stop =
+                start +
+                (target[ch] - start) * smooth_coeff *
+                (float) step_len /
+                (float) SP_FDLINE_BLOCK;
+              float step =
+                (stop - start) / (float) step_len;
+              for (uint32_t i = 0; i < step_len; i++)
+                {
+                  del[j + i] =
+                    start + step * (float) (i + 1);
+                }
+              self->cur_delay[ch] = stop;
+            }
+
+          sp_fdline_compute_block (
+            self->sp, self->fdline[ch], &in[ch][pos],
+            del, wet[ch], len);
+        }
+
+      for (uint32_t i = 0; i < len; i++)
+        {
+          float in_l = in[0][pos + i];
+          float in_r = in[1][pos + i];
+          out[0][pos + i] =
+            in_l * (1.f - mix) + wet[0][i] * mix;
+          out[1][pos + i] =
+            in_r * (1.f - mix) + wet[1][i] * mix;
+        }
+    }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Delay * self = (Delay *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  /* read incoming events from host and UI */
+  LV2_ATOM_SEQUENCE_FOREACH (
+    self->control, ev)
+    {
+      if (lv2_atom_forge_is_object_type (
+            &pl_common->forge, ev->body.type))
+        {
+          const LV2_Atom_Object * obj =
+            (const LV2_Atom_Object*)&ev->body;
+          if (obj->body.otype ==
+                pl_common->uris.time_Position)
+            {
+              plugin_update_host_position (
+                &pl_common->uris,
+                &self->common.host_pos, obj);
+            }
+        }
+    }
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+  Delay * self = (Delay *) instance;
+
+  sp_destroy (&self->sp);
+  for (int i = 0; i < 2; i++)
+    {
+      sp_fdline_destroy (&self->fdline[i]);
+    }
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  Delay * self = (Delay *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
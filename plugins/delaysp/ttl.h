@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+static void
+print_ttl (FILE * f)
+{
+  fprintf (f,
+"@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n\
+@prefix bufsz: <http://lv2plug.in/ns/ext/buf-size#> .\n\
+@prefix doap:  <http://usefulinc.com/ns/doap#> .\n\
+@prefix log:   <http://lv2plug.in/ns/ext/log#> .\n\
+@prefix lv2:   <http://lv2plug.in/ns/lv2core#> .\n\
+@prefix midi:  <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix opts:  <http://lv2plug.in/ns/ext/options#> .\n\
+@prefix param: <http://lv2plug.in/ns/ext/parameters#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
+@prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
+@prefix rdf:   <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
+@prefix rdfs:  <http://www.w3.org/2000/01/rdf-schema#> .\n\
+@prefix rsz:   <http://lv2plug.in/ns/ext/resize-port#> .\n\
+@prefix time:  <http://lv2plug.in/ns/ext/time#> .\n\
+@prefix urid:  <http://lv2plug.in/ns/ext/urid#> .\n\
+@prefix ui:    <http://lv2plug.in/ns/extensions/ui#> .\n\
+@prefix units: <http://lv2plug.in/ns/extensions/units#> .\n\
+@prefix work:  <http://lv2plug.in/ns/ext/worker#> .\n\n");
+
+  fprintf (f,
+"<" PLUGIN_URI ">\n\
+  a lv2:Plugin,\n\
+    lv2:" PLUGIN_TYPE " ;\n\
+  doap:name \"" PLUGIN_NAME "\" ;\n\
+  doap:license <https://www.gnu.org/licenses/agpl-3.0.html> ;\n\
+  lv2:project <" PROJECT_URI "> ;\n\
+  lv2:requiredFeature urid:map ;\n\
+  lv2:optionalFeature log:log ,\n\
+                      lv2:hardRTCapable ,\n\
+                      opts:options ,\n\
+                      bufsz:boundedBlockLength ;\n\
+  opts:supportedOption bufsz:maxBlockLength ,\n\
+                       bufsz:nominalBlockLength ,\n\
+                       param:sampleRate ;\n\
+  lv2:port [\n\
+    a lv2:InputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    atom:supports time:Position ;\n\
+    lv2:index 0 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"control\" ;\n\
+    lv2:name \"Control\" ;\n\
+    rdfs:comment \"GUI/host to plugin communication\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 1 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"notify\" ;\n\
+    lv2:name \"Notify\" ;\n\
+    rdfs:comment \"Plugin to GUI communication\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 2 ;\n\
+    lv2:symbol \"stereo_in_l\" ;\n\
+    lv2:name \"Stereo In L\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 3 ;\n\
+    lv2:symbol \"stereo_in_r\" ;\n\
+    lv2:name \"Stereo In R\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 4 ;\n\
+    lv2:symbol \"sync\" ;\n\
+    lv2:name \"Sync\" ;\n\
+    lv2:default 1 ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum 1 ;\n\
+    lv2:portProperty lv2:toggled ;\n\
+    rdfs:comment \"Follow the host tempo\" ;\n\
+  ]");
+
+  const char * side_names[2] = { "l", "r" };
+  const char * side_labels[2] = { "L", "R" };
+  const double def_times[2] = { 375.0, 500.0 };
+  for (int i = 0; i < 2; i++)
+    {
+      fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"time_%s\" ;\n\
+    lv2:name \"Time %s\" ;\n\
+    lv2:default %f ;\n\
+    lv2:minimum 1.000000 ;\n\
+    lv2:maximum %f ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:ms ;\n\
+    rdfs:comment \"Delay time when not synced\" ;\n\
+  ]",
+        DELAY_TIME_L + i, side_names[i],
+        side_labels[i], def_times[i],
+        (double) DELAY_MAX_TIME * 1000.0);
+    }
+
+  const int def_rates[2] = { SYNC_1_8, SYNC_1_4 };
+  for (int i = 0; i < 2; i++)
+    {
+      fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"sync_rate_%s\" ;\n\
+    lv2:name \"Sync Rate %s\" ;\n\
+    lv2:default %d ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum %d ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    lv2:portProperty lv2:enumeration ;\n\
+    lv2:scalePoint [ rdfs:label \"1/128\"; rdf:value 0 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/64\"; rdf:value 1 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/32\"; rdf:value 2 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/16\"; rdf:value 3 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/8\"; rdf:value 4 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/4\"; rdf:value 5 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/2\"; rdf:value 6 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"1/1\"; rdf:value 7 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"2/1\"; rdf:value 8 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"4/1\"; rdf:value 9 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"8/1\"; rdf:value 10 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"16/1\"; rdf:value 11 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"32/1\"; rdf:value 12 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"64/1\"; rdf:value 13 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"128/1\"; rdf:value 14 ] ;\n\
+    rdfs:comment \"Delay time when synced, limited to %d seconds\" ;\n\
+  ]",
+        DELAY_SYNC_RATE_L + i, side_names[i],
+        side_labels[i], def_rates[i],
+        NUM_SYNC_RATES - 1, (int) DELAY_MAX_TIME);
+    }
+
+  fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"sync_rate_type\" ;\n\
+    lv2:name \"Sync Rate Type\" ;\n\
+    lv2:default 0 ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum %d ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    lv2:portProperty lv2:enumeration ;\n\
+    lv2:scalePoint [ rdfs:label \"Normal\"; rdf:value 0 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"Dotted\"; rdf:value 1 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"Triplet\"; rdf:value 2 ] ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"feedback\" ;\n\
+    lv2:name \"Feedback\" ;\n\
+    lv2:default 0.400000 ;\n\
+    lv2:minimum 0.000000 ;\n\
+    lv2:maximum 0.990000 ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"mix\" ;\n\
+    lv2:name \"Mix\" ;\n\
+    lv2:default 0.300000 ;\n\
+    lv2:minimum 0.000000 ;\n\
+    lv2:maximum 1.000000 ;\n\
+    rdfs:comment \"Amount of delayed signal\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_l\" ;\n\
+    lv2:name \"Stereo Out L\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_r\" ;\n\
+    lv2:name \"Stereo Out R\" ;\n\
+  ]",
+    DELAY_SYNC_RATE_TYPE, NUM_SYNC_RATE_TYPES - 1,
+    DELAY_FEEDBACK, DELAY_MIX,
+    DELAY_STEREO_OUT_L, DELAY_STEREO_OUT_R);
+
+  plugin_print_dsp_load_ttl (f, DELAY_DSP_LOAD);
+  plugin_print_enabled_ttl (f, DELAY_ENABLED);
+  plugin_print_params_ttl (
+    f, delay_params, DELAY_NUM_PARAMS);
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_EQ_COMMON_H__
+#define __Z_EQ_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include "../common.h"
+
+/** Number of EQ bands. */
+#define EQ_NUM_BANDS 6
+
+/** Number of ports of each band. */
+#define EQ_BAND_NUM_PORTS 4
+
+typedef struct EqUris
+{
+} EqUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  EQ_CONTROL,
+  /** Plugin to UI communication. */
+  EQ_NOTIFY,
+
+  EQ_STEREO_IN_L,
+  EQ_STEREO_IN_R,
+
+  /** Band ports, EQ_BAND_NUM_PORTS per band in
+   * this order. */
+  EQ_BAND1_TYPE,
+  EQ_BAND1_FREQ,
+  EQ_BAND1_GAIN,
+  EQ_BAND1_Q,
+  EQ_BAND2_TYPE,
+  EQ_BAND2_FREQ,
+  EQ_BAND2_GAIN,
+  EQ_BAND2_Q,
+  EQ_BAND3_TYPE,
+  EQ_BAND3_FREQ,
+  EQ_BAND3_GAIN,
+  EQ_BAND3_Q,
+  EQ_BAND4_TYPE,
+  EQ_BAND4_FREQ,
+  EQ_BAND4_GAIN,
+  EQ_BAND4_Q,
+  EQ_BAND5_TYPE,
+  EQ_BAND5_FREQ,
+  EQ_BAND5_GAIN,
+  EQ_BAND5_Q,
+  EQ_BAND6_TYPE,
+  EQ_BAND6_FREQ,
+  EQ_BAND6_GAIN,
+  EQ_BAND6_Q,
+
+  EQ_OUTPUT_GAIN,
+
+  /** Outputs. */
+  EQ_STEREO_OUT_L,
+  EQ_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  EQ_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  EQ_ENABLED,
+
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo eq_params[] = {
+  { EQ_BAND1_TYPE, "band1_type",
+    "Band 1 Type", 0.f, 5.f },
+  { EQ_BAND1_FREQ, "band1_freq",
+    "Band 1 Frequency", 20.f, 20000.f },
+  { EQ_BAND1_GAIN, "band1_gain",
+    "Band 1 Gain", -24.f, 24.f },
+  { EQ_BAND1_Q, "band1_q",
+    "Band 1 Q", 0.1f, 18.f },
+  { EQ_BAND2_TYPE, "band2_type",
+    "Band 2 Type", 0.f, 5.f },
+  { EQ_BAND2_FREQ, "band2_freq",
+    "Band 2 Frequency", 20.f, 20000.f },
+  { EQ_BAND2_GAIN, "band2_gain",
+    "Band 2 Gain", -24.f, 24.f },
+  { EQ_BAND2_Q, "band2_q",
+    "Band 2 Q", 0.1f, 18.f },
+  { EQ_BAND3_TYPE, "band3_type",
+    "Band 3 Type", 0.f, 5.f },
+  { EQ_BAND3_FREQ, "band3_freq",
+    "Band 3 Frequency", 20.f, 20000.f },
+  { EQ_BAND3_GAIN, "band3_gain",
+    "Band 3 Gain", -24.f, 24.f },
+  { EQ_BAND3_Q, "band3_q",
+    "Band 3 Q", 0.1f, 18.f },
+  { EQ_BAND4_TYPE, "band4_type",
+    "Band 4 Type", 0.f, 5.f },
+  { EQ_BAND4_FREQ, "band4_freq",
+    "Band 4 Frequency", 20.f, 20000.f },
+  { EQ_BAND4_GAIN, "band4_gain",
+    "Band 4 Gain", -24.f, 24.f },
+  { EQ_BAND4_Q, "band4_q",
+    "Band 4 Q", 0.1f, 18.f },
+  { EQ_BAND5_TYPE, "band5_type",
+    "Band 5 Type", 0.f, 5.f },
+  { EQ_BAND5_FREQ, "band5_freq",
+    "Band 5 Frequency", 20.f, 20000.f },
+  { EQ_BAND5_GAIN, "band5_gain",
+    "Band 5 Gain", -24.f, 24.f },
+  { EQ_BAND5_Q, "band5_q",
+    "Band 5 Q", 0.1f, 18.f },
+  { EQ_BAND6_TYPE, "band6_type",
+    "Band 6 Type", 0.f, 5.f },
+  { EQ_BAND6_FREQ, "band6_freq",
+    "Band 6 Frequency", 20.f, 20000.f },
+  { EQ_BAND6_GAIN, "band6_gain",
+    "Band 6 Gain", -24.f, 24.f },
+  { EQ_BAND6_Q, "band6_q",
+    "Band 6 Q", 0.1f, 18.f },
+  { EQ_OUTPUT_GAIN, "output_gain",
+    "Output Gain", -24.f, 24.f },
+};
+
+#define EQ_NUM_PARAMS \
+  ((int) (sizeof (eq_params) / \
+          sizeof (eq_params[0])))
+
+/**
+ * Filter type of a band, selected by its type port.
+ */
+typedef enum EqBandType
+{
+  EQ_BAND_OFF,
+  EQ_BAND_PEAK,
+  EQ_BAND_LOW_SHELF,
+  EQ_BAND_HIGH_SHELF,
+  EQ_BAND_LOW_CUT,
+  EQ_BAND_HIGH_CUT,
+} EqBandType;
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct EqCommon
+{
+  /** URIs. */
+  EqUris  uris;
+
+  PluginCommon    pl_common;
+
+} EqCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map* urid_map,
+  EqCommon *    eq_common)
+{
+  map_common_uris (
+    urid_map, &eq_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  eq_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+
+#undef MAP
+}
+
+#endif
@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+/** Number of frames processed between updates of
+ * the smoothed parameters. */
+#define SMOOTH_BLOCK 32
+
+/** Time constant of the parameter smoothing, in
+ * seconds. */
+#define SMOOTH_TIME 0.02
+
+/** Lanes of the biquad cascade used for the left
+ * and right channels. */
+#define LANE_L 0
+#define LANE_R 1
+
+typedef struct EqBand
+{
+  /** Band ports. */
+  const float * type;
+  const float * freq;
+  const float * gain;
+  const float * q;
+
+  /** Smoothed values the current coefficients
+   * were designed from. */
+  float         cur_freq;
+  float         cur_gain;
+  float         cur_q;
+  EqBandType    cur_type;
+} EqBand;
+
+typedef struct Eq
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * stereo_in_l;
+  const float * stereo_in_r;
+  const float * output_gain;
+
+  /* outputs */
+  float *       stereo_out_l;
+  float *       stereo_out_r;
+
+  EqBand        bands[EQ_NUM_BANDS];
+
+  /** Smoothed output gain (amplitude). */
+  float         cur_output_gain;
+
+  /** Smoothing coefficient per SMOOTH_BLOCK. */
+  float         smooth_coeff;
+
+  /** Whether the smoothed values should jump to
+   * the port values (first run after
+   * activation). */
+  int           snap;
+
+  EqCommon common;
+
+  sp_data *     sp;
+
+  /** One stage per band, with the left and right
+   * channels in LANE_L and LANE_R. */
+  sp_biquads *  biquads;
+
+} Eq;
+
+/**
+ * Clears the filters and jumps to the port values
+ * when the plugin is enabled again.
+ */
+static void
+reset (
+  void * user_data)
+{
+  Eq * self = (Eq *) user_data;
+
+  sp_biquads_clear (self->sp, self->biquads);
+  self->snap = 1;
+}
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  Eq * self = calloc (1, sizeof (Eq));
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 0);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, eq_params, EQ_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, reset, self))
+    goto fail;
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  self->smooth_coeff =
+    (float)
+    (1.0 - exp (-SMOOTH_BLOCK / (SMOOTH_TIME * rate)));
+
+  return (LV2_Handle) self;
+
+fail:
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  Eq * self = (Eq *) instance;
+
+  if (port >= EQ_BAND1_TYPE && port < EQ_OUTPUT_GAIN)
+    {
+      uint32_t idx = port - EQ_BAND1_TYPE;
+      EqBand * band =
+        &self->bands[idx / EQ_BAND_NUM_PORTS];
+      switch (idx % EQ_BAND_NUM_PORTS)
+        {
+        case 0:
+          band->type =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 1:
+          band->freq =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 2:
+          band->gain =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 3:
+          band->q =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        }
+      return;
+    }
+
+  switch ((PortIndex) port)
+    {
+    case EQ_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case EQ_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case EQ_STEREO_IN_L:
+      self->stereo_in_l = (const float *) data;
+      break;
+    case EQ_STEREO_IN_R:
+      self->stereo_in_r = (const float *) data;
+      break;
+    case EQ_OUTPUT_GAIN:
+      self->output_gain =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case EQ_STEREO_OUT_L:
+      self->stereo_out_l = (float *) data;
+      break;
+    case EQ_STEREO_OUT_R:
+      self->stereo_out_r = (float *) data;
+      break;
+    case EQ_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case EQ_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  Eq * self = (Eq*) instance;
+
+  sp_create (&self->sp);
+  self->sp->sr = (int) GET_SAMPLERATE (self);
+  sp_biquads_create (&self->biquads);
+  sp_biquads_init (
+    self->sp, self->biquads, EQ_NUM_BANDS);
+  self->snap = 1;
+}
+
+static int
+get_biquads_type (
+  EqBandType type)
+{
+  switch (type)
+    {
+    case EQ_BAND_PEAK:
+      return SP_BIQUADS_PEAK;
+    case EQ_BAND_LOW_SHELF:
+      return SP_BIQUADS_LOWSHELF;
+    case EQ_BAND_HIGH_SHELF:
+      return SP_BIQUADS_HIGHSHELF;
+    case EQ_BAND_LOW_CUT:
+      return SP_BIQUADS_HIGHPASS;
+    case EQ_BAND_HIGH_CUT:
+      return SP_BIQUADS_LOWPASS;
+    default:
+      return SP_BIQUADS_BYPASS;
+    }
+}
+
+/**
+ * Moves the smoothed values of the band one step
+ * towards its ports and redesigns its filter if
+ * anything changed.
+ *
+ * Frequency and Q are smoothed in the log domain
+ * so that sweeps sound even.
+ *
+ * @param k Smoothing coefficient of the step.
+ */
+static void
+update_band (
+  Eq *  self,
+  int   idx,
+  float k)
+{
+  EqBand * band = &self->bands[idx];
+  EqBandType type =
+    (EqBandType)
+    math_round_float_to_int (*band->type);
+  float freq = *band->freq;
+  float gain = *band->gain;
+  float q = *band->q;
+
+  if (self->snap || type != band->cur_type)
+    {
+      band->cur_freq = freq;
+      band->cur_gain = gain;
+      band->cur_q = q;
+    }
+  else if (
+    math_floats_equal_w_epsilon (
+      band->cur_freq, freq, 0.01f) &&
+    math_floats_equal_w_epsilon (
+      band->cur_gain, gain, 0.001f) &&
+    math_floats_equal_w_epsilon (
+      band->cur_q, q, 0.0001f))
+    {
+      /* settled */
+      return;
+    }
+  else
+    {
+      band->cur_freq *=
+        sp_fast_pow (freq / band->cur_freq, k);
+      band->cur_gain += (gain - band->cur_gain) * k;
+      band->cur_q *= sp_fast_pow (q / band->cur_q, k);
+    }
+  band->cur_type = type;
+
+  int bq_type = get_biquads_type (type);
+  sp_biquads_design (
+    self->sp, self->biquads, idx, LANE_L, bq_type,
+    band->cur_freq, band->cur_q, band->cur_gain);
+  sp_biquads_design (
+    self->sp, self->biquads, idx, LANE_R, bq_type,
+    band->cur_freq, band->cur_q, band->cur_gain);
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Eq * self = (Eq *) user_data;
+
+  float output_gain =
+    sp_fast_db2lin (*self->output_gain);
+  if (self->snap)
+    {
+      self->cur_output_gain = output_gain;
+    }
+
+  /* 512 bytes whatever the host block length, so
+   * this stays on the stack instead of in the
+   * scratch arena */
+  float frames[SMOOTH_BLOCK * SP_BIQUADS_LANES];
+  memset (frames, 0, sizeof (frames));
+  uint32_t end = offset + nframes;
+  for (uint32_t pos = offset; pos < end;
+       pos += SMOOTH_BLOCK)
+    {
+      uint32_t len = MIN (SMOOTH_BLOCK, end - pos);
+
+      /* parameter changes can cut the last step
+       * short, so scale its coefficient */
+      float k =
+        self->smooth_coeff * (float) len /
+        (float) SMOOTH_BLOCK;
+
+      for (int i = 0; i < EQ_NUM_BANDS; i++)
+        {
+          update_band (self, i, k);
+        }
+      self->snap = 0;
+
+      for (uint32_t i = 0; i < len; i++)
+        {
+          frames[i * SP_BIQUADS_LANES + LANE_L] =
+            self->stereo_in_l[pos + i];
+          frames[i * SP_BIQUADS_LANES + LANE_R] =
+            self->stereo_in_r[pos + i];
+        }
+
+      sp_biquads_compute_block (
+        self->sp, self->biquads, frames, frames,
+        len);
+
+      /* ramp the output gain over the block */
+      float gain = self->cur_output_gain;
+      float next_gain =
+        gain + (output_gain - gain) * k;
+      float gain_step = (next_gain - gain) / len;
+      for (uint32_t i = 0; i < len; i++)
+        {
+          self->stereo_out_l[pos + i] =
+            frames[i * SP_BIQUADS_LANES + LANE_L] *
+            gain;
+          self->stereo_out_r[pos + i] =
+            frames[i * SP_BIQUADS_LANES + LANE_R] *
+            gain;
+          gain += gain_step;
+        }
+      self->cur_output_gain = next_gain;
+    }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Eq * self = (Eq *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+  Eq * self = (Eq *) instance;
+
+  sp_destroy (&self->sp);
+  sp_biquads_destroy (&self->biquads);
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  Eq * self = (Eq *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+static void
+print_ttl (FILE * f)
+{
+  fprintf (f,
+"@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n\
+@prefix doap:  <http://usefulinc.com/ns/doap#> .\n\
+@prefix log:   <http://lv2plug.in/ns/ext/log#> .\n\
+@prefix lv2:   <http://lv2plug.in/ns/lv2core#> .\n\
+@prefix midi:  <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
+@prefix pg:    <http://lv2plug.in/ns/ext/port-groups#> .\n\
+@prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
+@prefix rdf:   <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
+@prefix rdfs:  <http://www.w3.org/2000/01/rdf-schema#> .\n\
+@prefix rsz:   <http://lv2plug.in/ns/ext/resize-port#> .\n\
+@prefix time:  <http://lv2plug.in/ns/ext/time#> .\n\
+@prefix urid:  <http://lv2plug.in/ns/ext/urid#> .\n\
+@prefix ui:    <http://lv2plug.in/ns/extensions/ui#> .\n\
+@prefix units: <http://lv2plug.in/ns/extensions/units#> .\n\
+@prefix work:  <http://lv2plug.in/ns/ext/worker#> .\n\n");
+
+  fprintf (f,
+"<" PLUGIN_URI ">\n\
+  a lv2:Plugin,\n\
+    lv2:" PLUGIN_TYPE " ;\n\
+  doap:name \"" PLUGIN_NAME "\" ;\n\
+  doap:license <https://www.gnu.org/licenses/agpl-3.0.html> ;\n\
+  lv2:project <" PROJECT_URI "> ;\n\
+  lv2:requiredFeature urid:map ;\n\
+  lv2:optionalFeature log:log ,\n\
+                      lv2:hardRTCapable ;\n\
+  lv2:port [\n\
+    a lv2:InputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 0 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"control\" ;\n\
+    lv2:name \"Control\" ;\n\
+    rdfs:comment \"GUI/host to plugin communication\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 1 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"notify\" ;\n\
+    lv2:name \"Notify\" ;\n\
+    rdfs:comment \"Plugin to GUI communication\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 2 ;\n\
+    lv2:symbol \"stereo_in_l\" ;\n\
+    lv2:name \"Stereo In L\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 3 ;\n\
+    lv2:symbol \"stereo_in_r\" ;\n\
+    lv2:name \"Stereo In R\" ;\n\
+  ]");
+
+  /* default type, frequency and Q of each band */
+  const int def_types[EQ_NUM_BANDS] = {
+    EQ_BAND_LOW_SHELF, EQ_BAND_PEAK, EQ_BAND_PEAK,
+    EQ_BAND_PEAK, EQ_BAND_PEAK, EQ_BAND_HIGH_SHELF,
+  };
+  const double def_freqs[EQ_NUM_BANDS] = {
+    100.0, 250.0, 600.0, 1500.0, 4000.0, 10000.0,
+  };
+  const double def_qs[EQ_NUM_BANDS] = {
+    0.707, 1.0, 1.0, 1.0, 1.0, 0.707,
+  };
+  for (int i = 0; i < EQ_NUM_BANDS; i++)
+    {
+      int idx =
+        EQ_BAND1_TYPE + i * EQ_BAND_NUM_PORTS;
+      fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_type\" ;\n\
+    lv2:name \"Band %d Type\" ;\n\
+    lv2:default %d ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum 5 ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    lv2:portProperty lv2:enumeration ;\n\
+    lv2:scalePoint [ rdfs:label \"Off\"; rdf:value 0 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"Peak\"; rdf:value 1 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"Low shelf\"; rdf:value 2 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"High shelf\"; rdf:value 3 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"Low cut\"; rdf:value 4 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"High cut\"; rdf:value 5 ] ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_freq\" ;\n\
+    lv2:name \"Band %d Frequency\" ;\n\
+    lv2:default %f ;\n\
+    lv2:minimum 20.000000 ;\n\
+    lv2:maximum 20000.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:hz ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_gain\" ;\n\
+    lv2:name \"Band %d Gain\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum -24.000000 ;\n\
+    lv2:maximum 24.000000 ;\n\
+    units:unit units:db ;\n\
+    rdfs:comment \"Gain of peak and shelf bands\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_q\" ;\n\
+    lv2:name \"Band %d Q\" ;\n\
+    lv2:default %f ;\n\
+    lv2:minimum 0.100000 ;\n\
+    lv2:maximum 18.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+  ]",
+        idx, i + 1, i + 1, def_types[i],
+        idx + 1, i + 1, i + 1, def_freqs[i],
+        idx + 2, i + 1, i + 1,
+        idx + 3, i + 1, i + 1, def_qs[i]);
+    }
+
+  fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"output_gain\" ;\n\
+    lv2:name \"Output Gain\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum -24.000000 ;\n\
+    lv2:maximum 24.000000 ;\n\
+    units:unit units:db ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_l\" ;\n\
+    lv2:name \"Stereo Out L\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_r\" ;\n\
+    lv2:name \"Stereo Out R\" ;\n\
+  ]",
+    EQ_OUTPUT_GAIN, EQ_STEREO_OUT_L,
+    EQ_STEREO_OUT_R);
+
+  plugin_print_dsp_load_ttl (f, EQ_DSP_LOAD);
+  plugin_print_enabled_ttl (f, EQ_ENABLED);
+  plugin_print_params_ttl (
+    f, eq_params, EQ_NUM_PARAMS);
+}
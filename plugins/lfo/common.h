@@ -44,6 +44,10 @@
 #define DEF_FREQ 1.f
 #define MAX_FREQ 60.f
 
+/** Max number of samples between evaluations of
+ * the waveforms. */
+#define MAX_UPDATE_INTERVAL 64
+
 typedef struct LfoUris
 {
   /* custom URIs for communication */
@@ -148,6 +152,11 @@ typedef enum PortIndex
   LFO_SAW_OUT,
   LFO_SQUARE_OUT,
   LFO_CUSTOM_OUT,
+  /** Average DSP load of the plugin. */
+  LFO_DSP_LOAD,
+  /** Samples between evaluations of the
+   * waveforms, with linear ramps in between. */
+  LFO_UPDATE_INTERVAL,
   NUM_LFO_PORTS,
 } PortIndex;
 
@@ -162,55 +171,12 @@ typedef enum GridStep
   NUM_GRID_STEPS,
 } GridStep;
 
-typedef enum SyncRate
-{
-  SYNC_1_128,
-  SYNC_1_64,
-  SYNC_1_32,
-  SYNC_1_16,
-  SYNC_1_8,
-  SYNC_1_4,
-  SYNC_1_2,
-  SYNC_1_1,
-  SYNC_2_1,
-  SYNC_4_1,
-  SYNC_8_1,
-  SYNC_16_1,
-  SYNC_32_1,
-  SYNC_64_1,
-  SYNC_128_1,
-  NUM_SYNC_RATES,
-} SyncRate;
-
-typedef enum SyncRateType
-{
-  SYNC_TYPE_NORMAL,
-  SYNC_TYPE_DOTTED,
-  SYNC_TYPE_TRIPLET,
-  NUM_SYNC_RATE_TYPES,
-} SyncRateType;
-
 typedef enum CurveAlgorithm
 {
   CURVE_ALGORITHM_EXPONENT,
   CURVE_ALGORITHM_SUPERELLIPSE,
 } CurveAlgorithm;
 
-typedef struct HostPosition
-{
-  float     bpm;
-
-  /** Current global frame. */
-  long      frame;
-
-  /** Transport speed (0.0 is stopped, 1.0 is
-   * normal playback, -1.0 is reverse playback,
-   * etc.). */
-  float     speed;
-
-  int       beat_unit;
-} HostPosition;
-
 /**
  * Group of variables needed by both the DSP and
  * the UI.
@@ -293,48 +259,9 @@ update_position_from_atom_obj (
   LfoCommon *             lfo_common,
   const LV2_Atom_Object * obj)
 {
-  PluginUris * uris = &lfo_common->pl_common.uris;
-  HostPosition * host_pos = &lfo_common->host_pos;
-
-  /* Received new transport position/speed */
-  LV2_Atom *beat = NULL,
-           *bpm = NULL,
-           *beat_unit = NULL,
-           *speed = NULL,
-           *frame = NULL;
-  lv2_atom_object_get (
-    obj, uris->time_barBeat, &beat,
-    uris->time_beatUnit, &beat_unit,
-    uris->time_beatsPerMinute, &bpm,
-    uris->time_frame, &frame,
-    uris->time_speed, &speed, NULL);
-  if (bpm && bpm->type == uris->atom_Float)
-    {
-      /* Tempo changed, update BPM */
-      host_pos->bpm = ((LV2_Atom_Float*)bpm)->body;
-     }
-  if (speed && speed->type == uris->atom_Float)
-    {
-      /* Speed changed, e.g. 0 (stop) to 1 (play) */
-      host_pos->speed =
-        ((LV2_Atom_Float *) speed)->body;
-    }
-  if (beat_unit && beat_unit->type == uris->atom_Int)
-    {
-      host_pos->beat_unit =
-        ((LV2_Atom_Int *) beat_unit)->body;
-    }
-  if (frame && frame->type == uris->atom_Long)
-    {
-      host_pos->frame =
-        ((LV2_Atom_Int *) frame)->body;
-    }
-  if (beat && beat->type == uris->atom_Float)
-    {
-      /*const float bar_beats =*/
-        /*((LV2_Atom_Float *) beat)->body;*/
-      /*self->beat_offset = fmodf (bar_beats, 1.f);*/
-    }
+  plugin_update_host_position (
+    &lfo_common->pl_common.uris,
+    &lfo_common->host_pos, obj);
 }
 
 /**
@@ -44,6 +44,17 @@
 #define SAW_ON(x) (*x->saw_on > 0.001f)
 #define CUSTOM_ON(x) (*x->custom_on > 0.001f)
 
+/** Index of each waveform in value arrays. */
+typedef enum Waveform
+{
+  WAVEFORM_SINE,
+  WAVEFORM_SAW,
+  WAVEFORM_TRIANGLE,
+  WAVEFORM_SQUARE,
+  WAVEFORM_CUSTOM,
+  NUM_WAVEFORMS,
+} Waveform;
+
 typedef struct LFO
 {
   /** Plugin ports. */
@@ -72,6 +83,7 @@ typedef struct LFO
   const float * custom_on;
   const float * nodes[16][3];
   const float * num_nodes;
+  const float * update_interval;
 
   /* outputs */
   float *       cv_out;
@@ -88,9 +100,6 @@ typedef struct LFO
 
   LfoCommon    common;
 
-  /* FIXME this can be a local variable */
-  LV2_Atom_Forge_Frame notify_frame;
-
   /** Whether the UI is active or not. */
   int           ui_active;
 
@@ -166,6 +175,17 @@ recalc_multipliers (
       *self->sync_rate,
       *self->sync_rate_type);
 
+  /* if beat_unit is 0 that means we don't know the
+   * time info yet */
+  if (!IS_FREERUN (self) &&
+      self->common.host_pos.beat_unit == 0)
+    {
+      plugin_trace (
+        &self->common.pl_common, Warning,
+        "Host did not send time info. Beat "
+        "unit is unknown.\n");
+    }
+
   /**
    * Effective frequency.
    *
@@ -291,6 +311,13 @@ connect_port (
     case LFO_NUM_NODES:
       self->num_nodes = (float *) data;
       break;
+    case LFO_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case LFO_UPDATE_INTERVAL:
+      self->update_interval = (const float *) data;
+      break;
     default:
       break;
     }
@@ -362,17 +389,10 @@ send_messages_to_ui (
 {
   PluginCommon * pl_common = &self->common.pl_common;
 
-  /* set up forge to write directly to notify
-   * output port */
-  const uint32_t notify_capacity =
-    self->notify->atom.size;
-  lv2_atom_forge_set_buffer (
-    &pl_common->forge, (uint8_t*) self->notify,
-    notify_capacity);
-
-  /* start a sequence in the notify output port */
-  lv2_atom_forge_sequence_head (
-    &pl_common->forge, &self->notify_frame, 0);
+  /* the sequence in the notify output port is
+   * opened by plugin_run_begin() */
+  if (!pl_common->notify_open)
+    return;
 
   /* forge container object of type "ui_state" */
   lv2_atom_forge_frame_time (&pl_common->forge, 0);
@@ -439,6 +459,159 @@ activate (
   recalc_multipliers (self);
 }
 
+/**
+ * Calculates the value of each waveform at the
+ * given sample of the period, from -1 to 1.
+ *
+ * Waveforms that are off are set to 0.
+ */
+static void
+compute_values (
+  LFO *              self,
+  long               current_sample,
+  long               step_frames,
+  NodeIndexElement * node_indices,
+  float *            vals)
+{
+  /* invert horizontally */
+  long shifted_current_sample =
+    invert_and_shift_xval (
+      current_sample,
+      self->common.period_size,
+      *self->hinvert >= 0.01f,
+      *self->shift);
+
+  if (IS_STEP_MODE (self))
+    {
+      /* find closest step and set the current
+       * sample to the middle of it */
+      shifted_current_sample =
+        (shifted_current_sample / step_frames) *
+          step_frames +
+        step_frames / 2;
+    }
+
+  float ratio =
+     (float) shifted_current_sample /
+     (float) self->common.period_size;
+
+  for (int i = 0; i < NUM_WAVEFORMS; i++)
+    vals[i] = 0.f;
+
+  if (SINE_ON (self))
+    {
+      /* calculate sine */
+      vals[WAVEFORM_SINE] =
+        sinf (
+          ((float) shifted_current_sample *
+              self->common.sine_multiplier));
+    }
+  if (SAW_ON (self))
+    {
+      /* calculate saw */
+      vals[WAVEFORM_SAW] =
+        (1.f - ratio) * 2.f - 1.f;
+    }
+  if (TRIANGLE_ON (self))
+    {
+      if (ratio > 0.4999f)
+        {
+          vals[WAVEFORM_TRIANGLE] =
+            (1.f - ratio) * 4.f - 1.f;
+        }
+      else
+        {
+          vals[WAVEFORM_TRIANGLE] =
+            ratio * 4.f - 1.f;
+        }
+    }
+  if (SQUARE_ON (self))
+    {
+      if (ratio > 0.4999f)
+        {
+          vals[WAVEFORM_SQUARE] = - 1.f;
+        }
+      else
+        {
+          vals[WAVEFORM_SQUARE] = 1.f;
+        }
+    }
+  if (CUSTOM_ON (self))
+    {
+      int prev_idx =
+        get_prev_idx (
+          node_indices, (int) * self->num_nodes,
+          (float) ratio);
+      int next_idx =
+        get_next_idx (
+          node_indices, (int) * self->num_nodes,
+          (float) ratio);
+
+      /* calculate custom */
+      vals[WAVEFORM_CUSTOM] =
+        get_custom_val_at_x (
+          *self->nodes[prev_idx][0],
+          *self->nodes[prev_idx][1],
+          *self->nodes[prev_idx][2],
+          next_idx < 0 ? 1.f :
+            *self->nodes[next_idx][0],
+          next_idx < 0 ?
+            *self->nodes[0][1] :
+            *self->nodes[next_idx][1],
+          next_idx < 0 ?
+            *self->nodes[0][2] :
+            *self->nodes[next_idx][2],
+          shifted_current_sample,
+          self->common.period_size);
+
+      /* adjust for -1 to 1 */
+      vals[WAVEFORM_CUSTOM] =
+        vals[WAVEFORM_CUSTOM] * 2 - 1;
+    }
+
+  /* invert vertically */
+  if (*self->vinvert >= 0.01f)
+    {
+      for (int i = 0; i < NUM_WAVEFORMS; i++)
+        vals[i] = - vals[i];
+    }
+}
+
+/**
+ * Returns the sample in the period after moving
+ * the given number of samples forward.
+ */
+static inline long
+advance_sample (
+  LFO *    self,
+  long     current_sample,
+  uint32_t nframes)
+{
+  current_sample += (long) nframes;
+  if (self->common.period_size > 0 &&
+      current_sample >= self->common.period_size)
+    current_sample %= self->common.period_size;
+
+  return current_sample;
+}
+
+/**
+ * Returns the number of samples between
+ * evaluations of the waveforms.
+ */
+static inline uint32_t
+get_update_interval (
+  LFO * self)
+{
+  if (!self->update_interval)
+    return 1;
+
+  int interval =
+    math_round_float_to_int (*self->update_interval);
+  return
+    (uint32_t) CLAMP (interval, 1, MAX_UPDATE_INTERVAL);
+}
+
 static void
 run (
   LV2_Handle instance,
@@ -453,6 +626,9 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
   int xport_changed = 0;
 
   /* read incoming events from host and UI */
@@ -505,8 +681,9 @@ run (
       sync_or_freerun_mode_changed)
     {
 #if 0
-      fprintf (
-        stderr, "xport %d freq %d sync %d\n",
+      plugin_trace (
+        &self->common.pl_common, Trace,
+        "xport %.0f freq %.0f sync %.0f\n",
         xport_changed, freq_changed,
         sync_or_freerun_mode_changed);
 #endif
@@ -549,162 +726,131 @@ run (
       self->common.current_sample = 0;
     }
 
-  for (uint32_t i = 0; i < n_samples; i++)
+  int is_running =
+    is_freerunning ||
+    self->common.host_pos.speed > 0.00001f;
+  uint32_t interval = get_update_interval (self);
+  int gate_always_open =
+    !IS_GATED_MODE (self) || IS_GATED (self);
+  float * outs[NUM_WAVEFORMS] = {
+    self->sine_out, self->saw_out,
+    self->triangle_out, self->square_out,
+    self->custom_out };
+
+  /* split the block at CV triggers so that they
+   * reset the phase on their exact sample. with an
+   * update interval, the waveforms are evaluated
+   * every interval samples and ramped linearly in
+   * between, while the phase still moves 1 sample
+   * at a time */
+  float vals[NUM_WAVEFORMS];
+  float next_vals[NUM_WAVEFORMS];
+  int have_vals = 0;
+  for (uint32_t i = 0; i < n_samples;)
     {
       /* handle cv trigger */
       if (self->cv_trigger[i] > 0.00001f)
-        self->common.current_sample = 0;
-
-      /* invert horizontally */
-      long shifted_current_sample =
-        invert_and_shift_xval (
-          self->common.current_sample,
-          self->common.period_size,
-          *self->hinvert >= 0.01f,
-          *self->shift);
-
-      if (IS_STEP_MODE (self))
         {
-          /* find closest step and set the current
-           * sample to the middle of it */
-          shifted_current_sample =
-            (shifted_current_sample / step_frames) *
-              step_frames +
-            step_frames / 2;
+          self->common.current_sample = 0;
+          have_vals = 0;
         }
 
-      float ratio =
-         (float) shifted_current_sample /
-         (float) self->common.period_size;
-
-      if (SINE_ON (self))
-        {
-          /* calculate sine */
-          self->sine_out[i] =
-            sinf (
-              ((float) shifted_current_sample *
-                  self->common.sine_multiplier));
-        }
-      if (SAW_ON (self))
-        {
-          /* calculate saw */
-          self->saw_out[i] =
-            (1.f - ratio) * 2.f - 1.f;
-        }
-      if (TRIANGLE_ON (self))
+      uint32_t len =
+        interval > 1 ?
+          MIN (interval, n_samples - i) :
+          n_samples - i;
+      for (uint32_t j = 1; j < len; j++)
         {
-          if (ratio > 0.4999f)
-            {
-              self->triangle_out[i] =
-                (1.f - ratio) * 4.f - 1.f;
-            }
-          else
+          if (self->cv_trigger[i + j] > 0.00001f)
             {
-              self->triangle_out[i] =
-                ratio * 4.f - 1.f;
+              len = j;
+              break;
             }
         }
-      if (SQUARE_ON (self))
+
+      if (interval > 1)
         {
-          if (ratio > 0.4999f)
+          if (!have_vals)
             {
-              self->square_out[i] = - 1.f;
+              compute_values (
+                self, self->common.current_sample,
+                step_frames, node_indices, vals);
             }
-          else
+          self->common.current_sample =
+            advance_sample (
+              self, self->common.current_sample,
+              is_running ? len : 0);
+          compute_values (
+            self, self->common.current_sample,
+            step_frames, node_indices, next_vals);
+
+          for (int w = 0; w < NUM_WAVEFORMS; w++)
             {
-              self->square_out[i] = 1.f;
+              float start = vals[w];
+              float step =
+                (next_vals[w] - start) / (float) len;
+              float * out = &outs[w][i];
+              for (uint32_t j = 0; j < len; j++)
+                {
+                  out[j] = start + step * (float) j;
+                }
             }
+
+          /* the end of this segment is the start
+           * of the next one */
+          memcpy (vals, next_vals, sizeof (vals));
+          have_vals = 1;
         }
-      if (CUSTOM_ON (self))
+      else
         {
-          int prev_idx =
-            get_prev_idx (
-              node_indices, (int) * self->num_nodes,
-              (float) ratio);
-          int next_idx =
-            get_next_idx (
-              node_indices, (int) * self->num_nodes,
-              (float) ratio);
-
-          /* calculate custom */
-          self->custom_out[i] =
-            get_custom_val_at_x (
-              *self->nodes[prev_idx][0],
-              *self->nodes[prev_idx][1],
-              *self->nodes[prev_idx][2],
-              next_idx < 0 ? 1.f :
-                *self->nodes[next_idx][0],
-              next_idx < 0 ?
-                *self->nodes[0][1] :
-                *self->nodes[next_idx][1],
-              next_idx < 0 ?
-                *self->nodes[0][2] :
-                *self->nodes[next_idx][2],
-              shifted_current_sample,
-              self->common.period_size);
-
-          /* adjust for -1 to 1 */
-          self->custom_out[i] =
-            self->custom_out[i] * 2 - 1;
+          for (uint32_t j = i; j < i + len; j++)
+            {
+              compute_values (
+                self, self->common.current_sample,
+                step_frames, node_indices, vals);
+              for (int w = 0; w < NUM_WAVEFORMS; w++)
+                {
+                  outs[w][j] = vals[w];
+                }
+              self->common.current_sample =
+                advance_sample (
+                  self, self->common.current_sample,
+                  is_running ? 1 : 0);
+            }
         }
 
-      /* invert vertically */
-      if (*self->vinvert >= 0.01f)
+      for (int w = 0; w < NUM_WAVEFORMS; w++)
         {
-#define INVERT(x) \
-  self->x##_out[i] = - self->x##_out[i]
-
-          INVERT (sine);
-          INVERT (saw);
-          INVERT (triangle);
-          INVERT (square);
-          INVERT (custom);
-
-#undef INVERT
-        }
+          float * out = &outs[w][i];
+          const float * cv_gate = &self->cv_gate[i];
+          if (!gate_always_open)
+            {
+              /* if in gating mode and gate is not
+               * active, set all output to zero */
+              for (uint32_t j = 0; j < len; j++)
+                {
+                  out[j] =
+                    cv_gate[j] > 0.001f ? out[j] : 0.f;
+                }
+            }
 
-      /* if in gating mode and gate is not active,
-       * set all output to zero */
-      if (IS_GATED_MODE (self) &&
-          !(IS_GATED (self) || self->cv_gate[i] > 0.001f))
-        {
-          self->sine_out[i] = 0.f;
-          self->saw_out[i] = 0.f;
-          self->triangle_out[i] = 0.f;
-          self->square_out[i] = 0.f;
-          self->custom_out[i] = 0.f;
+          /* adjust range */
+          for (uint32_t j = 0; j < len; j++)
+            {
+              out[j] =
+                min_range +
+                ((out[j] + 1.f) / 2.f) * range;
+            }
         }
 
-      /* adjust range */
-#define ADJUST_RANGE(x) \
-  self->x##_out[i] = \
-    min_range + \
-    ((self->x##_out[i] + 1.f) / 2.f) * range
-
-      ADJUST_RANGE (sine);
-      ADJUST_RANGE (saw);
-      ADJUST_RANGE (triangle);
-      ADJUST_RANGE (square);
-      ADJUST_RANGE (custom);
-
-#undef ADJUST_RANGE
-
-      if (is_freerunning ||
-          (!is_freerunning &&
-           self->common.host_pos.speed >
-             0.00001f))
-        {
-          self->common.current_sample++;
-        }
-      if (self->common.current_sample ==
-            self->common.period_size)
-        self->common.current_sample = 0;
+      i += len;
     }
 #if 0
-  fprintf (
-    stderr, "current sample %ld, "
-    "period size%ld\n",
-    self->current_sample, self->period_size);
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "current sample %.0f, period size %.0f\n",
+    self->common.current_sample,
+    self->common.period_size);
 #endif
 
   if (self->ui_active &&
@@ -733,6 +879,9 @@ run (
   self->last_period_size =
     self->common.period_size;
   self->last_samplerate = GET_SAMPLERATE (self);
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -745,7 +894,9 @@ static void
 cleanup (
   LV2_Handle instance)
 {
-  free (instance);
+  LFO * self = (LFO *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
 }
 
 static const void*
@@ -33,80 +33,6 @@
 
 #include "common.h"
 
-static inline float
-sync_rate_to_float (
-  SyncRate     rate,
-  SyncRateType type)
-{
-  float r = 0.01f;
-  switch (rate)
-    {
-    case SYNC_1_128:
-      r = 1.f / 128.f;
-      break;
-    case SYNC_1_64:
-      r = 1.f / 64.f;
-      break;
-    case SYNC_1_32:
-      r = 1.f / 32.f;
-      break;
-    case SYNC_1_16:
-      r = 1.f / 16.f;
-      break;
-    case SYNC_1_8:
-      r = 1.f / 8.f;
-      break;
-    case SYNC_1_4:
-      r = 1.f / 4.f;
-      break;
-    case SYNC_1_2:
-      r = 1.f / 2.f;
-      break;
-    case SYNC_1_1:
-      r = 1.f;
-      break;
-    case SYNC_2_1:
-      r = 2.f;
-      break;
-    case SYNC_4_1:
-      r = 4.f;
-      break;
-    case SYNC_8_1:
-      r = 8.f;
-      break;
-    case SYNC_16_1:
-      r = 16.f;
-      break;
-    case SYNC_32_1:
-      r = 32.f;
-      break;
-    case SYNC_64_1:
-      r = 64.f;
-      break;
-    case SYNC_128_1:
-      r = 128.f;
-      break;
-    default:
-      break;
-    }
-
-  switch (type)
-    {
-    case SYNC_TYPE_NORMAL:
-      break;
-    case SYNC_TYPE_DOTTED:
-      r *= 1.5f;
-      break;
-    case SYNC_TYPE_TRIPLET:
-      r *= (2.f / 3.f);
-      break;
-    default:
-      break;
-    }
-
-  return r;
-}
-
 /**
  * Returns the number to use for dividing by the
  * grid step.
@@ -211,13 +137,6 @@ get_effective_freq (
    * time info yet */
   if (freerunning || host_pos->beat_unit == 0)
     {
-      if (!freerunning && host_pos->beat_unit == 0)
-        {
-          fprintf (
-            stderr,
-            "Host did not send time info. Beat "
-            "unit is unknown.\n");
-        }
       return freq;
     }
   else /* synced */
@@ -243,13 +162,6 @@ get_period_size (
    * time info yet */
   if (freerunning || host_pos->beat_unit == 0)
     {
-      if (!freerunning && host_pos->beat_unit == 0)
-        {
-          fprintf (
-            stderr,
-            "Host did not send time info. Beat "
-            "unit is unknown.\n");
-        }
       return
         (uint32_t) (samplerate / effective_freq);
     }
@@ -276,10 +188,6 @@ get_current_sample (
     {
       /* if beat_unit is 0 that means we don't
        * know the time info yet */
-      fprintf (
-        stderr,
-        "Host did not send time info. Beat "
-        "unit is unknown.\n");
       return 0;
     }
   else /* synced */
@@ -450,13 +450,36 @@ print_ttl (FILE * f)
     lv2:name \"Custom\" ;\n\
     lv2:minimum %f ;\n\
     lv2:maximum %f ;\n\
-  ] .\n\n",
+  ]",
     LFO_SINE_OUT, -1.0, 1.0,
     LFO_TRIANGLE_OUT, -1.0, 1.0,
     LFO_SAW_OUT, -1.0, 1.0,
     LFO_SQUARE_OUT,  -1.0, 1.0,
     LFO_CUSTOM_OUT, -1.0, 1.0);
 
+  plugin_print_dsp_load_ttl (f, LFO_DSP_LOAD);
+  fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"update_interval\" ;\n\
+    lv2:name \"Update interval\" ;\n\
+    rdfs:comment \"Samples between evaluations of the waveforms, with linear ramps in between. Longer intervals use less CPU\" ;\n\
+    units:unit units:frame ;\n\
+    lv2:default 1 ;\n\
+    lv2:minimum 1 ;\n\
+    lv2:maximum %d ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    lv2:portProperty lv2:enumeration ;\n\
+    lv2:scalePoint [ rdfs:label \"Audio rate\"; rdf:value 1 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"16 samples\"; rdf:value 16 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"32 samples\"; rdf:value 32 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"64 samples\"; rdf:value 64 ] ;\n\
+  ]",
+    LFO_UPDATE_INTERVAL, MAX_UPDATE_INTERVAL);
+  fprintf (f, " .\n\n");
+
   /* write UI */
   fprintf (f,
 "<" PLUGIN_UI_URI ">\n\
@@ -50,10 +50,31 @@ typedef enum PortIndex
   /** Outputs. */
   LIMITER_STEREO_OUT_L,
   LIMITER_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  LIMITER_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  LIMITER_ENABLED,
 
   NUM_PORTS,
 } PortIndex;
 
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo limiter_params[] = {
+  { LIMITER_ATTACK, "attack",
+    "Attack", 0.000001f, 1.f },
+  { LIMITER_RELEASE, "release",
+    "Release", 0.000001f, 1.f },
+  { LIMITER_THRESHOLD, "threshold",
+    "Threshold", -40.f, 3.f },
+};
+
+#define LIMITER_NUM_PARAMS \
+  ((int) (sizeof (limiter_params) / \
+          sizeof (limiter_params[0])))
+
 /**
  * Group of variables needed by both the DSP and
  * the UI.
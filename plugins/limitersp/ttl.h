@@ -26,6 +26,7 @@ print_ttl (FILE * f)
 @prefix log:  <http://lv2plug.in/ns/ext/log#> .\n\
 @prefix lv2:  <http://lv2plug.in/ns/lv2core#> .\n\
 @prefix midi: <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
 @prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
 @prefix rdf:  <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
 @prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n\
@@ -123,11 +124,16 @@ print_ttl (FILE * f)
     lv2:index 8 ;\n\
     lv2:symbol \"stereo_out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n",
+  ]",
     /* attack */
     0.01, 0.000001, 1.0,
     /* release */
     0.1, 0.000001, 1.0,
     /* threshold */
     0.0, -40.0, 3.0);
+
+  plugin_print_dsp_load_ttl (f, LIMITER_DSP_LOAD);
+  plugin_print_enabled_ttl (f, LIMITER_ENABLED);
+  plugin_print_params_ttl (
+    f, limiter_params, LIMITER_NUM_PARAMS);
 }
@@ -28,6 +28,7 @@
 
 #include <float.h>
 #include <math.h>
+#include <stdint.h>
 
 #ifndef M_PI
 # define M_PI 3.14159265358979323846
@@ -41,6 +42,15 @@ double pow (double dummy0, double dummy1);
 #ifndef sinf
 float sinf (float dummy0);
 #endif
+#ifndef exp
+double exp (double dummy0);
+#endif
+#ifndef fmod
+double fmod (double dummy0, double dummy1);
+#endif
+#ifndef fabsf
+float fabsf (float dummy0);
+#endif
 
 static const float PI = (float) M_PI;
 
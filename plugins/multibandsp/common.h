@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_MULTIBAND_COMMON_H__
+#define __Z_MULTIBAND_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include "../common.h"
+
+/** Number of bands. */
+#define MULTIBAND_NUM_BANDS 4
+
+/** Number of input ports of each band. */
+#define MULTIBAND_BAND_NUM_PORTS 5
+
+typedef struct MultibandUris
+{
+} MultibandUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  MULTIBAND_CONTROL,
+  /** Plugin to UI communication. */
+  MULTIBAND_NOTIFY,
+
+  MULTIBAND_STEREO_IN_L,
+  MULTIBAND_STEREO_IN_R,
+
+  /** Crossover frequencies, from low to high. */
+  MULTIBAND_XOVER_LOW,
+  MULTIBAND_XOVER_MID,
+  MULTIBAND_XOVER_HIGH,
+
+  /** Band ports, MULTIBAND_BAND_NUM_PORTS per band
+   * in this order. */
+  MULTIBAND_BAND1_THRESHOLD,
+  MULTIBAND_BAND1_RATIO,
+  MULTIBAND_BAND1_ATTACK,
+  MULTIBAND_BAND1_RELEASE,
+  MULTIBAND_BAND1_MAKEUP,
+  MULTIBAND_BAND2_THRESHOLD,
+  MULTIBAND_BAND2_RATIO,
+  MULTIBAND_BAND2_ATTACK,
+  MULTIBAND_BAND2_RELEASE,
+  MULTIBAND_BAND2_MAKEUP,
+  MULTIBAND_BAND3_THRESHOLD,
+  MULTIBAND_BAND3_RATIO,
+  MULTIBAND_BAND3_ATTACK,
+  MULTIBAND_BAND3_RELEASE,
+  MULTIBAND_BAND3_MAKEUP,
+  MULTIBAND_BAND4_THRESHOLD,
+  MULTIBAND_BAND4_RATIO,
+  MULTIBAND_BAND4_ATTACK,
+  MULTIBAND_BAND4_RELEASE,
+  MULTIBAND_BAND4_MAKEUP,
+
+  /** Outputs. */
+  MULTIBAND_STEREO_OUT_L,
+  MULTIBAND_STEREO_OUT_R,
+
+  /** Gain reduction of each band, in dB. */
+  MULTIBAND_BAND1_GR,
+  MULTIBAND_BAND2_GR,
+  MULTIBAND_BAND3_GR,
+  MULTIBAND_BAND4_GR,
+  /** Average DSP load of the plugin. */
+  MULTIBAND_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  MULTIBAND_ENABLED,
+
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo multiband_params[] = {
+  { MULTIBAND_XOVER_LOW, "xover_low",
+    "Low Crossover", 20.f, 20000.f },
+  { MULTIBAND_XOVER_MID, "xover_mid",
+    "Mid Crossover", 20.f, 20000.f },
+  { MULTIBAND_XOVER_HIGH, "xover_high",
+    "High Crossover", 20.f, 20000.f },
+  { MULTIBAND_BAND1_THRESHOLD, "band1_threshold",
+    "Band 1 Threshold", -80.f, 0.f },
+  { MULTIBAND_BAND1_RATIO, "band1_ratio",
+    "Band 1 Ratio", 1.f, 40.f },
+  { MULTIBAND_BAND1_ATTACK, "band1_attack",
+    "Band 1 Attack", 0.000001f, 10.f },
+  { MULTIBAND_BAND1_RELEASE, "band1_release",
+    "Band 1 Release", 0.000001f, 10.f },
+  { MULTIBAND_BAND1_MAKEUP, "band1_makeup",
+    "Band 1 Makeup", 0.f, 24.f },
+  { MULTIBAND_BAND2_THRESHOLD, "band2_threshold",
+    "Band 2 Threshold", -80.f, 0.f },
+  { MULTIBAND_BAND2_RATIO, "band2_ratio",
+    "Band 2 Ratio", 1.f, 40.f },
+  { MULTIBAND_BAND2_ATTACK, "band2_attack",
+    "Band 2 Attack", 0.000001f, 10.f },
+  { MULTIBAND_BAND2_RELEASE, "band2_release",
+    "Band 2 Release", 0.000001f, 10.f },
+  { MULTIBAND_BAND2_MAKEUP, "band2_makeup",
+    "Band 2 Makeup", 0.f, 24.f },
+  { MULTIBAND_BAND3_THRESHOLD, "band3_threshold",
+    "Band 3 Threshold", -80.f, 0.f },
+  { MULTIBAND_BAND3_RATIO, "band3_ratio",
+    "Band 3 Ratio", 1.f, 40.f },
+  { MULTIBAND_BAND3_ATTACK, "band3_attack",
+    "Band 3 Attack", 0.000001f, 10.f },
+  { MULTIBAND_BAND3_RELEASE, "band3_release",
+    "Band 3 Release", 0.000001f, 10.f },
+  { MULTIBAND_BAND3_MAKEUP, "band3_makeup",
+    "Band 3 Makeup", 0.f, 24.f },
+  { MULTIBAND_BAND4_THRESHOLD, "band4_threshold",
+    "Band 4 Threshold", -80.f, 0.f },
+  { MULTIBAND_BAND4_RATIO, "band4_ratio",
+    "Band 4 Ratio", 1.f, 40.f },
+  { MULTIBAND_BAND4_ATTACK, "band4_attack",
+    "Band 4 Attack", 0.000001f, 10.f },
+  { MULTIBAND_BAND4_RELEASE, "band4_release",
+    "Band 4 Release", 0.000001f, 10.f },
+  { MULTIBAND_BAND4_MAKEUP, "band4_makeup",
+    "Band 4 Makeup", 0.f, 24.f },
+};
+
+#define MULTIBAND_NUM_PARAMS \
+  ((int) (sizeof (multiband_params) / \
+          sizeof (multiband_params[0])))
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct MultibandCommon
+{
+  /** URIs. */
+  MultibandUris  uris;
+
+  PluginCommon    pl_common;
+
+} MultibandCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map*     urid_map,
+  MultibandCommon * multiband_common)
+{
+  map_common_uris (
+    urid_map, &multiband_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  multiband_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+
+#undef MAP
+}
+
+#endif
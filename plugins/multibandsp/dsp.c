@@ -0,0 +1,363 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+typedef struct MultibandBand
+{
+  /** Band ports. */
+  const float * threshold;
+  const float * ratio;
+  const float * attack;
+  const float * release;
+  const float * makeup;
+
+  /** Gain reduction output. */
+  float *       gr;
+} MultibandBand;
+
+typedef struct Multiband
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * stereo_in_l;
+  const float * stereo_in_r;
+  const float * xover[MULTIBAND_NUM_BANDS - 1];
+
+  MultibandBand bands[MULTIBAND_NUM_BANDS];
+
+  /* outputs */
+  float *       stereo_out_l;
+  float *       stereo_out_r;
+
+  MultibandCommon common;
+
+  sp_data *     sp;
+  sp_mbcomp *   mbcomp;
+
+} Multiband;
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  Multiband * self = calloc (1, sizeof (Multiband));
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 0);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, multiband_params, MULTIBAND_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, NULL, NULL))
+    goto fail;
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  return (LV2_Handle) self;
+
+fail:
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  Multiband * self = (Multiband *) instance;
+
+  if (port >= MULTIBAND_BAND1_THRESHOLD &&
+      port < MULTIBAND_STEREO_OUT_L)
+    {
+      uint32_t idx = port - MULTIBAND_BAND1_THRESHOLD;
+      MultibandBand * band =
+        &self->bands[idx / MULTIBAND_BAND_NUM_PORTS];
+      switch (idx % MULTIBAND_BAND_NUM_PORTS)
+        {
+        case 0:
+          band->threshold =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 1:
+          band->ratio =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 2:
+          band->attack =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 3:
+          band->release =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        case 4:
+          band->makeup =
+            plugin_params_connect (
+              &self->common.pl_common, port, data);
+          break;
+        }
+      return;
+    }
+  if (port >= MULTIBAND_BAND1_GR &&
+      port <= MULTIBAND_BAND4_GR)
+    {
+      self->bands[port - MULTIBAND_BAND1_GR].gr =
+        (float *) data;
+      return;
+    }
+
+  switch ((PortIndex) port)
+    {
+    case MULTIBAND_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case MULTIBAND_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case MULTIBAND_STEREO_IN_L:
+      self->stereo_in_l = (const float *) data;
+      break;
+    case MULTIBAND_STEREO_IN_R:
+      self->stereo_in_r = (const float *) data;
+      break;
+    case MULTIBAND_XOVER_LOW:
+    case MULTIBAND_XOVER_MID:
+    case MULTIBAND_XOVER_HIGH:
+      self->xover[port - MULTIBAND_XOVER_LOW] =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case MULTIBAND_STEREO_OUT_L:
+      self->stereo_out_l = (float *) data;
+      break;
+    case MULTIBAND_STEREO_OUT_R:
+      self->stereo_out_r = (float *) data;
+      break;
+    case MULTIBAND_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case MULTIBAND_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  Multiband * self = (Multiband*) instance;
+
+  sp_create (&self->sp);
+  self->sp->sr = (int) GET_SAMPLERATE (self);
+  sp_mbcomp_create (&self->mbcomp);
+  sp_mbcomp_init (self->sp, self->mbcomp);
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Multiband * self = (Multiband *) user_data;
+
+  /* keep the crossovers in order */
+  float xover_min = 20.f;
+  for (int i = 0; i < MULTIBAND_NUM_BANDS - 1; i++)
+    {
+      self->mbcomp->freq[i] =
+        MAX (*self->xover[i], xover_min);
+      xover_min = self->mbcomp->freq[i];
+    }
+  for (int i = 0; i < MULTIBAND_NUM_BANDS; i++)
+    {
+      MultibandBand * band = &self->bands[i];
+      self->mbcomp->thresh[i] = *band->threshold;
+      self->mbcomp->ratio[i] = *band->ratio;
+      self->mbcomp->atk[i] = *band->attack;
+      self->mbcomp->rel[i] = *band->release;
+      self->mbcomp->makeup[i] = *band->makeup;
+    }
+
+  sp_mbcomp_compute_block (
+    self->sp, self->mbcomp,
+    (float *) &self->stereo_in_l[offset],
+    (float *) &self->stereo_in_r[offset],
+    &self->stereo_out_l[offset],
+    &self->stereo_out_r[offset], nframes);
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Multiband * self = (Multiband *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  int bypassed =
+    plugin_bypass_begin (
+      pl_common, in, out, n_samples);
+  if (bypassed)
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+  for (int i = 0; i < MULTIBAND_NUM_BANDS; i++)
+    {
+      if (self->bands[i].gr)
+        {
+          *self->bands[i].gr =
+            bypassed ? 0.f : self->mbcomp->gr[i];
+        }
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+  Multiband * self = (Multiband *) instance;
+
+  sp_destroy (&self->sp);
+  sp_mbcomp_destroy (&self->mbcomp);
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  Multiband * self = (Multiband *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+static void
+print_ttl (FILE * f)
+{
+  fprintf (f,
+"@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n\
+@prefix doap:  <http://usefulinc.com/ns/doap#> .\n\
+@prefix log:   <http://lv2plug.in/ns/ext/log#> .\n\
+@prefix lv2:   <http://lv2plug.in/ns/lv2core#> .\n\
+@prefix midi:  <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
+@prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
+@prefix rdf:   <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
+@prefix rdfs:  <http://www.w3.org/2000/01/rdf-schema#> .\n\
+@prefix rsz:   <http://lv2plug.in/ns/ext/resize-port#> .\n\
+@prefix time:  <http://lv2plug.in/ns/ext/time#> .\n\
+@prefix urid:  <http://lv2plug.in/ns/ext/urid#> .\n\
+@prefix ui:    <http://lv2plug.in/ns/extensions/ui#> .\n\
+@prefix units: <http://lv2plug.in/ns/extensions/units#> .\n\
+@prefix work:  <http://lv2plug.in/ns/ext/worker#> .\n\n");
+
+  fprintf (f,
+"<" PLUGIN_URI ">\n\
+  a lv2:Plugin,\n\
+    lv2:" PLUGIN_TYPE " ;\n\
+  doap:name \"" PLUGIN_NAME "\" ;\n\
+  doap:license <https://www.gnu.org/licenses/agpl-3.0.html> ;\n\
+  lv2:project <" PROJECT_URI "> ;\n\
+  lv2:requiredFeature urid:map ;\n\
+  lv2:optionalFeature log:log ,\n\
+                      lv2:hardRTCapable ;\n\
+  lv2:port [\n\
+    a lv2:InputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 0 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"control\" ;\n\
+    lv2:name \"Control\" ;\n\
+    rdfs:comment \"GUI/host to plugin communication\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 1 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"notify\" ;\n\
+    lv2:name \"Notify\" ;\n\
+    rdfs:comment \"Plugin to GUI communication\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 2 ;\n\
+    lv2:symbol \"stereo_in_l\" ;\n\
+    lv2:name \"Stereo In L\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 3 ;\n\
+    lv2:symbol \"stereo_in_r\" ;\n\
+    lv2:name \"Stereo In R\" ;\n\
+  ]");
+
+  /* crossover frequencies */
+  const char * xover_names[MULTIBAND_NUM_BANDS - 1] = {
+    "low", "mid", "high",
+  };
+  const char * xover_labels[MULTIBAND_NUM_BANDS - 1] = {
+    "Low", "Mid", "High",
+  };
+  const double def_xovers[MULTIBAND_NUM_BANDS - 1] = {
+    200.0, 1000.0, 5000.0,
+  };
+  for (int i = 0; i < MULTIBAND_NUM_BANDS - 1; i++)
+    {
+      fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"xover_%s\" ;\n\
+    lv2:name \"%s Crossover\" ;\n\
+    lv2:default %f ;\n\
+    lv2:minimum 20.000000 ;\n\
+    lv2:maximum 20000.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:hz ;\n\
+    rdfs:comment \"Crossover frequency between two adjacent bands\" ;\n\
+  ]",
+        MULTIBAND_XOVER_LOW + i, xover_names[i],
+        xover_labels[i], def_xovers[i]);
+    }
+
+  for (int i = 0; i < MULTIBAND_NUM_BANDS; i++)
+    {
+      int idx =
+        MULTIBAND_BAND1_THRESHOLD +
+        i * MULTIBAND_BAND_NUM_PORTS;
+      fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_threshold\" ;\n\
+    lv2:name \"Band %d Threshold\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum -80.000000 ;\n\
+    lv2:maximum 0.000000 ;\n\
+    units:unit units:db ;\n\
+    rdfs:comment \"Threshold (0 = max)\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_ratio\" ;\n\
+    lv2:name \"Band %d Ratio\" ;\n\
+    lv2:default 1.000000 ;\n\
+    lv2:minimum 1.000000 ;\n\
+    lv2:maximum 40.000000 ;\n\
+    rdfs:comment \"Ratio to compress with. A value > 1 will compress\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_attack\" ;\n\
+    lv2:name \"Band %d Attack\" ;\n\
+    lv2:default 0.010000 ;\n\
+    lv2:minimum 0.000001 ;\n\
+    lv2:maximum 10.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:s ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_release\" ;\n\
+    lv2:name \"Band %d Release\" ;\n\
+    lv2:default 0.100000 ;\n\
+    lv2:minimum 0.000001 ;\n\
+    lv2:maximum 10.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:s ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_makeup\" ;\n\
+    lv2:name \"Band %d Makeup\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum 0.000000 ;\n\
+    lv2:maximum 24.000000 ;\n\
+    units:unit units:db ;\n\
+  ]",
+        idx, i + 1, i + 1,
+        idx + 1, i + 1, i + 1,
+        idx + 2, i + 1, i + 1,
+        idx + 3, i + 1, i + 1,
+        idx + 4, i + 1, i + 1);
+    }
+
+  fprintf (f,
+" , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_l\" ;\n\
+    lv2:name \"Stereo Out L\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"stereo_out_r\" ;\n\
+    lv2:name \"Stereo Out R\" ;\n\
+  ]",
+    MULTIBAND_STEREO_OUT_L, MULTIBAND_STEREO_OUT_R);
+
+  for (int i = 0; i < MULTIBAND_NUM_BANDS; i++)
+    {
+      fprintf (f,
+" , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"band%d_gr\" ;\n\
+    lv2:name \"Band %d Gain Reduction\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum -80.000000 ;\n\
+    lv2:maximum 0.000000 ;\n\
+    units:unit units:db ;\n\
+  ]",
+        MULTIBAND_BAND1_GR + i, i + 1, i + 1);
+    }
+
+  plugin_print_dsp_load_ttl (f, MULTIBAND_DSP_LOAD);
+  plugin_print_enabled_ttl (f, MULTIBAND_ENABLED);
+
+  plugin_print_params_ttl (
+    f, multiband_params, MULTIBAND_NUM_PARAMS);
+}
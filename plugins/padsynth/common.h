@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_PADSYNTH_COMMON_H__
+#define __Z_PADSYNTH_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include <string.h>
+
+#include "../common.h"
+
+/** Size of the voice pool. */
+#define PADSYNTH_MAX_VOICES 16
+
+typedef struct PadSynthUris
+{
+  /* custom URIs for communication with the
+   * worker */
+  LV2_URID padsynth_renderTable;
+  LV2_URID padsynth_freeTable;
+} PadSynthUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  PADSYNTH_CONTROL,
+  /** Plugin to UI communication. */
+  PADSYNTH_NOTIFY,
+
+  /** Bandwidth of each harmonic in cents. */
+  PADSYNTH_BANDWIDTH,
+  /** Harmonic content, 0 (dark) to 1 (bright). */
+  PADSYNTH_BRIGHTNESS,
+  /** Envelope times in seconds. */
+  PADSYNTH_ATTACK,
+  PADSYNTH_RELEASE,
+  PADSYNTH_GAIN,
+
+  /** Outputs. */
+  PADSYNTH_STEREO_OUT_L,
+  PADSYNTH_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  PADSYNTH_DSP_LOAD,
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct PadSynthCommon
+{
+  /** URIs. */
+  PadSynthUris    uris;
+
+  PluginCommon    pl_common;
+} PadSynthCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map*    urid_map,
+  PadSynthCommon * padsynth_common)
+{
+  map_common_uris (
+    urid_map, &padsynth_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  padsynth_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+  MAP (padsynth_renderTable, PLUGIN_URI "#renderTable");
+  MAP (padsynth_freeTable, PLUGIN_URI "#freeTable");
+
+#undef MAP
+}
+
+#endif
@@ -0,0 +1,862 @@
+/*
+ * Copyright (C) 2021 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+/** Length of the PADsynth table (a few seconds,
+ * so that the loop is not heard). */
+#define TABLE_SIZE (1 << 18)
+
+/** Number of harmonics in the table. */
+#define NUM_HARMONICS 32
+
+/** Frequency of the table played at its own
+ * rate. */
+#define BASE_FREQ 220.0
+
+/** Length of the crossfade to a new table, in
+ * seconds. */
+#define XFADE_TIME 0.1f
+
+/** Amplitude of each voice. */
+#define VOICE_AMP 0.25f
+
+/**
+ * A voice reading the table.
+ *
+ * The phase is in 32.32 fixed point table samples,
+ * so that wrapping is a mask.
+ */
+typedef struct PadVoice
+{
+  uint64_t      phase;
+  uint64_t      inc;
+
+  /** Envelope level, 0 to 1. */
+  float         env;
+
+  /** Velocity, 0 to 1. */
+  float         vel;
+
+  /** MIDI key played by this voice, or -1 if the
+   * voice is free. */
+  int           key;
+
+  /** Whether the key is held. */
+  int           gate;
+
+  /** Value of \ref PadSynth.note_counter when the
+   * note was started. */
+  uint32_t      age;
+} PadVoice;
+
+/**
+ * Message asking the worker for a table.
+ */
+typedef struct PadRenderMessage
+{
+  LV2_Atom      atom;
+  float         bandwidth;
+  float         brightness;
+} PadRenderMessage;
+
+/**
+ * Message with a table, from the worker (rendered)
+ * or to the worker (to free).
+ */
+typedef struct PadTableMessage
+{
+  LV2_Atom          atom;
+  sp_padsynth_tbl * table;
+} PadTableMessage;
+
+typedef struct PadSynth
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * bandwidth;
+  const float * brightness;
+  const float * attack;
+  const float * release;
+  const float * gain;
+
+  /* outputs */
+  float *       stereo_out_l;
+  float *       stereo_out_r;
+
+  PadVoice      voices[PADSYNTH_MAX_VOICES];
+
+  /** Incremented on each note on. */
+  uint32_t      note_counter;
+
+  /** State of the random start phases. */
+  uint32_t      rand;
+
+  /** Table being played, or NULL until the first
+   * one is rendered. */
+  sp_padsynth_tbl * table;
+
+  /** Table being crossfaded to, or NULL. */
+  sp_padsynth_tbl * next_table;
+
+  /** Progress of the crossfade, 0 to 1. */
+  float         xfade;
+
+  /** Whether the worker is rendering a table. */
+  int           rendering;
+
+  /** Table sent by the worker and not received by
+   * work_response() yet. Freed in cleanup() if the
+   * response is never delivered. */
+  sp_padsynth_tbl * pending_table;
+
+  /** Parameters of the last requested table, or
+   * negative before the first request. */
+  float         table_bandwidth;
+  float         table_brightness;
+
+  /** Directory of the table cache, or NULL. */
+  const char *  cache_dir;
+  char          cache_dir_buf[1024];
+
+  sp_data *     sp;
+
+  PadSynthCommon common;
+} PadSynth;
+
+/**
+ * Creates the table cache directory under the XDG
+ * cache directory and returns it, or NULL if it
+ * can't be created.
+ */
+static const char *
+init_cache_dir (
+  PadSynth * self)
+{
+#ifdef _WIN32
+  return NULL;
+#else
+  char * dir = self->cache_dir_buf;
+  const char * xdg = getenv ("XDG_CACHE_HOME");
+  const char * home = getenv ("HOME");
+  int len;
+  if (xdg && xdg[0])
+    {
+      len =
+        snprintf (
+          dir, sizeof (self->cache_dir_buf),
+          "%s/zplugins/padsynth", xdg);
+    }
+  else if (home && home[0])
+    {
+      len =
+        snprintf (
+          dir, sizeof (self->cache_dir_buf),
+          "%s/.cache/zplugins/padsynth", home);
+    }
+  else
+    return NULL;
+  if (len <= 0 ||
+      (size_t) len >= sizeof (self->cache_dir_buf))
+    return NULL;
+
+  /* create the parents first */
+  for (char * p = dir + 1; *p; p++)
+    {
+      if (*p == '/')
+        {
+          *p = '\0';
+          mkdir (dir, 0755);
+          *p = '/';
+        }
+    }
+  if (mkdir (dir, 0755) && errno != EEXIST)
+    return NULL;
+
+  return dir;
+#endif
+}
+
+/**
+ * Returns the bandwidth from the port, rounded so
+ * that small changes reuse the same table.
+ */
+static inline float
+get_bandwidth (
+  PadSynth * self)
+{
+  float bandwidth =
+    (float) math_round_float_to_int (*self->bandwidth);
+  return CLAMP (bandwidth, 1.f, 200.f);
+}
+
+static inline float
+get_brightness (
+  PadSynth * self)
+{
+  float brightness =
+    (float)
+    math_round_float_to_int (*self->brightness * 100.f) /
+    100.f;
+  return CLAMP (brightness, 0.f, 1.f);
+}
+
+/**
+ * Renders the table for the given parameters, or
+ * maps it from the cache.
+ *
+ * To be called by the worker function.
+ */
+static sp_padsynth_tbl *
+render_table (
+  PadSynth * self,
+  float      bandwidth,
+  float      brightness)
+{
+  SPFLOAT amps[NUM_HARMONICS];
+  amps[0] = 0;
+  for (int i = 1; i < NUM_HARMONICS; i++)
+    {
+      amps[i] =
+        (SPFLOAT)
+        pow (i, -(2.0 - 1.5 * brightness));
+    }
+
+  sp_padsynth_tbl * table =
+    malloc (sizeof (sp_padsynth_tbl));
+  if (!table)
+    return NULL;
+  SPFLOAT f =
+    (SPFLOAT) (BASE_FREQ * TABLE_SIZE / self->sp->sr);
+  if (sp_padsynth_load (
+        self->sp, table, self->cache_dir, TABLE_SIZE,
+        amps, NUM_HARMONICS, f, bandwidth) != SP_OK)
+    {
+      free (table);
+      return NULL;
+    }
+
+  return table;
+}
+
+static void
+free_table (
+  sp_padsynth_tbl * table)
+{
+  if (!table)
+    return;
+
+  sp_padsynth_unload (table);
+  free (table);
+}
+
+/**
+ * Asks the worker for a new table if the
+ * parameters changed.
+ *
+ * Only 1 table is rendered or crossfaded to at a
+ * time. Changes made meanwhile are picked up when
+ * it is done.
+ */
+static void
+request_table (
+  PadSynth * self)
+{
+  if (self->rendering || self->next_table)
+    return;
+
+  float bandwidth = get_bandwidth (self);
+  float brightness = get_brightness (self);
+  if (math_floats_equal (
+        bandwidth, self->table_bandwidth) &&
+      math_floats_equal (
+        brightness, self->table_brightness))
+    return;
+
+  PadRenderMessage msg = {
+    { sizeof (float) * 2,
+      self->common.uris.padsynth_renderTable },
+    bandwidth, brightness };
+  if (SCHEDULE (self)->schedule_work (
+        SCHEDULE (self)->handle,
+        sizeof (msg), &msg) == LV2_WORKER_SUCCESS)
+    {
+      self->rendering = 1;
+      self->table_bandwidth = bandwidth;
+      self->table_brightness = brightness;
+    }
+}
+
+static LV2_Worker_Status
+work (
+  LV2_Handle                  instance,
+  LV2_Worker_Respond_Function respond,
+  LV2_Worker_Respond_Handle   handle,
+  uint32_t                    size,
+  const void *                data)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+  const LV2_Atom * atom =
+    (const LV2_Atom *) data;
+  if (atom->type == self->common.uris.padsynth_freeTable)
+    {
+      const PadTableMessage * msg =
+        (const PadTableMessage *) data;
+      free_table (msg->table);
+    }
+  else if (atom->type ==
+             self->common.uris.padsynth_renderTable)
+    {
+      const PadRenderMessage * msg =
+        (const PadRenderMessage *) data;
+      sp_padsynth_tbl * table =
+        render_table (
+          self, msg->bandwidth, msg->brightness);
+      self->pending_table = table;
+      if (respond (handle, sizeof (table), &table) !=
+            LV2_WORKER_SUCCESS)
+        {
+          self->pending_table = NULL;
+          free_table (table);
+        }
+    }
+
+  return LV2_WORKER_SUCCESS;
+}
+
+static LV2_Worker_Status
+work_response (
+  LV2_Handle  instance,
+  uint32_t    size,
+  const void* data)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+  sp_padsynth_tbl * table =
+    * (sp_padsynth_tbl * const *) data;
+  self->rendering = 0;
+  self->pending_table = NULL;
+  if (!table)
+    {
+      plugin_trace (
+        &self->common.pl_common, Error,
+        "Failed to render the PADsynth table\n");
+      return LV2_WORKER_SUCCESS;
+    }
+
+  /* the first table is used right away, the
+   * others are crossfaded to */
+  if (!self->table)
+    {
+      self->table = table;
+    }
+  else
+    {
+      self->next_table = table;
+      self->xfade = 0.f;
+    }
+
+  return LV2_WORKER_SUCCESS;
+}
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  PadSynth * self =
+    plugin_aligned_calloc (
+      _Alignof (PadSynth), sizeof (PadSynth));
+  if (!self)
+    return NULL;
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 1);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  if (sp_create (&self->sp) != SP_OK)
+    {
+      lv2_log_error (
+        &pl_common->logger,
+        "Failed to create the Soundpipe data\n");
+      goto fail;
+    }
+  self->sp->sr = (int) rate;
+
+  self->cache_dir = init_cache_dir (self);
+  self->table_bandwidth = -1.f;
+  self->table_brightness = -1.f;
+  self->rand = 1;
+
+  return (LV2_Handle) self;
+
+fail:
+  plugin_common_cleanup (&self->common.pl_common);
+  plugin_aligned_free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+  switch ((PortIndex) port)
+    {
+    case PADSYNTH_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case PADSYNTH_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case PADSYNTH_BANDWIDTH:
+      self->bandwidth = (const float *) data;
+      break;
+    case PADSYNTH_BRIGHTNESS:
+      self->brightness = (const float *) data;
+      break;
+    case PADSYNTH_ATTACK:
+      self->attack = (const float *) data;
+      break;
+    case PADSYNTH_RELEASE:
+      self->release = (const float *) data;
+      break;
+    case PADSYNTH_GAIN:
+      self->gain = (const float *) data;
+      break;
+    case PADSYNTH_STEREO_OUT_L:
+      self->stereo_out_l = (float *) data;
+      break;
+    case PADSYNTH_STEREO_OUT_R:
+      self->stereo_out_r = (float *) data;
+      break;
+    case PADSYNTH_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+  for (int i = 0; i < PADSYNTH_MAX_VOICES; i++)
+    {
+      PadVoice * voice = &self->voices[i];
+      voice->key = -1;
+      voice->gate = 0;
+      voice->env = 0.f;
+    }
+}
+
+/**
+ * Starts the given key, on a free voice or on the
+ * voice to steal.
+ *
+ * A stolen voice keeps its envelope level and
+ * phase, so that it changes pitch without a
+ * click.
+ */
+static void
+note_on (
+  PadSynth * self,
+  int        key,
+  float      vel)
+{
+  PadVoice * free_voice = NULL;
+  PadVoice * quietest_released = NULL;
+  PadVoice * oldest = NULL;
+  for (int i = 0; i < PADSYNTH_MAX_VOICES; i++)
+    {
+      PadVoice * voice = &self->voices[i];
+      if (voice->key == key)
+        {
+          free_voice = voice;
+          break;
+        }
+      else if (voice->key < 0)
+        {
+          if (!free_voice)
+            free_voice = voice;
+        }
+      else if (!voice->gate)
+        {
+          if (!quietest_released ||
+              voice->env < quietest_released->env)
+            quietest_released = voice;
+        }
+      else if (!oldest ||
+               (int32_t)
+                 (voice->age - oldest->age) < 0)
+        {
+          oldest = voice;
+        }
+    }
+
+  PadVoice * voice = free_voice;
+  if (!voice)
+    voice = quietest_released;
+  if (!voice)
+    voice = oldest;
+
+  if (voice->key < 0)
+    {
+      /* start each voice at a random point of the
+       * table, like the original PADsynth */
+      self->rand = self->rand * 1664525u + 1013904223u;
+      voice->phase =
+        (uint64_t) (self->rand & (TABLE_SIZE - 1)) << 32;
+      voice->env = 0.f;
+    }
+
+  double freq =
+    440.0 * pow (2.0, (key - 69) / 12.0);
+  voice->inc =
+    (uint64_t)
+    (freq / BASE_FREQ * 4294967296.0 + 0.5);
+  voice->key = key;
+  voice->gate = 1;
+  voice->vel = vel;
+  voice->age = self->note_counter++;
+}
+
+static void
+note_off (
+  PadSynth * self,
+  int        key)
+{
+  for (int i = 0; i < PADSYNTH_MAX_VOICES; i++)
+    {
+      PadVoice * voice = &self->voices[i];
+      if (voice->key == key)
+        voice->gate = 0;
+    }
+}
+
+/**
+ * Reads the table at the given phase, for the left
+ * and right channels. The right channel reads half
+ * a table later, which decorrelates it.
+ */
+static inline void
+read_table (
+  const SPFLOAT * tbl,
+  uint64_t        phase,
+  float *         out_l,
+  float *         out_r)
+{
+  uint32_t mask = TABLE_SIZE - 1;
+  uint32_t idx = (uint32_t) (phase >> 32) & mask;
+  float frac =
+    (float) (uint32_t) phase * (1.f / 4294967296.f);
+  uint32_t idx_r = (idx + TABLE_SIZE / 2) & mask;
+
+  float a = tbl[idx];
+  float b = tbl[(idx + 1) & mask];
+  *out_l = a + (b - a) * frac;
+  a = tbl[idx_r];
+  b = tbl[(idx_r + 1) & mask];
+  *out_r = a + (b - a) * frac;
+}
+
+/**
+ * Processes the given range of samples.
+ *
+ * Each active voice is rendered for the whole range
+ * before moving to the next one.
+ */
+static void
+process (
+  PadSynth * self,
+  uint32_t   offset,
+  uint32_t   nframes)
+{
+  float * out_l = &self->stereo_out_l[offset];
+  float * out_r = &self->stereo_out_r[offset];
+  memset (out_l, 0, nframes * sizeof (float));
+  memset (out_r, 0, nframes * sizeof (float));
+
+  float samplerate = (float) GET_SAMPLERATE (self);
+  float atk_step =
+    1.f / (MAX (*self->attack, 0.001f) * samplerate);
+  float rel_step =
+    1.f / (MAX (*self->release, 0.001f) * samplerate);
+  float gain =
+    sp_fast_db2lin (*self->gain) * VOICE_AMP;
+  const SPFLOAT * tbl =
+    self->table ? self->table->tbl : NULL;
+  const SPFLOAT * next_tbl =
+    self->next_table ? self->next_table->tbl : NULL;
+  float xfade_step = 1.f / (XFADE_TIME * samplerate);
+
+  for (int i = 0; i < PADSYNTH_MAX_VOICES; i++)
+    {
+      PadVoice * voice = &self->voices[i];
+      if (voice->key < 0)
+        continue;
+
+      float env = voice->env;
+      float env_step = voice->gate ? atk_step : -rel_step;
+      float mult = voice->vel * gain;
+      uint64_t phase = voice->phase;
+
+      /* nothing to play until the first table is
+       * rendered, but keep the envelopes going */
+      if (!tbl)
+        {
+          env =
+            CLAMP (
+              env + (float) nframes * env_step,
+              0.f, 1.f);
+          phase += voice->inc * nframes;
+        }
+      else
+        {
+          for (uint32_t k = 0; k < nframes; k++)
+            {
+              env = CLAMP (env + env_step, 0.f, 1.f);
+
+              float val_l, val_r;
+              read_table (tbl, phase, &val_l, &val_r);
+              if (next_tbl)
+                {
+                  float next_l, next_r;
+                  read_table (
+                    next_tbl, phase, &next_l, &next_r);
+                  float x =
+                    MIN (
+                      self->xfade + (float) k * xfade_step,
+                      1.f);
+                  val_l += (next_l - val_l) * x;
+                  val_r += (next_r - val_r) * x;
+                }
+
+              out_l[k] += val_l * env * mult;
+              out_r[k] += val_r * env * mult;
+              phase += voice->inc;
+            }
+        }
+      voice->env = env;
+      voice->phase = phase;
+
+      if (!voice->gate && env <= 0.f)
+        voice->key = -1;
+    }
+
+  if (self->next_table)
+    {
+      self->xfade += (float) nframes * xfade_step;
+      if (self->xfade >= 1.f)
+        {
+          /* send the old table to the worker to be
+           * freed. If the worker queue is full, the
+           * new table keeps playing at the end of
+           * the crossfade and this is tried again in
+           * the next cycle */
+          PadTableMessage msg = {
+            { sizeof (sp_padsynth_tbl *),
+              self->common.uris.padsynth_freeTable },
+            self->table };
+          if (SCHEDULE (self)->schedule_work (
+                SCHEDULE (self)->handle,
+                sizeof (msg), &msg) ==
+                LV2_WORKER_SUCCESS)
+            {
+              self->table = self->next_table;
+              self->next_table = NULL;
+            }
+        }
+    }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  request_table (self);
+
+  uint32_t processed = 0;
+
+  /* read incoming events from host and UI */
+  LV2_ATOM_SEQUENCE_FOREACH (
+    self->control, ev)
+    {
+      if (ev->body.type == PL_URIS (self)->midi_MidiEvent)
+        {
+          /* process up to the event */
+          uint32_t ev_frames = (uint32_t) ev->time.frames;
+          if (ev_frames > processed)
+            {
+              process (
+                self, processed, ev_frames - processed);
+              processed = ev_frames;
+            }
+
+          const uint8_t * const msg =
+            (const uint8_t *) (ev + 1);
+          switch (lv2_midi_message_type (msg))
+            {
+            case LV2_MIDI_MSG_NOTE_ON:
+              /* note with velocity 0 can be note off */
+              if (msg[2] == 0)
+                note_off (self, msg[1]);
+              else
+                note_on (
+                  self, msg[1], (float) msg[2] / 127.f);
+              break;
+            case LV2_MIDI_MSG_NOTE_OFF:
+              note_off (self, msg[1]);
+              break;
+            case LV2_MIDI_MSG_CONTROLLER:
+              if (msg[1] == 0x7b || // all notes off
+                  msg[1] == 0x78) // all sound off
+                {
+                  for (int i = 0; i < 128; i++)
+                    note_off (self, i);
+                }
+              break;
+            default:
+              break;
+            }
+        }
+    }
+
+  if (processed < n_samples)
+    {
+      process (self, processed, n_samples - processed);
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  PadSynth * self = (PadSynth *) instance;
+
+  free_table (self->table);
+  free_table (self->next_table);
+  free_table (self->pending_table);
+  sp_destroy (&self->sp);
+  plugin_common_cleanup (&self->common.pl_common);
+  plugin_aligned_free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  static const LV2_Worker_Interface worker =
+    { work, work_response, NULL };
+  if (!strcmp(uri, LV2_WORKER__interface))
+    {
+      return &worker;
+    }
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
@@ -58,10 +58,45 @@ typedef enum PortIndex
   /** Outputs. */
   PHASER_STEREO_OUT_L,
   PHASER_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  PHASER_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  PHASER_ENABLED,
 
   NUM_PORTS,
 } PortIndex;
 
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo phaser_params[] = {
+  { PHASER_MAX_NOTCH_FREQ, "max_notch_freq",
+    "Max Notch Freq", 20.f, 10000.f },
+  { PHASER_MIN_NOTCH_FREQ, "min_notch_freq",
+    "Min Notch Freq", 20.f, 5000.f },
+  { PHASER_NOTCH_WIDTH, "notch_width",
+    "Notch width", 10.f, 5000.f },
+  { PHASER_NOTCH_FREQ, "notch_freq",
+    "Notch Freq", 1.1f, 4.f },
+  { PHASER_VIBRATO_MODE, "vibrato_mode",
+    "Vibrato Mode", 0.f, 1.f },
+  { PHASER_DEPTH, "depth",
+    "Depth", 0.f, 1.f },
+  { PHASER_FEEDBACK_GAIN, "feedback_gain",
+    "Feedback Gain", 0.f, 1.f },
+  { PHASER_INVERT, "invert",
+    "Invert", 0.f, 1.f },
+  { PHASER_LEVEL, "level",
+    "Level", -60.f, 10.f },
+  { PHASER_LFO_BPM, "lfo_bpm",
+    "LFO BPM", 24.f, 360.f },
+};
+
+#define PHASER_NUM_PARAMS \
+  ((int) (sizeof (phaser_params) / \
+          sizeof (phaser_params[0])))
+
 /**
  * Group of variables needed by both the DSP and
  * the UI.
@@ -26,6 +26,7 @@ print_ttl (FILE * f)
 @prefix log:  <http://lv2plug.in/ns/ext/log#> .\n\
 @prefix lv2:  <http://lv2plug.in/ns/lv2core#> .\n\
 @prefix midi: <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
 @prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
 @prefix rdf:  <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
 @prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n\
@@ -187,7 +188,7 @@ print_ttl (FILE * f)
     lv2:index 15 ;\n\
     lv2:symbol \"stereo_out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n",
+  ]",
     /* max notch */
     800.0, 20.0, 10000.0,
     /* min notch */
@@ -205,4 +206,9 @@ print_ttl (FILE * f)
     /* lfo bpm */
     30.0, 24.0, 360.0
     );
+
+  plugin_print_dsp_load_ttl (f, PHASER_DSP_LOAD);
+  plugin_print_enabled_ttl (f, PHASER_ENABLED);
+  plugin_print_params_ttl (
+    f, phaser_params, PHASER_NUM_PARAMS);
 }
@@ -52,9 +52,50 @@ typedef enum PortIndex
   PITCH_STEREO_OUT_L,
   PITCH_STEREO_OUT_R,
 
+  /** Pitch shifting algorithm, see PitchEngine. */
+  PITCH_ENGINE,
+  PITCH_LATENCY,
+  /** Average DSP load of the plugin. */
+  PITCH_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  PITCH_ENABLED,
+
   NUM_PORTS,
 } PortIndex;
 
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo pitch_params[] = {
+  { PITCH_SHIFT, "shift",
+    "Shift", -24.f, 24.f },
+  { PITCH_WINDOW, "window",
+    "Window", 1.f, 10000.f },
+  { PITCH_XFADE, "xfade",
+    "Cross-fade", 0.f, 10000.f },
+  { PITCH_ENGINE, "engine",
+    "Engine", 0.f, 1.f },
+};
+
+#define PITCH_NUM_PARAMS \
+  ((int) (sizeof (pitch_params) / \
+          sizeof (pitch_params[0])))
+
+/**
+ * Pitch shifting algorithm, selected by the engine
+ * port.
+ */
+typedef enum PitchEngine
+{
+  /** Fixed-window delay line shifter (sp_pshift2). */
+  PITCH_ENGINE_DELAY,
+
+  /** Pitch-synchronous overlap-add driven by a
+   * pitch tracker (sp_psola). */
+  PITCH_ENGINE_PSOLA,
+} PitchEngine;
+
 /**
  * Group of variables needed by both the DSP and
  * the UI.
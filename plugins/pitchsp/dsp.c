@@ -32,6 +32,13 @@
 
 #include "soundpipe.h"
 
+/** Maximum value of the window port, in samples. */
+#define MAX_WINDOW 10000
+
+/** Lowest pitch tracked by the PSOLA engine, in
+ * Hz. Sets its latency to 2 periods of it. */
+#define PSOLA_MIN_FREQ 80
+
 typedef struct Pitch
 {
   /** Plugin ports. */
@@ -43,15 +50,22 @@ typedef struct Pitch
   const float * shift;
   const float * window;
   const float * xfade;
+  const float * engine;
 
   /* outputs */
   float *       stereo_out_l;
   float *       stereo_out_r;
+  float *       latency;
 
   PitchCommon common;
 
   sp_data *     sp;
-  sp_pshift *   pshift;
+  sp_pshift2 *  pshift;
+  sp_psola *    psola;
+
+  /** Engine used in the previous cycle, or -1
+   * after activation. */
+  int           prev_engine;
 
 } Pitch;
 
@@ -76,6 +90,18 @@ instantiate (
   /* map uris */
   map_uris (pl_common->map, &self->common);
 
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, pitch_params, PITCH_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, NULL, NULL))
+    goto fail;
+  if (plugin_bypass_init_latency (
+        pl_common,
+        2 * (uint32_t) (rate / PSOLA_MIN_FREQ + 1.0)))
+    goto fail;
+
   /* init atom forge */
   lv2_atom_forge_init (
     &pl_common->forge, pl_common->map);
@@ -87,6 +113,7 @@ instantiate (
   return (LV2_Handle) self;
 
 fail:
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
   return NULL;
 }
@@ -116,13 +143,24 @@ connect_port (
       self->stereo_in_r = (const float *) data;
       break;
     case PITCH_SHIFT:
-      self->shift = (const float *) data;
+      self->shift =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case PITCH_WINDOW:
-      self->window = (const float *) data;
+      self->window =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case PITCH_XFADE:
-      self->xfade = (const float *) data;
+      self->xfade =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case PITCH_ENGINE:
+      self->engine =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
       break;
     case PITCH_STEREO_OUT_L:
       self->stereo_out_l = (float *) data;
@@ -130,6 +168,17 @@ connect_port (
     case PITCH_STEREO_OUT_R:
       self->stereo_out_r = (float *) data;
       break;
+    case PITCH_LATENCY:
+      self->latency = (float *) data;
+      break;
+    case PITCH_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case PITCH_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
     default:
       break;
     }
@@ -142,8 +191,77 @@ activate (
   Pitch * self = (Pitch*) instance;
 
   sp_create (&self->sp);
-  sp_pshift_create (&self->pshift);
-  sp_pshift_init (self->sp, self->pshift);
+  self->sp->sr = (int) GET_SAMPLERATE (self);
+  sp_pshift2_create (&self->pshift);
+  sp_pshift2_init (
+    self->sp, self->pshift, MAX_WINDOW);
+  sp_psola_create (&self->psola);
+  sp_psola_init (
+    self->sp, self->psola, PSOLA_MIN_FREQ);
+  self->prev_engine = -1;
+}
+
+static PitchEngine
+get_engine (
+  Pitch * self)
+{
+  int engine =
+    math_round_float_to_int (*self->engine);
+  return
+    (PitchEngine)
+    CLAMP (
+      engine, PITCH_ENGINE_DELAY,
+      PITCH_ENGINE_PSOLA);
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Pitch * self = (Pitch *) user_data;
+
+  /* the engine that was idle still holds the
+   * audio from before it was last used */
+  PitchEngine engine = get_engine (self);
+  if ((int) engine != self->prev_engine)
+    {
+      if (engine == PITCH_ENGINE_PSOLA)
+        sp_psola_clear (self->sp, self->psola);
+      else
+        sp_pshift2_clear (self->sp, self->pshift);
+      self->prev_engine = (int) engine;
+    }
+
+  if (engine == PITCH_ENGINE_PSOLA)
+    {
+      self->psola->shift = *self->shift;
+      sp_psola_compute_block (
+        self->sp, self->psola,
+        (float *) &self->stereo_in_l[offset],
+        (float *) &self->stereo_in_r[offset],
+        &self->stereo_out_l[offset],
+        &self->stereo_out_r[offset], nframes);
+    }
+  else
+    {
+      /* shift both channels with one window phase,
+       * each through its own delay line */
+      self->pshift->shift = *self->shift;
+      self->pshift->window = *self->window;
+      self->pshift->xfade = *self->xfade;
+      sp_pshift2_compute_block (
+        self->sp, self->pshift,
+        (float *) &self->stereo_in_l[offset],
+        (float *) &self->stereo_in_r[offset],
+        &self->stereo_out_l[offset],
+        &self->stereo_out_r[offset], nframes);
+    }
 }
 
 static void
@@ -152,6 +270,7 @@ run (
   uint32_t n_samples)
 {
   Pitch * self = (Pitch *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
 
 #ifdef TRIAL_VER
   if (get_time_since_instantiation (
@@ -159,40 +278,54 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
 #if 0
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  long int ms = tp.tv_sec * 1000000 + tp.tv_usec;
+  uint64_t start_time = plugin_trace_now ();
 #endif
 
-  /* read incoming events from host and UI */
-  LV2_ATOM_SEQUENCE_FOREACH (
-    self->control, ev)
+  /* the latency does not change when bypassed,
+   * the input passed through is delayed instead */
+  uint32_t latency =
+    get_engine (self) == PITCH_ENGINE_PSOLA ?
+      self->psola->latency : 0;
+  *self->latency = (float) latency;
+  pl_common->bypass.latency = latency;
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
     {
-      /* TODO */
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
     }
-
-  /* compress */
-  *self->pshift->shift = *self->shift;
-  *self->pshift->window = *self->window;
-  *self->pshift->xfade = *self->xfade;
-  for (uint32_t i = 0; i < n_samples; i++)
+  else
     {
-      float current_in = self->stereo_in_l[i];
-      sp_pshift_compute (
-        self->sp, self->pshift,
-        &current_in, &self->stereo_out_l[i]);
-      current_in = self->stereo_in_r[i];
-      sp_pshift_compute (
-        self->sp, self->pshift,
-        &current_in, &self->stereo_out_r[i]);
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
     }
 
 #if 0
-  gettimeofday(&tp, NULL);
-  ms = (tp.tv_sec * 1000000 + tp.tv_usec) - ms;
-  printf("us taken %ld\n", ms);
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "us taken %.0f\n",
+    (double) (plugin_trace_now () - start_time) /
+      1000.0);
 #endif
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -202,7 +335,8 @@ deactivate (
   Pitch * self = (Pitch *) instance;
 
   sp_destroy (&self->sp);
-  sp_pshift_destroy (&self->pshift);
+  sp_pshift2_destroy (&self->pshift);
+  sp_psola_destroy (&self->psola);
 }
 
 static void
@@ -210,6 +344,7 @@ cleanup (
   LV2_Handle instance)
 {
   Pitch * self = (Pitch *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
 }
 
@@ -26,6 +26,7 @@ print_ttl (FILE * f)
 @prefix log:   <http://lv2plug.in/ns/ext/log#> .\n\
 @prefix lv2:   <http://lv2plug.in/ns/lv2core#> .\n\
 @prefix midi:  <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
 @prefix pg:    <http://lv2plug.in/ns/ext/port-groups#> .\n\
 @prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
 @prefix rdf:   <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
@@ -125,5 +126,35 @@ print_ttl (FILE * f)
     lv2:index 8 ;\n\
     lv2:symbol \"stereo_out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n");
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 9 ;\n\
+    lv2:symbol \"engine\" ;\n\
+    lv2:name \"Engine\" ;\n\
+    lv2:default 0 ;\n\
+    lv2:minimum 0 ;\n\
+    lv2:maximum 1 ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    lv2:portProperty lv2:enumeration ;\n\
+    lv2:scalePoint [ rdfs:label \"Delay line\"; rdf:value 0 ] ;\n\
+    lv2:scalePoint [ rdfs:label \"PSOLA\"; rdf:value 1 ] ;\n\
+    rdfs:comment \"Pitch shifting algorithm. PSOLA tracks the input pitch and ignores the window and cross-fade\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 10 ;\n\
+    lv2:symbol \"latency\" ;\n\
+    lv2:name \"Latency\" ;\n\
+    lv2:designation lv2:latency ;\n\
+    lv2:portProperty lv2:reportsLatency ,\n\
+      lv2:integer ;\n\
+    units:unit units:frame; \n\
+    rdfs:comment \"Latency of the selected engine\" ;\n\
+  ]");
+
+  plugin_print_dsp_load_ttl (f, PITCH_DSP_LOAD);
+  plugin_print_enabled_ttl (f, PITCH_ENABLED);
+  plugin_print_params_ttl (
+    f, pitch_params, PITCH_NUM_PARAMS);
 }
@@ -32,6 +32,13 @@
 
 #include "../common.h"
 
+/** Size of the voice pool (upper bound for the
+ * polyphony). */
+#define SAW_MAX_VOICES 32
+
+/** Default polyphony. */
+#define SAW_DEFAULT_POLYPHONY 16
+
 typedef struct SawUris
 {
   /* custom URIs for communication */
@@ -70,6 +77,10 @@ typedef enum PortIndex
   /** Outputs. */
   SUPERSAW_STEREO_OUT_L,
   SUPERSAW_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  SUPERSAW_DSP_LOAD,
+  /** Maximum number of sounding voices. */
+  SUPERSAW_MAX_POLYPHONY,
   NUM_PORTS,
 } PortIndex;
 
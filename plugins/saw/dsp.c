@@ -32,31 +32,116 @@
 
 #include "soundpipe.h"
 
-/* for some reason it needs to be declared */
-float powf(float dummy0, float dummy1);
+/** Number of detuned saws per voice. */
+#define NUM_OSCS 7
 
-typedef struct MidiKey
+/** Number of oscillator lanes per voice (padded to
+ * a SIMD-friendly width). */
+#define OSC_LANES 8
+
+/** Amplitude of each saw. */
+#define OSC_AMP 0.3f
+
+/** Length of the fade-out of a stolen voice, in
+ * seconds. */
+#define STEAL_FADE_TIME 0.005f
+
+/** Oversampling factor of the saturator and
+ * distortion. */
+#define DIST_OVERSAMPLING 4
+
+/** Number of samples upsampled at a time for the
+ * saturator and distortion. */
+#define DIST_BLOCK 64
+
+/** Envelope stages. */
+typedef enum EnvStage
 {
-  /** Pitch 0-127. */
-  int           pitch;
+  ENV_CLEAR,
+  ENV_ATTACK,
+  ENV_DECAY,
+  ENV_RELEASE,
+} EnvStage;
 
-  /** Whether currently pressed. */
-  int           pressed;
+/**
+ * Voice state in the voice pool.
+ *
+ * The oscillator state is laid out as arrays over
+ * the oscillators of the voice so that the lanes
+ * can be processed together. The oscillator state
+ * fits in 2 cache lines and the envelope and
+ * allocation state in a third one.
+ *
+ * The oscillators are band-limited saws using the
+ * differentiated parabolic waveform algorithm (the
+ * same algorithm as sp_blsaw).
+ */
+typedef struct __attribute__ ((aligned (64))) SawVoice
+{
+  /** Phase of each oscillator, 0 to 1. */
+  float         phase[OSC_LANES];
 
-  /** How many samples we are into the phase. */
-  size_t        offset;
+  /** Phase increment per sample. */
+  float         inc[OSC_LANES];
 
-  /** Standard frequency for this key. */
-  float         base_freq;
+  /** Last parabolic waveform value. */
+  float         prev[OSC_LANES];
+
+  /** Differentiator gain (depends on the
+   * frequency). */
+  float         gain[OSC_LANES];
 
-  /** Velocity. */
-  int           vel;
+  /** Current envelope output. */
+  float         env_level;
 
-  sp_adsr *     adsr;
-  sp_blsaw *    blsaws[7];
+  /** Envelope one-pole filter coefficients. */
+  float         env_a;
+  float         env_b;
 
-  /** Last signal known. */
-  float         last_adsr;
+  /** Gate value from the last sample. */
+  float         env_gate;
+
+  /** Release time in seconds. */
+  float         env_rel;
+
+  /** Envelope stage (EnvStage). */
+  int           env_stage;
+
+  /** MIDI key played by this voice, or -1 if the
+   * voice is free. */
+  int           key;
+
+  /** Velocity, 0 to 1. */
+  float         vel;
+
+  /** Value of \ref Saw.note_counter when the note
+   * was started, used to find the oldest voice. */
+  uint32_t      age;
+
+  /** Gain of the fade-out applied when the voice
+   * is stolen. */
+  float         fade;
+
+  /** Amount to subtract from \ref SawVoice.fade
+   * per sample, or 0 if the voice is not being
+   * stolen. */
+  float         fade_step;
+
+  /** Key to start when the fade-out finishes, or
+   * -1. */
+  int           pending_key;
+
+  /** Velocity of the pending key. */
+  float         pending_vel;
+} SawVoice;
+
+typedef struct MidiKey
+{
+  /** Whether currently pressed. */
+  int           pressed;
+
+  /** Standard frequency for this key. */
+  float         base_freq;
 } MidiKey;
 
 /**
@@ -74,7 +159,7 @@ typedef struct SawValues
   float      distortion_shape1;
   float      distortion_shape2;
   float      reverb_mix;
-  float      keyfreqs[128][7];
+  float      keyfreqs[128][NUM_OSCS];
   float      keyreleases[128];
 } SawValues;
 
@@ -89,10 +174,14 @@ typedef struct SawValuesMessage
 
 typedef struct Saw
 {
+  /** Voice pool. */
+  SawVoice      voices[SAW_MAX_VOICES];
+
   /** Plugin ports. */
   const LV2_Atom_Sequence* control;
   LV2_Atom_Sequence* notify;
   const float * amount;
+  const float * max_polyphony;
 
   /* outputs */
   float *       stereo_out_l;
@@ -101,6 +190,20 @@ typedef struct Saw
   /** Events in the queue. */
   MidiKey       keys[128];
 
+  /** Envelope times in seconds and sustain level,
+   * shared by all voices. */
+  float         env_atk;
+  float         env_dec;
+  float         env_sus;
+
+  /** Oscillator frequencies and release time of
+   * each key, applied to voices when they start. */
+  float         key_freqs[128][NUM_OSCS];
+  float         key_releases[128];
+
+  /** Incremented on each note on. */
+  uint32_t      note_counter;
+
   /** Current values based on \ref Saw.amount. */
   /*float         attack;*/
   /*float         decay;*/
@@ -108,10 +211,16 @@ typedef struct Saw
   /*float         release;*/
   /*int           num_voices;*/
 
-  sp_saturator * saturator;
+  /** Post-processing chain. The compressor,
+   * saturator and oversampler keep state, so there is
+   * one of each per channel. The saturator runs
+   * inside the oversampler together with the
+   * distortion. */
+  sp_compressor * compressor[2];
+  sp_saturator * saturator[2];
+  sp_oversample * oversample[2];
   sp_dist *     distortion;
   sp_zitarev *  reverb;
-  sp_compressor * compressor;
   sp_data *     sp;
 
   SawCommon common;
@@ -122,6 +231,410 @@ typedef struct Saw
   float         last_amount;
 } Saw;
 
+/**
+ * Sets the frequency of an oscillator in the
+ * voice.
+ */
+static inline void
+set_osc_freq (
+  SawVoice * voice,
+  int        osc,
+  float      freq,
+  float      samplerate)
+{
+  voice->inc[osc] = freq / samplerate;
+
+  /* scale the differentiated parabola back to the
+   * amplitude of the saw */
+  voice->gain[osc] =
+    (OSC_AMP * 0.25f) / voice->inc[osc];
+}
+
+/**
+ * Sets the phase of an oscillator in the voice as
+ * if it had already produced the given number of
+ * samples.
+ */
+static inline void
+set_osc_phase (
+  SawVoice * voice,
+  int        osc,
+  int        num_samples)
+{
+  double phase =
+    fmod ((double) voice->inc[osc] * num_samples, 1.0);
+  float naive = 2.f * (float) phase - 1.f;
+  voice->phase[osc] = (float) phase;
+  voice->prev[osc] = naive * naive;
+}
+
+/**
+ * Returns the pole for a one-pole filter with the
+ * given time constant.
+ */
+static inline float
+env_tau_to_pole (
+  float tau,
+  float samplerate)
+{
+  return (float) exp (-1.0 / (tau * samplerate));
+}
+
+static inline void
+env_set_pole (
+  SawVoice * voice,
+  float      pole)
+{
+  voice->env_a = pole;
+  voice->env_b = 1.f - pole;
+}
+
+/**
+ * Processes 1 sample of the envelope of the given
+ * voice (same algorithm as sp_adsr).
+ */
+static inline float
+env_process (
+  Saw *      self,
+  SawVoice * voice,
+  float      gate)
+{
+  float samplerate = (float) GET_SAMPLERATE (self);
+  if (voice->env_gate < gate &&
+      voice->env_stage != ENV_DECAY)
+    {
+      voice->env_stage = ENV_ATTACK;
+      env_set_pole (
+        voice,
+        env_tau_to_pole (
+          self->env_atk * 0.6f, samplerate));
+    }
+  else if (voice->env_gate > gate)
+    {
+      voice->env_stage = ENV_RELEASE;
+      env_set_pole (
+        voice,
+        env_tau_to_pole (voice->env_rel, samplerate));
+    }
+  voice->env_gate = gate;
+
+  switch (voice->env_stage)
+    {
+    case ENV_ATTACK:
+      voice->env_level =
+        voice->env_b * gate +
+        voice->env_a * voice->env_level;
+      if (voice->env_level > 0.99f)
+        {
+          voice->env_stage = ENV_DECAY;
+          env_set_pole (
+            voice,
+            env_tau_to_pole (
+              self->env_dec, samplerate));
+        }
+      return voice->env_level;
+    case ENV_DECAY:
+    case ENV_RELEASE:
+      voice->env_level =
+        voice->env_b * gate * self->env_sus +
+        voice->env_a * voice->env_level;
+      return voice->env_level;
+    default:
+      return 0.f;
+    }
+}
+
+/**
+ * Processes the oscillators of the given voice for
+ * 1 sample and returns the mix of all lanes using
+ * the given lane gains.
+ */
+static inline void
+process_oscs (
+  SawVoice *    voice,
+  const float * gains_l,
+  const float * gains_r,
+  float *       out_l,
+  float *       out_r)
+{
+  float sum_l = 0.f;
+  float sum_r = 0.f;
+  for (int j = 0; j < OSC_LANES; j++)
+    {
+      float phase = voice->phase[j] + voice->inc[j];
+      phase -= (float) (phase >= 1.f);
+      voice->phase[j] = phase;
+
+      float naive = 2.f * phase - 1.f;
+      float parabola = naive * naive;
+      float val =
+        voice->gain[j] * (parabola - voice->prev[j]);
+      voice->prev[j] = parabola;
+
+      sum_l += val * gains_l[j];
+      sum_r += val * gains_r[j];
+    }
+  *out_l = sum_l;
+  *out_r = sum_r;
+}
+
+/**
+ * Applies the oscillator frequencies and release
+ * time of the voice's key to the voice.
+ */
+static void
+voice_apply_key (
+  Saw *      self,
+  SawVoice * voice)
+{
+  float samplerate = (float) GET_SAMPLERATE (self);
+  voice->env_rel = self->key_releases[voice->key];
+  for (int j = 0; j < NUM_OSCS; j++)
+    {
+      set_osc_freq (
+        voice, j, self->key_freqs[voice->key][j],
+        samplerate);
+    }
+}
+
+/**
+ * Starts playing the given key on a free voice.
+ */
+static void
+voice_start (
+  Saw *      self,
+  SawVoice * voice,
+  int        key,
+  float      vel)
+{
+  voice->key = key;
+  voice->vel = vel;
+  voice->age = self->note_counter++;
+  voice_apply_key (self, voice);
+}
+
+/**
+ * Marks the voice as free and resets its
+ * envelope.
+ */
+static void
+voice_free (
+  SawVoice * voice)
+{
+  voice->key = -1;
+  voice->pending_key = -1;
+  voice->fade = 1.f;
+  voice->fade_step = 0.f;
+  voice->env_stage = ENV_CLEAR;
+  voice->env_level = 0.f;
+  voice->env_gate = 0.f;
+}
+
+/**
+ * Frees the voice and starts its pending key, if
+ * any.
+ *
+ * Called when the fade-out of a stolen voice
+ * finishes.
+ */
+static void
+voice_finish_steal (
+  Saw *      self,
+  SawVoice * voice)
+{
+  int key = voice->pending_key;
+  float vel = voice->pending_vel;
+  voice_free (voice);
+  if (key >= 0)
+    {
+      voice_start (self, voice, key, vel);
+    }
+}
+
+/**
+ * Starts fading out the voice.
+ *
+ * @param key Key to start on the voice after the
+ *   fade-out, or -1.
+ */
+static void
+voice_steal (
+  Saw *      self,
+  SawVoice * voice,
+  int        key,
+  float      vel)
+{
+  if (voice->fade_step <= 0.f)
+    {
+      voice->fade_step =
+        1.f /
+        (STEAL_FADE_TIME *
+           (float) GET_SAMPLERATE (self));
+    }
+  voice->pending_key = key;
+  voice->pending_vel = vel;
+}
+
+/**
+ * Returns the voice to steal.
+ *
+ * Released voices are preferred (the quietest one),
+ * followed by the oldest held voice. Voices that
+ * are already fading out are only returned if there
+ * is no other choice.
+ *
+ * Must only be called when at least 1 voice is in
+ * use.
+ */
+static SawVoice *
+find_voice_to_steal (
+  Saw * self)
+{
+  SawVoice * quietest_released = NULL;
+  SawVoice * oldest_held = NULL;
+  SawVoice * oldest_fading = NULL;
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
+      if (voice->key < 0)
+        continue;
+
+      if (voice->fade_step > 0.f)
+        {
+          if (!oldest_fading ||
+              (int32_t)
+                (voice->age - oldest_fading->age) < 0)
+            oldest_fading = voice;
+        }
+      else if (!self->keys[voice->key].pressed)
+        {
+          if (!quietest_released ||
+              voice->env_level <
+                quietest_released->env_level)
+            quietest_released = voice;
+        }
+      else
+        {
+          if (!oldest_held ||
+              (int32_t)
+                (voice->age - oldest_held->age) < 0)
+            oldest_held = voice;
+        }
+    }
+
+  if (quietest_released)
+    return quietest_released;
+  else if (oldest_held)
+    return oldest_held;
+  else
+    return oldest_fading;
+}
+
+/**
+ * Returns the current max polyphony from the
+ * port.
+ */
+static inline int
+get_max_polyphony (
+  Saw * self)
+{
+  int max_polyphony =
+    math_round_float_to_int (*self->max_polyphony);
+  if (max_polyphony < 1)
+    return 1;
+  else if (max_polyphony > SAW_MAX_VOICES)
+    return SAW_MAX_VOICES;
+  else
+    return max_polyphony;
+}
+
+/**
+ * Assigns a voice to the given key, stealing one
+ * if the max polyphony is reached.
+ */
+static void
+note_on (
+  Saw * self,
+  int   key,
+  float vel)
+{
+  self->keys[key].pressed = 1;
+
+  int num_used = 0;
+  SawVoice * free_voice = NULL;
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
+
+      /* retrigger the voice already playing the
+       * key */
+      if (voice->key == key &&
+          voice->fade_step <= 0.f)
+        {
+          voice->vel = vel;
+          voice->age = self->note_counter++;
+          return;
+        }
+      else if (voice->pending_key == key)
+        {
+          voice->pending_vel = vel;
+          return;
+        }
+
+      if (voice->key < 0)
+        {
+          if (!free_voice)
+            free_voice = voice;
+        }
+      else
+        {
+          num_used++;
+        }
+    }
+
+  if (free_voice &&
+      num_used < get_max_polyphony (self))
+    {
+      voice_start (self, free_voice, key, vel);
+    }
+  else
+    {
+      /* the new note starts after the stolen voice
+       * fades out */
+      voice_steal (
+        self, find_voice_to_steal (self), key, vel);
+    }
+}
+
+/**
+ * Fades out voices until the number of voices in
+ * use is within the max polyphony.
+ *
+ * Only needed when the max polyphony is lowered
+ * while voices are playing.
+ */
+static void
+limit_voices (
+  Saw * self)
+{
+  int num_used = 0;
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
+      if (voice->key >= 0 &&
+          voice->fade_step <= 0.f)
+        num_used++;
+    }
+
+  int max_polyphony = get_max_polyphony (self);
+  while (num_used > max_polyphony)
+    {
+      voice_steal (
+        self, find_voice_to_steal (self), -1, 0.f);
+      num_used--;
+    }
+}
+
 /**
  * To be called by the worker function.
  */
@@ -157,7 +670,7 @@ calc_values (
         (((float) (127 - i) / 127.f) * 0.6f +
           (float) i / 127.f);
 
-      for (int j = 0; j < 7; j++)
+      for (int j = 0; j < NUM_OSCS; j++)
         {
           /* voice spread */
           int is_even = (j % 2) == 0;
@@ -203,29 +716,35 @@ set_values (
 {
   /*lv2_log_note (*/
     /*&self->common.logger, "setting values\n");*/
-  self->saturator->drive = values->saturator_drive;
-  self->saturator->dcoffset = values->saturator_dcoffset;
+  for (int i = 0; i < 2; i++)
+    {
+      self->saturator[i]->drive =
+        values->saturator_drive;
+      self->saturator[i]->dcoffset =
+        values->saturator_dcoffset;
+    }
   self->distortion->shape1 = values->distortion_shape1;
   self->distortion->shape2 = values->distortion_shape2;
   *self->reverb->mix = values->reverb_mix;
 
-  for (int i = 0; i < 128; i++)
-    {
-      MidiKey * key = &self->keys[i];
+  /* adsr */
+  self->env_atk = values->attack;
+  self->env_dec = values->decay;
+  self->env_sus = values->sustain;
 
-      /* adsr */
-      key->adsr->atk = values->attack;
-      key->adsr->dec = values->decay;
-      key->adsr->sus = values->sustain;
-      key->adsr->rel = values->keyreleases[i];
+  memcpy (
+    self->key_freqs, values->keyfreqs,
+    sizeof (self->key_freqs));
+  memcpy (
+    self->key_releases, values->keyreleases,
+    sizeof (self->key_releases));
 
-      for (int j = 0; j < 7; j++)
-        {
-          /* spread voices */
-          *key->blsaws[j]->freq = values->keyfreqs[i][j];
-        }
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
+      if (voice->key >= 0)
+        voice_apply_key (self, voice);
     }
-
 }
 
 static LV2_Worker_Status
@@ -294,7 +813,9 @@ instantiate (
   const char*               bundle_path,
   const LV2_Feature* const* features)
 {
-  Saw * self = calloc (1, sizeof (Saw));
+  Saw * self =
+    plugin_aligned_calloc (
+      _Alignof (Saw), sizeof (Saw));
 
   SET_SAMPLERATE (self, rate);
 
@@ -317,29 +838,26 @@ instantiate (
     &pl_common->logger, pl_common->map, pl_common->log);
 
   /* create synth */
-  srand (time (NULL));
+  sp_create (&self->sp);
+  self->sp->len = 1;
+  self->sp->sr = (int) rate;
+
   for (int i = 0; i < 128; i++)
     {
-      MidiKey * key = &self->keys[i];
-
-      sp_create (&self->sp);
-      self->sp->len = 1;
+      self->keys[i].base_freq =
+        440.f *
+        sp_fast_exp2 (((float) i - 69.f) / 12.f);
+    }
 
-      key->base_freq =
-        440.f * powf (2.f, ((float) i - 69.f) / 12.f);
+  float samplerate = (float) rate;
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
 
       /* create 7 saws */
-      for (int j = 0; j < 7; j++)
+      for (int j = 0; j < NUM_OSCS; j++)
         {
-          sp_blsaw_create (&key->blsaws[j]);
-          sp_blsaw_init (self->sp, key->blsaws[j]);
-          *key->blsaws[j]->amp = 0.3f;
-
-#define COMPUTE(times) \
-  for (int k = 0; k < (times); k++) { \
-    sp_blsaw_compute ( \
-      self->sp, key->blsaws[j], NULL, &self->sp->out[0]); \
-  }
+          set_osc_freq (voice, j, 440.f, samplerate);
 
           /* randomize voices a bit */
           int distance = 6000;
@@ -353,25 +871,34 @@ instantiate (
             {
               computed += (j / 2 + 1) * - distance;
             }
-          COMPUTE (computed);
+          set_osc_phase (voice, j, computed);
         }
 
-      /* create adsr */
-      sp_adsr_create (&key->adsr);
-      sp_adsr_init (self->sp, key->adsr);
+      voice_free (voice);
     }
 
-  /* create compressor */
-  sp_compressor_create (&self->compressor);
-  sp_compressor_init (self->sp, self->compressor);
-  *self->compressor->ratio = 2;
-  *self->compressor->thresh = -8;
-  *self->compressor->atk = 0.1f;
-  *self->compressor->rel = 0.2f;
-
-  /* create saturator */
-  sp_saturator_create (&self->saturator);
-  sp_saturator_init (self->sp, self->saturator);
+  for (int i = 0; i < 2; i++)
+    {
+      /* create compressor */
+      sp_compressor_create (&self->compressor[i]);
+      sp_compressor_init (
+        self->sp, self->compressor[i]);
+      *self->compressor[i]->ratio = 2;
+      *self->compressor[i]->thresh = -8;
+      *self->compressor[i]->atk = 0.1f;
+      *self->compressor[i]->rel = 0.2f;
+
+      /* create saturator */
+      sp_saturator_create (&self->saturator[i]);
+      sp_saturator_init (
+        self->sp, self->saturator[i]);
+
+      /* create oversampler for the distortion */
+      sp_oversample_create (&self->oversample[i]);
+      sp_oversample_init (
+        self->sp, self->oversample[i],
+        DIST_OVERSAMPLING);
+    }
 
   /* create distortion */
   sp_dist_create (&self->distortion);
@@ -385,7 +912,7 @@ instantiate (
   return (LV2_Handle) self;
 
 fail:
-  free (self);
+  plugin_aligned_free (self);
   return NULL;
 }
 
@@ -410,12 +937,19 @@ connect_port (
     case SUPERSAW_AMOUNT:
       self->amount = (const float *) data;
       break;
+    case SUPERSAW_MAX_POLYPHONY:
+      self->max_polyphony = (const float *) data;
+      break;
     case SUPERSAW_STEREO_OUT_L:
       self->stereo_out_l = (float *) data;
       break;
     case SUPERSAW_STEREO_OUT_R:
       self->stereo_out_r = (float *) data;
       break;
+    case SUPERSAW_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
     default:
       break;
     }
@@ -434,128 +968,183 @@ activate (
 }
 
 /**
- * Processes 1 sample.
+ * Processes the given range of samples.
+ *
+ * Each active voice is rendered for the whole range
+ * before moving to the next one, so that its state
+ * stays in registers/cache.
  */
+TARGET_CLONES
 static void
 process (
-  Saw * self,
-  uint32_t * offset)
+  Saw *    self,
+  uint32_t offset,
+  uint32_t nframes)
 {
-  float * current_l = &self->stereo_out_l[*offset];
-  float * current_r = &self->stereo_out_r[*offset];
-  *current_l = 0.f;
-  *current_r = 0.f;
-
-  for (int i = 0; i < 128; i++)
+  float * out_l = &self->stereo_out_l[offset];
+  float * out_r = &self->stereo_out_r[offset];
+  memset (out_l, 0, nframes * sizeof (float));
+  memset (out_r, 0, nframes * sizeof (float));
+
+  /* calculate the gain of each saw on each
+   * channel */
+  float gains_l[OSC_LANES] = { 0 };
+  float gains_r[OSC_LANES] = { 0 };
+  for (int j = 0; j < NUM_OSCS; j++)
     {
-      MidiKey * key = &self->keys[i];
+      float proximity_to_voice1 =
+        ((float) (NUM_OSCS - j) / (float) NUM_OSCS);
+
+      /* add amount * the distance from voice1,
+       * so when the amount is higher, the voice
+       * becomes louder
+       *
+       * multiply by something between 0 and 1 to
+       * adjust */
+      proximity_to_voice1 +=
+        *self->amount * (1.f - proximity_to_voice1) *
+        0.9f;
+
+      if (j % 2 == 0)
+        {
+          gains_l[j] = proximity_to_voice1 * 0.8f;
+          /* spread the first saw more evenly */
+          if (j == 0)
+            gains_r[j] = proximity_to_voice1 * 0.64f;
+          else
+            gains_r[j] = proximity_to_voice1 * 0.2f;
+        }
+      else
+        {
+          gains_l[j] = proximity_to_voice1 * 0.2f;
+          gains_r[j] = proximity_to_voice1 * 0.8f;
+        }
+    }
 
-      if (key->last_adsr < 0.0001f &&
-          !key->pressed)
+  for (int i = 0; i < SAW_MAX_VOICES; i++)
+    {
+      SawVoice * voice = &self->voices[i];
+      if (voice->key < 0)
         continue;
 
-      /* compute adsr */
-      SPFLOAT adsr = 0, gate = key->pressed;
-      sp_adsr_compute (
-        self->sp, key->adsr, &gate, &adsr);
-      adsr = adsr < 1.001f ? adsr : 0.0f;
+      if (voice->env_level < 0.0001f &&
+          !self->keys[voice->key].pressed)
+        {
+          /* the voice is silent, so a pending key
+           * can start without a fade */
+          voice_finish_steal (self, voice);
+          if (voice->key < 0)
+            continue;
+        }
 
-      float normalized_vel = ((float) key->vel) / 127.f;
+      float gate = (float) self->keys[voice->key].pressed;
 
-      if (adsr > 0.0f)
+      for (uint32_t k = 0; k < nframes; k++)
         {
-          /* compute as many supersaws as needed */
-          for (int j = 0; j < 7; j++)
+          /* compute adsr */
+          float adsr = env_process (self, voice, gate);
+          adsr = adsr < 1.001f ? adsr : 0.0f;
+
+          if (adsr > 0.0f)
             {
-              sp_blsaw_compute (
-                self->sp, key->blsaws[j], NULL,
-                &self->sp->out[0]);
-
-              float proximity_to_voice1 =
-                ((float) (7 - j) / 7.f);
-
-              /* add amount * the distance from voice1,
-               * so when the amount is higher, the voice
-               * becomes louder
-               *
-               * multiply by something between 0 and 1 to
-               * adjust */
-              proximity_to_voice1 +=
-                *self->amount * (1.f - proximity_to_voice1) *
-                0.9f;
-
-              float val =
-                self->sp->out[0] * adsr * proximity_to_voice1;
+              float val_l, val_r;
+              process_oscs (
+                voice, gains_l, gains_r,
+                &val_l, &val_r);
 
               /* multiply by velocity */
-              val *= normalized_vel;
+              float mult = adsr * voice->vel * voice->fade;
+              out_l[k] += val_l * mult;
+              out_r[k] += val_r * mult;
+            }
 
-              if (j % 2 == 0)
-                {
-                  *current_l += val * 0.8f;
-                  /* spread the first saw more evenly */
-                  if (j == 0)
-                    *current_r += val * 0.64f;
-                  else
-                    *current_r += val * 0.2f;
-                }
-              else
+          if (voice->fade_step > 0.f)
+            {
+              voice->fade -= voice->fade_step;
+              if (voice->fade <= 0.f)
                 {
-                  *current_l += val * 0.2f;
-                  *current_r += val * 0.8f;
+                  voice_finish_steal (self, voice);
+                  if (voice->key < 0)
+                    break;
+
+                  gate =
+                    (float) self->keys[voice->key].pressed;
                 }
             }
-
-          key->last_adsr = adsr;
         }
     }
 
   /* bring the volume down based on the amount */
-  *current_l *= *self->amount * 0.7f + (1.f - *self->amount);
-  *current_r *= *self->amount * 0.7f + (1.f - *self->amount);
+  float vol_mult =
+    *self->amount * 0.7f + (1.f - *self->amount);
+  for (uint32_t k = 0; k < nframes; k++)
+    {
+      out_l[k] *= vol_mult;
+      out_r[k] *= vol_mult;
+    }
 
-#if 0
-  /* compress */
-  sp_compressor_compute (
-    self->sp, self->compressor, current_l, current_l);
-  sp_compressor_compute (
-    self->sp, self->compressor, current_r, current_r);
-
-  /* saturate - for some reason it makes noise when it's
-   * silent */
-  if (fabsf (*current_l) > 0.001f ||
-      fabsf (*current_r) > 0.001f)
-    {
-      float saturated = 0;
-      sp_saturator_compute (
-        self->sp, self->saturator, current_l,
-        &saturated);
-      *current_l += saturated;
-      sp_saturator_compute (
-        self->sp, self->saturator, current_r,
-        &saturated);
-      *current_r += saturated;
-    }
-
-  /* distort */
-  float distortion = 0;
-  sp_dist_compute (
-    self->sp, self->distortion, current_l,
-    &distortion);
-  *current_l += distortion;
-  sp_dist_compute (
-    self->sp, self->distortion, current_r,
-    &distortion);
-  *current_r += distortion;
+  float * outs[2] = { out_l, out_r };
+  for (int i = 0; i < 2; i++)
+    {
+      float * out = outs[i];
 
-  /* reverb */
-  sp_zitarev_compute (
-    self->sp, self->reverb,
-    current_l, current_r,
-    current_l, current_r);
-#endif
+      for (uint32_t k = 0; k < nframes; k++)
+        {
+          /* compress */
+          sp_compressor_compute (
+            self->sp, self->compressor[i], &out[k],
+            &out[k]);
+        }
 
-  (*offset)++;
+      /* saturate and distort at a higher rate to
+       * keep the aliasing out of the audible range.
+       * The 1 KiB buffer does not depend on the host
+       * block length, so it stays on the stack
+       * instead of in the scratch arena */
+      float up[DIST_BLOCK * DIST_OVERSAMPLING];
+      for (uint32_t k = 0; k < nframes;
+           k += DIST_BLOCK)
+        {
+          uint32_t len =
+            MIN (DIST_BLOCK, nframes - k);
+          sp_oversample_up (
+            self->sp, self->oversample[i], &out[k],
+            up, len);
+          for (uint32_t j = 0;
+               j < len * DIST_OVERSAMPLING; j++)
+            {
+              /* saturate - for some reason it makes
+               * noise when it's silent */
+              if (fabsf (up[j]) > 0.001f)
+                {
+                  float saturated = 0;
+                  sp_saturator_shape (
+                    self->sp, self->saturator[i],
+                    &up[j], &saturated);
+                  up[j] += saturated;
+                }
+
+              /* distort */
+              float distortion = 0;
+              sp_dist_compute (
+                self->sp, self->distortion, &up[j],
+                &distortion);
+              up[j] += distortion;
+            }
+          sp_oversample_down (
+            self->sp, self->oversample[i], up,
+            &out[k], len);
+        }
+    }
+
+  /* reverb */
+  for (uint32_t k = 0; k < nframes; k++)
+    {
+      sp_zitarev_compute (
+        self->sp, self->reverb,
+        &out_l[k], &out_r[k],
+        &out_l[k], &out_r[k]);
+    }
 }
 
 static void
@@ -571,16 +1160,19 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
 #ifndef RELEASE
 #if 0
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  long int ms = tp.tv_sec * 1000000 + tp.tv_usec;
+  uint64_t start_time = plugin_trace_now ();
 #endif
 #endif
 
   uint32_t processed = 0;
 
+  limit_voices (self);
+
   if (!math_floats_equal (self->last_amount, *self->amount))
     {
       /* send a message to the worker to calculate new
@@ -603,6 +1195,15 @@ run (
     {
       if (ev->body.type == PL_URIS (self)->midi_MidiEvent)
         {
+          /* process up to the event */
+          uint32_t ev_frames = (uint32_t) ev->time.frames;
+          if (ev_frames > processed)
+            {
+              process (
+                self, processed, ev_frames - processed);
+              processed = ev_frames;
+            }
+
           const uint8_t * const msg =
             (const uint8_t *) (ev + 1);
           switch (lv2_midi_message_type(msg))
@@ -615,8 +1216,8 @@ run (
                 }
               else
                 {
-                  self->keys[msg[1]].pressed = 1;
-                  self->keys[msg[1]].vel = msg[2];
+                  note_on (
+                    self, msg[1], (float) msg[2] / 127.f);
                 }
               break;
             case LV2_MIDI_MSG_NOTE_OFF:
@@ -636,10 +1237,6 @@ run (
               /*printf ("unknown MIDI message\n");*/
               break;
             }
-          while (processed < ev->time.frames)
-            {
-              process (self, &processed);
-            }
         }
       if (lv2_atom_forge_is_object_type (
             FORGE (self), ev->body.type))
@@ -652,37 +1249,31 @@ run (
         }
     }
 
-  for (uint32_t i = processed; i < n_samples; i++)
+  if (processed < n_samples)
     {
-      process (self, &processed);
+      process (self, processed, n_samples - processed);
     }
 
   self->last_amount = *self->amount;
 
 #ifndef RELEASE
 #if 0
-  gettimeofday(&tp, NULL);
-  ms = (tp.tv_sec * 1000000 + tp.tv_usec) - ms;
-  printf("us taken %ld\n", ms);
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "us taken %.0f\n",
+    (double) (plugin_trace_now () - start_time) /
+      1000.0);
 #endif
 #endif
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
 deactivate (
   LV2_Handle instance)
 {
-  Saw * self = (Saw *) instance;
-
-  for (int i = 0; i < 128; i++)
-    {
-      MidiKey * key = &self->keys[i];
-      for (int j = 0; j < 7; j++)
-        {
-          sp_blsaw_destroy (&key->blsaws[j]);
-        }
-    }
-  sp_destroy (&self->sp);
 }
 
 static void
@@ -690,7 +1281,18 @@ cleanup (
   LV2_Handle instance)
 {
   Saw * self = (Saw *) instance;
-  free (self);
+
+  for (int i = 0; i < 2; i++)
+    {
+      sp_compressor_destroy (&self->compressor[i]);
+      sp_saturator_destroy (&self->saturator[i]);
+      sp_oversample_destroy (&self->oversample[i]);
+    }
+  sp_dist_destroy (&self->distortion);
+  sp_zitarev_destroy (&self->reverb);
+  sp_destroy (&self->sp);
+  plugin_common_cleanup (&self->common.pl_common);
+  plugin_aligned_free (self);
 }
 
 static const void*
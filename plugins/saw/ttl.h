@@ -87,5 +87,23 @@ print_ttl (FILE * f)
     lv2:index 4 ;\n\
     lv2:symbol \"out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n\n", 0.12, 0.0, 1.0);
+  ]", 0.12, 0.0, 1.0);
+
+  plugin_print_dsp_load_ttl (f, SUPERSAW_DSP_LOAD);
+  fprintf (f,
+" , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index %d ;\n\
+    lv2:symbol \"polyphony\" ;\n\
+    lv2:name \"Polyphony\" ;\n\
+    rdfs:comment \"Maximum number of voices sounding at the same time\" ;\n\
+    lv2:default %d ;\n\
+    lv2:minimum %d ;\n\
+    lv2:maximum %d ;\n\
+    lv2:portProperty lv2:integer ;\n\
+  ]",
+    SUPERSAW_MAX_POLYPHONY, SAW_DEFAULT_POLYPHONY, 1,
+    SAW_MAX_VOICES);
+  fprintf (f, " .\n\n");
 }
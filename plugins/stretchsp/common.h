@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_STRETCH_COMMON_H__
+#define __Z_STRETCH_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include "../common.h"
+
+/** Length of the input history in seconds,
+ * allocated at instantiation. This is how far
+ * behind the input the stretched signal can get,
+ * and the longest loop when frozen. */
+#define STRETCH_HISTORY_TIME 8.f
+
+typedef enum StretchWindow
+{
+  STRETCH_WINDOW_100MS,
+  STRETCH_WINDOW_250MS,
+  STRETCH_WINDOW_500MS,
+  STRETCH_WINDOW_1S,
+  NUM_STRETCH_WINDOWS,
+} StretchWindow;
+
+/** Window sizes in seconds. */
+static const float stretch_window_times[] = {
+  0.1f, 0.25f, 0.5f, 1.f,
+};
+
+typedef struct StretchUris
+{
+  /* custom URIs for communication with the
+   * worker */
+  LV2_URID stretch_computeFrame;
+} StretchUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  STRETCH_CONTROL,
+  /** Plugin to UI communication. */
+  STRETCH_NOTIFY,
+
+  STRETCH_STEREO_IN_L,
+  STRETCH_STEREO_IN_R,
+
+  /** Stretch factor. */
+  STRETCH_STRETCH,
+  /** Window size (StretchWindow). */
+  STRETCH_WINDOW,
+  /** Whether to stop recording and loop the
+   * history. */
+  STRETCH_FREEZE,
+  STRETCH_MIX,
+
+  /** Outputs. */
+  STRETCH_STEREO_OUT_L,
+  STRETCH_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  STRETCH_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  STRETCH_ENABLED,
+
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo stretch_params[] = {
+  { STRETCH_STRETCH, "stretch",
+    "Stretch", 1.f, 50.f },
+  { STRETCH_WINDOW, "window",
+    "Window", 0.f, (float) (NUM_STRETCH_WINDOWS - 1) },
+  { STRETCH_FREEZE, "freeze",
+    "Freeze", 0.f, 1.f },
+  { STRETCH_MIX, "mix",
+    "Mix", 0.f, 1.f },
+};
+
+#define STRETCH_NUM_PARAMS \
+  ((int) (sizeof (stretch_params) / \
+          sizeof (stretch_params[0])))
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct StretchCommon
+{
+  /** URIs. */
+  StretchUris     uris;
+
+  PluginCommon    pl_common;
+
+} StretchCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map*   urid_map,
+  StretchCommon * stretch_common)
+{
+  map_common_uris (
+    urid_map, &stretch_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  stretch_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+  MAP (stretch_computeFrame, PLUGIN_URI "#computeFrame");
+
+#undef MAP
+}
+
+#endif
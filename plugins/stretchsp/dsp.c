@@ -0,0 +1,785 @@
+/*
+ * Copyright (C) 2021 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+/** Number of frame slots shared with the worker. */
+#define NUM_FRAMES 5
+
+/** How many hops ahead frames are computed. With
+ * the 2 frames being overlapped, this must not be
+ * more than \ref NUM_FRAMES - 2. */
+#define LOOKAHEAD 3
+
+/** Frame index of a slot that was never used. */
+#define NO_FRAME UINT32_MAX
+
+/**
+ * A spectral frame, computed by the worker and
+ * overlap-added by the audio thread.
+ *
+ * The slot is handed over with \ref
+ * StretchFrame.done: the worker stores the frame
+ * index there after filling the buffers, and the
+ * audio thread only touches the buffers while it
+ * is equal to \ref StretchFrame.requested.
+ */
+typedef struct StretchFrame
+{
+  /** Index of the last frame requested for this
+   * slot. Only used by the audio thread. */
+  uint32_t      requested;
+
+  /** Index of the last frame the worker finished
+   * in this slot. */
+  atomic_uint   done;
+
+  /** Window size of the frame (StretchWindow). */
+  int           window;
+
+  /** Windowed frame of each channel, of up to the
+   * largest window size. */
+  SPFLOAT *     buf[2];
+} StretchFrame;
+
+/**
+ * Message asking the worker for a frame.
+ */
+typedef struct StretchFrameMessage
+{
+  LV2_Atom      atom;
+
+  /** Slot to compute the frame in. */
+  StretchFrame * frame;
+
+  /** Index of the frame. */
+  uint32_t      index;
+
+  int           window;
+
+  /** Position of the first input sample of the
+   * frame. */
+  int64_t       read_pos;
+
+  /** Input before this position is silence. */
+  int64_t       valid_from;
+} StretchFrameMessage;
+
+typedef struct Stretch
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * stereo_in_l;
+  const float * stereo_in_r;
+  const float * stretch;
+  const float * window;
+  const float * freeze;
+  const float * mix;
+
+  /* outputs */
+  float *       stereo_out_l;
+  float *       stereo_out_r;
+
+  /** Input history of each channel, a ring buffer
+   * of \ref Stretch.history_mask + 1 samples. */
+  float *       history[2];
+  uint32_t      history_mask;
+
+  /** Number of input samples written so far. */
+  int64_t       write_pos;
+
+  /** Input before this position is silence (the
+   * history is not cleared on reset). */
+  int64_t       valid_from;
+
+  /** Input position of the next frame to
+   * request. */
+  double        read_pos;
+
+  /** How far the frames can lag behind the input,
+   * and the longest loop when frozen, in samples.
+   * The history is longer, so that it is not
+   * overwritten while the frames are computed. */
+  int64_t       max_lag;
+
+  StretchFrame  frames[NUM_FRAMES];
+
+  /** Index of the next frame to play. */
+  uint32_t      next_frame;
+
+  /** Index of the next frame to request. */
+  uint32_t      scheduled;
+
+  /** Frames overlapped in the current hop, or
+   * NULL. */
+  StretchFrame * cur;
+  StretchFrame * prev;
+
+  /** Position in and length of the current hop,
+   * which is half a window. */
+  uint32_t      hop_pos;
+  uint32_t      hop_len;
+
+  /** Silence read in place of missing frames. */
+  SPFLOAT *     zeros;
+
+  /** One per window size, used by the worker for
+   * the FFTs and by the audio thread for the
+   * window compensation. */
+  sp_paulstretch * ps[NUM_STRETCH_WINDOWS];
+
+  /** Only used by the worker, for the random
+   * phases. */
+  sp_data *     sp;
+
+  StretchCommon common;
+} Stretch;
+
+/**
+ * Starts over from the current input, so that old
+ * material is not heard when the plugin is enabled
+ * again.
+ *
+ * Frames still being computed are left to the
+ * worker and skipped.
+ */
+static void
+reset (
+  void * user_data)
+{
+  Stretch * self = (Stretch *) user_data;
+
+  self->valid_from = self->write_pos;
+  self->read_pos = (double) self->write_pos;
+  self->next_frame = self->scheduled;
+  self->cur = NULL;
+  self->prev = NULL;
+  self->hop_pos = 0;
+  self->hop_len = 0;
+}
+
+static LV2_Worker_Status
+work (
+  LV2_Handle                  instance,
+  LV2_Worker_Respond_Function respond,
+  LV2_Worker_Respond_Handle   handle,
+  uint32_t                    size,
+  const void *                data)
+{
+  Stretch * self = (Stretch *) instance;
+
+  const LV2_Atom * atom =
+    (const LV2_Atom *) data;
+  if (atom->type !=
+        self->common.uris.stretch_computeFrame)
+    return LV2_WORKER_SUCCESS;
+
+  const StretchFrameMessage * msg =
+    (const StretchFrameMessage *) data;
+  StretchFrame * frame = msg->frame;
+  sp_paulstretch * ps = self->ps[msg->window];
+  uint32_t ws = ps->windowsize;
+  for (int ch = 0; ch < 2; ch++)
+    {
+      SPFLOAT * buf = frame->buf[ch];
+      const float * history = self->history[ch];
+      for (uint32_t i = 0; i < ws; i++)
+        {
+          int64_t pos = msg->read_pos + i;
+          buf[i] =
+            pos < msg->valid_from ?
+              0.f :
+              history[(uint64_t) pos & self->history_mask];
+        }
+      sp_paulstretch_frame (self->sp, ps, buf);
+    }
+
+  /* hand the frame over to the audio thread */
+  atomic_store_explicit (
+    &frame->done, msg->index, memory_order_release);
+
+  return LV2_WORKER_SUCCESS;
+}
+
+static LV2_Worker_Status
+work_response (
+  LV2_Handle  instance,
+  uint32_t    size,
+  const void* data)
+{
+  /* frames are handed over through their slots */
+  return LV2_WORKER_SUCCESS;
+}
+
+/**
+ * Frees the buffers allocated by alloc_buffers().
+ */
+static void
+free_buffers (
+  Stretch * self)
+{
+  for (int i = 0; i < NUM_STRETCH_WINDOWS; i++)
+    {
+      if (self->ps[i])
+        sp_paulstretch_destroy (&self->ps[i]);
+    }
+  if (self->sp)
+    sp_destroy (&self->sp);
+  for (int i = 0; i < NUM_FRAMES; i++)
+    {
+      free (self->frames[i].buf[0]);
+      free (self->frames[i].buf[1]);
+    }
+  free (self->history[0]);
+  free (self->history[1]);
+  free (self->zeros);
+}
+
+/**
+ * Allocates the history, the frame slots and the
+ * FFT state of each window size.
+ *
+ * Everything is allocated at instantiation, since
+ * the worker may use it before activation.
+ *
+ * @return Non-zero on fail.
+ */
+static int
+alloc_buffers (
+  Stretch * self,
+  double    rate)
+{
+  sp_create (&self->sp);
+  self->sp->sr = (int) rate;
+  sp_srand (self->sp, 1);
+  uint32_t max_window = 0;
+  for (int i = 0; i < NUM_STRETCH_WINDOWS; i++)
+    {
+      sp_paulstretch_create (&self->ps[i]);
+      sp_paulstretch_init (
+        self->sp, self->ps[i], NULL,
+        stretch_window_times[i], 1);
+      max_window =
+        MAX (max_window, self->ps[i]->windowsize);
+    }
+
+  uint32_t history_size = 1;
+  while (history_size <
+           (uint32_t) (rate * STRETCH_HISTORY_TIME) +
+           (LOOKAHEAD + 1) * max_window)
+    history_size <<= 1;
+  self->history_mask = history_size - 1;
+  self->max_lag =
+    (int64_t) (rate * STRETCH_HISTORY_TIME);
+
+  self->zeros = calloc (max_window, sizeof (SPFLOAT));
+  if (!self->zeros)
+    return -1;
+  for (int ch = 0; ch < 2; ch++)
+    {
+      self->history[ch] =
+        calloc (history_size, sizeof (float));
+      if (!self->history[ch])
+        return -1;
+    }
+  for (int i = 0; i < NUM_FRAMES; i++)
+    {
+      StretchFrame * frame = &self->frames[i];
+      frame->requested = NO_FRAME;
+      atomic_init (&frame->done, NO_FRAME);
+      for (int ch = 0; ch < 2; ch++)
+        {
+          frame->buf[ch] =
+            calloc (max_window, sizeof (SPFLOAT));
+          if (!frame->buf[ch])
+            return -1;
+        }
+    }
+
+  return 0;
+}
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  Stretch * self = calloc (1, sizeof (Stretch));
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 1);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, stretch_params, STRETCH_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, reset, self))
+    goto fail;
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  if (alloc_buffers (self, rate))
+    {
+      lv2_log_error (
+        &pl_common->logger,
+        "Failed to allocate the stretch buffers\n");
+      goto fail;
+    }
+
+  return (LV2_Handle) self;
+
+fail:
+  free_buffers (self);
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  Stretch * self = (Stretch *) instance;
+
+  switch ((PortIndex) port)
+    {
+    case STRETCH_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case STRETCH_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case STRETCH_STEREO_IN_L:
+      self->stereo_in_l = (const float *) data;
+      break;
+    case STRETCH_STEREO_IN_R:
+      self->stereo_in_r = (const float *) data;
+      break;
+    case STRETCH_STRETCH:
+      self->stretch =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case STRETCH_WINDOW:
+      self->window =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case STRETCH_FREEZE:
+      self->freeze =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case STRETCH_MIX:
+      self->mix =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case STRETCH_STEREO_OUT_L:
+      self->stereo_out_l = (float *) data;
+      break;
+    case STRETCH_STEREO_OUT_R:
+      self->stereo_out_r = (float *) data;
+      break;
+    case STRETCH_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case STRETCH_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  Stretch * self = (Stretch *) instance;
+
+  reset (self);
+}
+
+static inline int
+get_window (
+  Stretch * self)
+{
+  int window =
+    math_round_float_to_int (*self->window);
+  return CLAMP (window, 0, NUM_STRETCH_WINDOWS - 1);
+}
+
+/**
+ * Returns the input position of the next frame of
+ * the given size and moves past it.
+ *
+ * Live input is followed at the stretch rate,
+ * without stretching the silence before it, and
+ * the frames jump to the present when they lag
+ * more than \ref Stretch.max_lag behind. When
+ * frozen, the frames loop over the recorded input
+ * instead.
+ */
+static int64_t
+advance_read_pos (
+  Stretch * self,
+  uint32_t  ws)
+{
+  double read_pos = self->read_pos;
+  int64_t end = self->write_pos;
+  if (*self->freeze > 0.5f)
+    {
+      int64_t len =
+        MIN (self->max_lag, end - self->valid_from);
+      double lo = (double) (end - len);
+      double hi = (double) (end - ws);
+      if (hi <= lo)
+        read_pos = hi;
+      else if (read_pos < lo)
+        read_pos = lo;
+      else if (read_pos > hi)
+        read_pos = lo + fmod (read_pos - lo, hi - lo);
+    }
+  else
+    {
+      if ((double) end - read_pos >
+            (double) self->max_lag)
+        read_pos = (double) (end - ws);
+      read_pos =
+        MAX (
+          read_pos,
+          (double) self->valid_from - (double) ws * 0.5);
+      read_pos = MIN (read_pos, (double) (end - ws));
+    }
+
+  float stretch = CLAMP (*self->stretch, 1.f, 50.f);
+  self->read_pos =
+    read_pos + (double) ws * 0.5 / (double) stretch;
+
+  int64_t ipos = (int64_t) read_pos;
+  if ((double) ipos > read_pos)
+    ipos--;
+  return ipos;
+}
+
+/**
+ * Asks the worker for the frames up to \ref
+ * LOOKAHEAD hops ahead, in the slots it is done
+ * with.
+ */
+static void
+request_frames (
+  Stretch * self)
+{
+  if ((int32_t) (self->scheduled - self->next_frame) < 0)
+    self->scheduled = self->next_frame;
+
+  int window = get_window (self);
+  uint32_t ws = self->ps[window]->windowsize;
+  while ((int32_t) (self->scheduled - self->next_frame) <
+           LOOKAHEAD)
+    {
+      uint32_t index = self->scheduled;
+      StretchFrame * frame =
+        &self->frames[index % NUM_FRAMES];
+      if (frame == self->cur || frame == self->prev ||
+          atomic_load_explicit (
+            &frame->done, memory_order_acquire) !=
+            frame->requested)
+        break;
+
+      /* set before scheduling, since the host may
+       * run the work right away */
+      uint32_t prev_requested = frame->requested;
+      frame->requested = index;
+      frame->window = window;
+      double prev_read_pos = self->read_pos;
+      StretchFrameMessage msg = {
+        { sizeof (msg) - sizeof (LV2_Atom),
+          self->common.uris.stretch_computeFrame },
+        frame, index, window,
+        advance_read_pos (self, ws), self->valid_from };
+      if (SCHEDULE (self)->schedule_work (
+            SCHEDULE (self)->handle,
+            sizeof (msg), &msg) != LV2_WORKER_SUCCESS)
+        {
+          frame->requested = prev_requested;
+          self->read_pos = prev_read_pos;
+          break;
+        }
+
+      self->scheduled++;
+    }
+}
+
+/**
+ * Moves to the next hop, overlapping the next frame
+ * with the current one.
+ *
+ * If the next frame is not ready yet, or has a
+ * different window size, the current frame fades
+ * out alone instead.
+ */
+static void
+start_hop (
+  Stretch * self)
+{
+  request_frames (self);
+
+  StretchFrame * next =
+    &self->frames[self->next_frame % NUM_FRAMES];
+  int ready =
+    next->requested == self->next_frame &&
+    atomic_load_explicit (
+      &next->done, memory_order_acquire) ==
+      self->next_frame;
+
+  self->prev = self->cur;
+  if (ready &&
+      (!self->cur || self->cur->window == next->window))
+    {
+      self->cur = next;
+      self->next_frame++;
+    }
+  else
+    {
+      self->cur = NULL;
+    }
+
+  StretchFrame * frame =
+    self->cur ? self->cur : self->prev;
+  int window =
+    frame ? frame->window : get_window (self);
+  self->hop_len = self->ps[window]->half_windowsize;
+  self->hop_pos = 0;
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Stretch * self = (Stretch *) user_data;
+  float mix = CLAMP (*self->mix, 0.f, 1.f);
+  int freeze = *self->freeze > 0.5f;
+  const float * in[2] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[2] = {
+    self->stereo_out_l, self->stereo_out_r };
+
+  uint32_t end = offset + nframes;
+  uint32_t i = offset;
+  while (i < end)
+    {
+      if (self->hop_pos >= self->hop_len)
+        start_hop (self);
+
+      StretchFrame * frame =
+        self->cur ? self->cur : self->prev;
+      sp_paulstretch * ps =
+        self->ps[
+          frame ? frame->window : get_window (self)];
+      const SPFLOAT * hinv = ps->hinv_buf;
+      float scale = 1.f / (float) ps->windowsize;
+      uint32_t half = ps->half_windowsize;
+      const SPFLOAT * cur[2];
+      const SPFLOAT * prev[2];
+      for (int ch = 0; ch < 2; ch++)
+        {
+          cur[ch] =
+            self->cur ? self->cur->buf[ch] : self->zeros;
+          prev[ch] =
+            self->prev ?
+              &self->prev->buf[ch][half] : self->zeros;
+        }
+
+      /* the rest of the hop, or of the block */
+      uint32_t len =
+        MIN (end - i, self->hop_len - self->hop_pos);
+      uint32_t j = self->hop_pos;
+      for (uint32_t k = i; k < i + len; k++, j++)
+        {
+          /* read both inputs before writing, since
+           * the host may connect an output to
+           * either input */
+          float in_l = in[0][k];
+          float in_r = in[1][k];
+          if (!freeze)
+            {
+              uint32_t pos =
+                (uint32_t) self->write_pos &
+                self->history_mask;
+              self->history[0][pos] = in_l;
+              self->history[1][pos] = in_r;
+              self->write_pos++;
+            }
+
+          float gain = (float) hinv[j] * scale;
+          float wet_l =
+            (float) (cur[0][j] + prev[0][j]) * gain;
+          float wet_r =
+            (float) (cur[1][j] + prev[1][j]) * gain;
+          out[0][k] = in_l * (1.f - mix) + wet_l * mix;
+          out[1][k] = in_r * (1.f - mix) + wet_r * mix;
+        }
+      self->hop_pos = j;
+      i += len;
+    }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Stretch * self = (Stretch *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  Stretch * self = (Stretch *) instance;
+  free_buffers (self);
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  static const LV2_Worker_Interface worker =
+    { work, work_response, NULL };
+  if (!strcmp(uri, LV2_WORKER__interface))
+    {
+      return &worker;
+    }
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
@@ -45,6 +45,8 @@ typedef enum PortIndex
 
   /** Outputs. */
   TEST_PLUGIN_MIDI_OUT,
+  /** Average DSP load of the plugin. */
+  TEST_PLUGIN_DSP_LOAD,
 
   NUM_PORTS,
 } PortIndex;
@@ -117,6 +117,11 @@ instantiate (
             }
         }
     }
+  lv2_log_note (
+    &pl_common->logger,
+    "Block length: max %u, nominal %u\n",
+    pl_common->max_block_length,
+    pl_common->nominal_block_length);
 
   return (LV2_Handle) self;
 
@@ -150,6 +155,10 @@ connect_port (
       self->midi_out =
         (LV2_Atom_Sequence *) data;
       break;
+    case TEST_PLUGIN_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
     default:
       break;
     }
@@ -175,6 +184,9 @@ run (
     return;
 #endif
 
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
   const uint32_t out_capacity =
     self->midi_out->atom.size;
 
@@ -210,6 +222,9 @@ run (
             }
         }
     }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -224,6 +239,7 @@ cleanup (
   LV2_Handle instance)
 {
   TestPlugin * self = (TestPlugin *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
 }
 
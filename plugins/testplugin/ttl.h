@@ -88,5 +88,8 @@ print_ttl (FILE * f)
     lv2:symbol \"midi_out\" ;\n\
     lv2:name \"MIDI out\" ;\n\
     rdfs:comment \"MIDI output\" ;\n\
-  ] .\n\n");
+  ]");
+
+  plugin_print_dsp_load_ttl (f, TEST_PLUGIN_DSP_LOAD);
+  fprintf (f, " .\n\n");
 }
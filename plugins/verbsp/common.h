@@ -57,10 +57,47 @@ typedef enum PortIndex
   /** Outputs. */
   VERB_STEREO_OUT_L,
   VERB_STEREO_OUT_R,
+  /** Average DSP load of the plugin. */
+  VERB_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  VERB_ENABLED,
 
   NUM_PORTS,
 } PortIndex;
 
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo verb_params[] = {
+  { VERB_PREDELAY, "in_delay",
+    "Pre-delay", 10.f, 100.f },
+  { VERB_LOW_FREQ_CROSSOVER, "lf_x",
+    "Low freq crossover", 50.f, 1000.f },
+  { VERB_DECAY_60_LOW, "rt60_low",
+    "Low freq decay", 1.f, 8.f },
+  { VERB_DECAY_60_MID, "rt60_mid",
+    "Mid freq decay", 1.f, 8.f },
+  { VERB_HF_DAMPING, "hf_damping",
+    "High freq damping", 1500.f, 47040.f },
+  { VERB_EQ1_FREQ, "eq1_freq",
+    "EQ1 freq", 40.f, 2500.f },
+  { VERB_EQ1_LEVEL, "eq1_level",
+    "EQ1 level", -15.f, 15.f },
+  { VERB_EQ2_FREQ, "eq2_freq",
+    "EQ2 freq", 160.f, 12000.f },
+  { VERB_EQ2_LEVEL, "eq2_level",
+    "EQ2 level", -15.f, 15.f },
+  { VERB_WET, "wet",
+    "Wet", 0.f, 1.f },
+  { VERB_LEVEL, "level",
+    "Level", -70.f, 20.f },
+};
+
+#define VERB_NUM_PARAMS \
+  ((int) (sizeof (verb_params) / \
+          sizeof (verb_params[0])))
+
 /**
  * Group of variables needed by both the DSP and
  * the UI.
@@ -83,6 +83,14 @@ instantiate (
   /* map uris */
   map_uris (pl_common->map, &self->common);
 
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, verb_params, VERB_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 2, NULL, NULL))
+    goto fail;
+
   /* init atom forge */
   lv2_atom_forge_init (
     &pl_common->forge, pl_common->map);
@@ -94,6 +102,7 @@ instantiate (
   return (LV2_Handle) self;
 
 fail:
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
   return NULL;
 }
@@ -108,7 +117,9 @@ connect_port (
 
 #define SET_FLOAT_INPUT(caps,sc) \
   case VERB_##caps: \
-    self->sc = (const float *) data; \
+    self->sc = \
+      plugin_params_connect ( \
+        &self->common.pl_common, port, data); \
     break
 
   switch ((PortIndex) port)
@@ -140,6 +151,14 @@ connect_port (
     case VERB_STEREO_OUT_R:
       self->stereo_out_r = (float *) data;
       break;
+    case VERB_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case VERB_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
     default:
       break;
     }
@@ -156,33 +175,18 @@ activate (
   sp_zitarev_init (self->sp, self->rev);
 }
 
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
 static void
-run (
-  LV2_Handle instance,
-  uint32_t n_samples)
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
 {
-  Verb * self = (Verb *) instance;
-
-#ifdef TRIAL_VER
-  if (get_time_since_instantiation (
-        &self->common.pl_common) > SECONDS_TO_SILENCE)
-    return;
-#endif
-
-#if 0
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  long int ms = tp.tv_sec * 1000000 + tp.tv_usec;
-#endif
-
-  /* read incoming events from host and UI */
-  LV2_ATOM_SEQUENCE_FOREACH (
-    self->control, ev)
-    {
-      /* TODO */
-    }
+  Verb * self = (Verb *) user_data;
 
-  /* compress */
   *self->rev->in_delay = *self->predelay;
   *self->rev->lf_x = *self->low_freq_x;
   *self->rev->rt60_low = *self->decay_60_low;
@@ -194,7 +198,7 @@ run (
   *self->rev->eq2_level = *self->eq2_level;
   *self->rev->mix = *self->wet;
   *self->rev->level = *self->level;
-  for (uint32_t i = 0; i < n_samples; i++)
+  for (uint32_t i = offset; i < offset + nframes; i++)
     {
       float current_in[2] = {
         self->stereo_in_l[i], self->stereo_in_r[i],
@@ -204,12 +208,62 @@ run (
         &current_in[0], &current_in[1],
         &self->stereo_out_l[i], &self->stereo_out_r[i]);
     }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Verb * self = (Verb *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
 
 #if 0
-  gettimeofday(&tp, NULL);
-  ms = (tp.tv_sec * 1000000 + tp.tv_usec) - ms;
-  printf("us taken %ld\n", ms);
+  uint64_t start_time = plugin_trace_now ();
 #endif
+
+  const float * in[] = {
+    self->stereo_in_l, self->stereo_in_r };
+  float * out[] = {
+    self->stereo_out_l, self->stereo_out_r };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+#if 0
+  plugin_trace (
+    &self->common.pl_common, Trace,
+    "us taken %.0f\n",
+    (double) (plugin_trace_now () - start_time) /
+      1000.0);
+#endif
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
 }
 
 static void
@@ -227,6 +281,7 @@ cleanup (
   LV2_Handle instance)
 {
   Verb * self = (Verb *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
   free (self);
 }
 
@@ -26,6 +26,7 @@ print_ttl (FILE * f)
 @prefix log:  <http://lv2plug.in/ns/ext/log#> .\n\
 @prefix lv2:  <http://lv2plug.in/ns/lv2core#> .\n\
 @prefix midi: <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
 @prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
 @prefix rdf:  <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
 @prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n\
@@ -214,7 +215,7 @@ print_ttl (FILE * f)
     lv2:index 16 ;\n\
     lv2:symbol \"stereo_out_r\" ;\n\
     lv2:name \"Stereo Out R\" ;\n\
-  ] .\n",
+  ]",
     /* predelay */
     40.0, 10.0, 100.0,
     /* low freq crossover */
@@ -238,4 +239,9 @@ print_ttl (FILE * f)
     /* level */
     -20.0, -70.0, 20.0
     );
+
+  plugin_print_dsp_load_ttl (f, VERB_DSP_LOAD);
+  plugin_print_enabled_ttl (f, VERB_ENABLED);
+  plugin_print_params_ttl (
+    f, verb_params, VERB_NUM_PARAMS);
 }
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Common code for both the DSP and the UI.
+ */
+
+#ifndef __Z_VOCODER_COMMON_H__
+#define __Z_VOCODER_COMMON_H__
+
+#include PLUGIN_CONFIG
+
+#include "../common.h"
+
+/** Max number of bands, allocated at activation. */
+#define VOCODER_MAX_BANDS 64
+
+typedef struct VocoderUris
+{
+} VocoderUris;
+
+typedef enum PortIndex
+{
+  /** GUI to plugin communication. */
+  VOCODER_CONTROL,
+  /** Plugin to UI communication. */
+  VOCODER_NOTIFY,
+
+  /** Signal to be filtered, usually a synth. */
+  VOCODER_CARRIER_IN,
+  /** Signal whose spectral envelope is applied to
+   * the carrier, usually a voice. */
+  VOCODER_MODULATOR_IN,
+
+  VOCODER_BANDS,
+  VOCODER_ATTACK,
+  VOCODER_RELEASE,
+  VOCODER_BANDWIDTH,
+  VOCODER_LOW_FREQ,
+  VOCODER_HIGH_FREQ,
+  VOCODER_GAIN,
+
+  /** Outputs. */
+  VOCODER_OUT,
+  /** Average DSP load of the plugin. */
+  VOCODER_DSP_LOAD,
+  /** Bypass switch, designated lv2:enabled. */
+  VOCODER_ENABLED,
+
+  NUM_PORTS,
+} PortIndex;
+
+/**
+ * Control ports that can also be automated with
+ * patch:Set events.
+ */
+static const PluginParamInfo vocoder_params[] = {
+  { VOCODER_BANDS, "bands",
+    "Bands", 4.f, 64.f },
+  { VOCODER_ATTACK, "attack",
+    "Attack", 0.0001f, 0.5f },
+  { VOCODER_RELEASE, "release",
+    "Release", 0.0001f, 0.5f },
+  { VOCODER_BANDWIDTH, "bandwidth",
+    "Bandwidth", 0.1f, 2.f },
+  { VOCODER_LOW_FREQ, "low_freq",
+    "Low Frequency", 20.f, 1000.f },
+  { VOCODER_HIGH_FREQ, "high_freq",
+    "High Frequency", 1000.f, 20000.f },
+  { VOCODER_GAIN, "gain",
+    "Gain", -24.f, 24.f },
+};
+
+#define VOCODER_NUM_PARAMS \
+  ((int) (sizeof (vocoder_params) / \
+          sizeof (vocoder_params[0])))
+
+/**
+ * Group of variables needed by both the DSP and
+ * the UI.
+ */
+typedef struct VocoderCommon
+{
+  /** URIs. */
+  VocoderUris  uris;
+
+  PluginCommon    pl_common;
+
+} VocoderCommon;
+
+static inline void
+map_uris (
+  LV2_URID_Map*   urid_map,
+  VocoderCommon * vocoder_common)
+{
+  map_common_uris (
+    urid_map, &vocoder_common->pl_common.uris);
+
+#define MAP(x,uri) \
+  vocoder_common->uris.x = \
+    urid_map->map (urid_map->handle, uri)
+
+  /* custom URIs */
+
+#undef MAP
+}
+
+#endif
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include PLUGIN_CONFIG
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "../math.h"
+#include PLUGIN_COMMON
+
+#include "soundpipe.h"
+
+typedef struct Vocoder
+{
+  /** Plugin ports. */
+  const LV2_Atom_Sequence* control;
+  LV2_Atom_Sequence* notify;
+  const float * carrier_in;
+  const float * modulator_in;
+  const float * bands;
+  const float * attack;
+  const float * release;
+  const float * bandwidth;
+  const float * low_freq;
+  const float * high_freq;
+  const float * gain;
+
+  /* outputs */
+  float *       out;
+
+  VocoderCommon common;
+
+  sp_data *     sp;
+  sp_vocbank *  vocbank;
+
+} Vocoder;
+
+/**
+ * Clears the filters and envelopes when the plugin
+ * is enabled again.
+ */
+static void
+reset (
+  void * user_data)
+{
+  Vocoder * self = (Vocoder *) user_data;
+
+  sp_vocbank_clear (self->sp, self->vocbank);
+}
+
+static LV2_Handle
+instantiate (
+  const LV2_Descriptor*     descriptor,
+  double                    rate,
+  const char*               bundle_path,
+  const LV2_Feature* const* features)
+{
+  Vocoder * self = calloc (1, sizeof (Vocoder));
+
+  SET_SAMPLERATE (self, rate);
+
+  PluginCommon * pl_common = &self->common.pl_common;
+  int ret =
+    plugin_common_instantiate (
+      pl_common, features, 0);
+  if (ret)
+    goto fail;
+
+  /* map uris */
+  map_uris (pl_common->map, &self->common);
+
+  /* before the host connects the ports */
+  plugin_params_init (
+    pl_common, vocoder_params, VOCODER_NUM_PARAMS);
+
+  if (plugin_bypass_init (
+        pl_common, 1, reset, self))
+    goto fail;
+
+  /* init atom forge */
+  lv2_atom_forge_init (
+    &pl_common->forge, pl_common->map);
+
+  /* init logger */
+  lv2_log_logger_init (
+    &pl_common->logger, pl_common->map, pl_common->log);
+
+  return (LV2_Handle) self;
+
+fail:
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+  return NULL;
+}
+
+static void
+connect_port (
+  LV2_Handle instance,
+  uint32_t   port,
+  void *     data)
+{
+  Vocoder * self = (Vocoder *) instance;
+
+  switch ((PortIndex) port)
+    {
+    case VOCODER_CONTROL:
+      self->control =
+        (const LV2_Atom_Sequence *) data;
+      break;
+    case VOCODER_NOTIFY:
+      self->notify =
+        (LV2_Atom_Sequence *) data;
+      break;
+    case VOCODER_CARRIER_IN:
+      self->carrier_in = (const float *) data;
+      break;
+    case VOCODER_MODULATOR_IN:
+      self->modulator_in = (const float *) data;
+      break;
+    case VOCODER_BANDS:
+      self->bands =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_ATTACK:
+      self->attack =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_RELEASE:
+      self->release =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_BANDWIDTH:
+      self->bandwidth =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_LOW_FREQ:
+      self->low_freq =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_HIGH_FREQ:
+      self->high_freq =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_GAIN:
+      self->gain =
+        plugin_params_connect (
+          &self->common.pl_common, port, data);
+      break;
+    case VOCODER_OUT:
+      self->out = (float *) data;
+      break;
+    case VOCODER_DSP_LOAD:
+      self->common.pl_common.dsp_load =
+        (float *) data;
+      break;
+    case VOCODER_ENABLED:
+      self->common.pl_common.bypass.enabled =
+        (const float *) data;
+      break;
+    default:
+      break;
+    }
+}
+
+static void
+activate (
+  LV2_Handle instance)
+{
+  Vocoder * self = (Vocoder*) instance;
+
+  sp_create (&self->sp);
+  self->sp->sr = (int) GET_SAMPLERATE (self);
+
+  /* allocate for the max number of bands so that
+   * changing the band count in run() is RT-safe */
+  sp_vocbank_create (&self->vocbank);
+  sp_vocbank_init (
+    self->sp, self->vocbank, VOCODER_MAX_BANDS);
+}
+
+/**
+ * Processes @p nframes samples from @p offset with
+ * the current parameter values.
+ */
+static void
+process (
+  void *   user_data,
+  uint32_t offset,
+  uint32_t nframes)
+{
+  Vocoder * self = (Vocoder *) user_data;
+
+  sp_vocbank * vb = self->vocbank;
+  int bands = math_round_float_to_int (*self->bands);
+  vb->nbands = CLAMP (bands, 1, VOCODER_MAX_BANDS);
+  vb->atk = *self->attack;
+  vb->rel = *self->release;
+  vb->bwratio = *self->bandwidth;
+  vb->fmin = *self->low_freq;
+  vb->fmax = MAX (*self->high_freq, vb->fmin);
+
+  float * out = &self->out[offset];
+  sp_vocbank_compute_block (
+    self->sp, vb,
+    (float *) &self->carrier_in[offset],
+    (float *) &self->modulator_in[offset],
+    out, nframes);
+
+  float gain = sp_fast_db2lin (*self->gain);
+  for (uint32_t i = 0; i < nframes; i++)
+    {
+      out[i] *= gain;
+    }
+}
+
+static void
+run (
+  LV2_Handle instance,
+  uint32_t n_samples)
+{
+  Vocoder * self = (Vocoder *) instance;
+  PluginCommon * pl_common = &self->common.pl_common;
+
+#ifdef TRIAL_VER
+  if (get_time_since_instantiation (
+        &self->common.pl_common) > SECONDS_TO_SILENCE)
+    return;
+#endif
+
+  plugin_run_begin (
+    &self->common.pl_common, self->notify);
+
+  const float * in[] = { self->carrier_in };
+  float * out[] = { self->out };
+  if (plugin_bypass_begin (
+        pl_common, in, out, n_samples))
+    {
+      /* keep track of the parameters only */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        NULL, NULL);
+    }
+  else
+    {
+      /* process the block in parts split at the
+       * parameter changes sent by the host */
+      plugin_params_run (
+        pl_common, self->control, n_samples,
+        self, process);
+      plugin_bypass_end (
+        pl_common, out, n_samples);
+    }
+
+  plugin_run_end (
+    &self->common.pl_common, n_samples);
+}
+
+static void
+deactivate (
+  LV2_Handle instance)
+{
+  Vocoder * self = (Vocoder *) instance;
+
+  sp_destroy (&self->sp);
+  sp_vocbank_destroy (&self->vocbank);
+}
+
+static void
+cleanup (
+  LV2_Handle instance)
+{
+  Vocoder * self = (Vocoder *) instance;
+  plugin_common_cleanup (&self->common.pl_common);
+  free (self);
+}
+
+static const void*
+extension_data (
+  const char * uri)
+{
+  return NULL;
+}
+
+static const LV2_Descriptor descriptor = {
+  PLUGIN_URI,
+  instantiate,
+  connect_port,
+  activate,
+  run,
+  deactivate,
+  cleanup,
+  extension_data
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor*
+lv2_descriptor (
+  uint32_t index)
+{
+  switch (index)
+    {
+    case 0:
+      return &descriptor;
+    default:
+      return NULL;
+    }
+}
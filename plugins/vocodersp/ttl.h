@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2020 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+static void
+print_ttl (FILE * f)
+{
+  fprintf (f,
+"@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n\
+@prefix doap:  <http://usefulinc.com/ns/doap#> .\n\
+@prefix log:   <http://lv2plug.in/ns/ext/log#> .\n\
+@prefix lv2:   <http://lv2plug.in/ns/lv2core#> .\n\
+@prefix midi:  <http://lv2plug.in/ns/ext/midi#> .\n\
+@prefix patch: <http://lv2plug.in/ns/ext/patch#> .\n\
+@prefix pprop: <http://lv2plug.in/ns/ext/port-props#> .\n\
+@prefix rdf:   <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n\
+@prefix rdfs:  <http://www.w3.org/2000/01/rdf-schema#> .\n\
+@prefix rsz:   <http://lv2plug.in/ns/ext/resize-port#> .\n\
+@prefix time:  <http://lv2plug.in/ns/ext/time#> .\n\
+@prefix urid:  <http://lv2plug.in/ns/ext/urid#> .\n\
+@prefix ui:    <http://lv2plug.in/ns/extensions/ui#> .\n\
+@prefix units: <http://lv2plug.in/ns/extensions/units#> .\n\
+@prefix work:  <http://lv2plug.in/ns/ext/worker#> .\n\n");
+
+  fprintf (f,
+"<" PLUGIN_URI ">\n\
+  a lv2:Plugin,\n\
+    lv2:" PLUGIN_TYPE " ;\n\
+  doap:name \"" PLUGIN_NAME "\" ;\n\
+  doap:license <https://www.gnu.org/licenses/agpl-3.0.html> ;\n\
+  lv2:project <" PROJECT_URI "> ;\n\
+  lv2:requiredFeature urid:map ;\n\
+  lv2:optionalFeature log:log ,\n\
+                      lv2:hardRTCapable ;\n\
+  lv2:port [\n\
+    a lv2:InputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 0 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"control\" ;\n\
+    lv2:name \"Control\" ;\n\
+    rdfs:comment \"GUI/host to plugin communication\" ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      atom:AtomPort ;\n\
+    atom:bufferType atom:Sequence ;\n\
+    lv2:index 1 ;\n\
+    lv2:designation lv2:control ;\n\
+    lv2:symbol \"notify\" ;\n\
+    lv2:name \"Notify\" ;\n\
+    rdfs:comment \"Plugin to GUI communication\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 2 ;\n\
+    lv2:symbol \"carrier_in\" ;\n\
+    lv2:name \"Carrier In\" ;\n\
+    rdfs:comment \"Signal to be filtered, usually a synth\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 3 ;\n\
+    lv2:symbol \"modulator_in\" ;\n\
+    lv2:name \"Modulator In\" ;\n\
+    lv2:portProperty lv2:isSideChain ;\n\
+    rdfs:comment \"Signal whose spectral envelope is applied to the carrier, usually a voice\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 4 ;\n\
+    lv2:symbol \"bands\" ;\n\
+    lv2:name \"Bands\" ;\n\
+    lv2:default 32 ;\n\
+    lv2:minimum 4 ;\n\
+    lv2:maximum %d ;\n\
+    lv2:portProperty lv2:integer ;\n\
+    rdfs:comment \"Number of bands\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 5 ;\n\
+    lv2:symbol \"attack\" ;\n\
+    lv2:name \"Attack\" ;\n\
+    lv2:default 0.010000 ;\n\
+    lv2:minimum 0.000100 ;\n\
+    lv2:maximum 0.500000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:s ;\n\
+    rdfs:comment \"Attack time of the band envelope followers\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 6 ;\n\
+    lv2:symbol \"release\" ;\n\
+    lv2:name \"Release\" ;\n\
+    lv2:default 0.050000 ;\n\
+    lv2:minimum 0.000100 ;\n\
+    lv2:maximum 0.500000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:s ;\n\
+    rdfs:comment \"Release time of the band envelope followers\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 7 ;\n\
+    lv2:symbol \"bandwidth\" ;\n\
+    lv2:name \"Bandwidth\" ;\n\
+    lv2:default 1.000000 ;\n\
+    lv2:minimum 0.100000 ;\n\
+    lv2:maximum 2.000000 ;\n\
+    rdfs:comment \"Width of each band, relative to the spacing between bands\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 8 ;\n\
+    lv2:symbol \"low_freq\" ;\n\
+    lv2:name \"Low Frequency\" ;\n\
+    lv2:default 80.000000 ;\n\
+    lv2:minimum 20.000000 ;\n\
+    lv2:maximum 1000.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:hz ;\n\
+    rdfs:comment \"Center frequency of the lowest band\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 9 ;\n\
+    lv2:symbol \"high_freq\" ;\n\
+    lv2:name \"High Frequency\" ;\n\
+    lv2:default 12000.000000 ;\n\
+    lv2:minimum 1000.000000 ;\n\
+    lv2:maximum 20000.000000 ;\n\
+    lv2:portProperty pprop:logarithmic ;\n\
+    units:unit units:hz ;\n\
+    rdfs:comment \"Center frequency of the highest band\" ;\n\
+  ] , [\n\
+    a lv2:InputPort ,\n\
+      lv2:ControlPort ;\n\
+    lv2:index 10 ;\n\
+    lv2:symbol \"gain\" ;\n\
+    lv2:name \"Gain\" ;\n\
+    lv2:default 0.000000 ;\n\
+    lv2:minimum -24.000000 ;\n\
+    lv2:maximum 24.000000 ;\n\
+    units:unit units:db ;\n\
+  ] , [\n\
+    a lv2:OutputPort ,\n\
+      lv2:AudioPort ;\n\
+    lv2:index 11 ;\n\
+    lv2:symbol \"out\" ;\n\
+    lv2:name \"Out\" ;\n\
+  ]", VOCODER_MAX_BANDS);
+
+  plugin_print_dsp_load_ttl (f, VOCODER_DSP_LOAD);
+  plugin_print_enabled_ttl (f, VOCODER_ENABLED);
+  plugin_print_params_ttl (
+    f, vocoder_params, VOCODER_NUM_PARAMS);
+}
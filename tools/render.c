@@ -0,0 +1,1696 @@
+/*
+ * Copyright (C) 2021 Alexandros Theodotou <alex at zrythm dot org>
+ *
+ * This file is part of ZPlugins
+ *
+ * ZPlugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * ZPlugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Affero Public License
+ * along with ZPlugins.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ *
+ * Offline batch renderer.
+ *
+ * Renders audio files through a ZPlugins DSP
+ * library without a host. Each file gets its own
+ * plugin instance and files are rendered in
+ * parallel on a pool of threads.
+ *
+ * The ports of the plugin are read from the .ttl
+ * file next to the DSP library.
+ *
+ * With -c, it instead checks that the plugin gives
+ * the same output when the host processes in place
+ * (audio outputs connected to the buffers of the
+ * inputs, both in order and crossed) as with
+ * separate buffers.
+ */
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef _WOE32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <sndfile.h>
+
+#include "lv2/atom/atom.h"
+#include "lv2/buf-size/buf-size.h"
+#include "lv2/core/lv2.h"
+#include "lv2/log/log.h"
+#include "lv2/options/options.h"
+#include "lv2/parameters/parameters.h"
+#include "lv2/urid/urid.h"
+#include "lv2/worker/worker.h"
+
+/** Default number of frames to process per
+ * run() call. */
+#define DEFAULT_BLOCK_SIZE 8192
+
+/** Size of the buffer of each atom port. */
+#define ATOM_BUF_SIZE 65536
+
+/** Size of the buffer for worker responses. */
+#define WORKER_BUF_SIZE 4096
+
+#define SYMBOL_SIZE 64
+
+/** Samplerate of the in-place check. */
+#define CHECK_SAMPLERATE 48000
+
+/** Length of the in-place check, in frames. */
+#define CHECK_LENGTH (2 * CHECK_SAMPLERATE)
+
+/** The signal of the in-place check switches
+ * between loud and quiet every this many frames,
+ * so that dynamics processors do something. */
+#define CHECK_BURST_LENGTH 12000
+
+/**
+ * How the audio outputs share buffers with the
+ * inputs.
+ */
+typedef enum InPlaceMode
+{
+  /** Separate buffers. */
+  IN_PLACE_NONE,
+
+  /** Output i uses the buffer of input i. */
+  IN_PLACE_SAME,
+
+  /** Output i uses the buffer of input
+   * (num_audio_ins - 1 - i), e.g. the left output
+   * writes over the right input. */
+  IN_PLACE_CROSSED,
+} InPlaceMode;
+
+typedef enum PortType
+{
+  PORT_TYPE_UNKNOWN,
+  PORT_TYPE_CONTROL,
+  PORT_TYPE_AUDIO,
+  PORT_TYPE_CV,
+  PORT_TYPE_ATOM,
+} PortType;
+
+/**
+ * Port description, either from the plugin .ttl
+ * or from a preset.
+ */
+typedef struct PortInfo
+{
+  /** Port index, or -1 if not given. */
+  int           index;
+
+  int           is_input;
+  PortType      type;
+  char          symbol[SYMBOL_SIZE];
+
+  /** Default value (plugin) or value (preset). */
+  float         value;
+  int           has_value;
+} PortInfo;
+
+/**
+ * The loaded plugin library and its ports.
+ */
+typedef struct Plugin
+{
+  /** Library handle. */
+  void *        lib;
+
+  const LV2_Descriptor * descriptor;
+
+  /** Ports, by index. */
+  PortInfo *    ports;
+  int           num_ports;
+
+  int           num_audio_ins;
+  int           num_audio_outs;
+} Plugin;
+
+/**
+ * Settings shared by all jobs.
+ */
+typedef struct RenderSettings
+{
+  Plugin *      plugin;
+
+  /** Max frames per run() call. */
+  uint32_t      block_size;
+
+  /** Seconds to render after the input ends. */
+  double        tail;
+
+  /** How to connect the audio outputs. */
+  InPlaceMode   in_place;
+
+  const char *  out_dir;
+} RenderSettings;
+
+/**
+ * URID map, owned by each instance so that
+ * instances on different threads don't need to
+ * share it.
+ */
+typedef struct UridMap
+{
+  char **       uris;
+  uint32_t      num_uris;
+} UridMap;
+
+/**
+ * Worker that performs the work immediately
+ * (synchronously), as is allowed when rendering
+ * offline.
+ */
+typedef struct Worker
+{
+  const LV2_Worker_Interface * iface;
+  LV2_Handle    handle;
+
+  /** Responses to deliver after run(), each
+   * prefixed with its size. */
+  uint8_t       responses[WORKER_BUF_SIZE];
+  uint32_t      responses_size;
+} Worker;
+
+/**
+ * A plugin instance with its port buffers.
+ */
+typedef struct Instance
+{
+  LV2_Handle    handle;
+  const LV2_Descriptor * descriptor;
+
+  UridMap       urid_map;
+  LV2_URID_Map  map;
+  LV2_URID_Unmap unmap;
+  LV2_Log_Log   log;
+  Worker        worker;
+  LV2_Worker_Schedule schedule;
+
+  int32_t       min_block_length;
+  int32_t       max_block_length;
+  float         samplerate;
+  LV2_Options_Option options[5];
+
+  LV2_Feature   map_feature;
+  LV2_Feature   unmap_feature;
+  LV2_Feature   log_feature;
+  LV2_Feature   schedule_feature;
+  LV2_Feature   options_feature;
+  LV2_Feature   bounded_block_feature;
+  const LV2_Feature * features[7];
+
+  /** Control port values, by port index. */
+  float *       control_values;
+
+  /** Audio port buffers, in port order. */
+  float **      audio_ins;
+  float **      audio_outs;
+
+  int           num_audio_ins;
+
+  /** How the audio outputs were connected. */
+  InPlaceMode   in_place;
+
+  /** Buffer for all CV inputs (silence). */
+  float *       cv_in;
+
+  /** Buffer for all CV outputs (discarded). */
+  float *       cv_out;
+
+  LV2_Atom_Sequence * atom_in;
+  LV2_Atom_Sequence * atom_out;
+
+  LV2_URID      atom_Sequence;
+  LV2_URID      atom_Chunk;
+} Instance;
+
+typedef struct Job
+{
+  const char *  in_path;
+  char *        out_path;
+} Job;
+
+/**
+ * Jobs to be picked up by the worker threads.
+ */
+typedef struct JobQueue
+{
+  RenderSettings * settings;
+
+  Job *         jobs;
+  int           num_jobs;
+
+  /** Next job to be picked up. */
+  int           next_job;
+
+  /** Number of jobs that failed. */
+  int           num_failed;
+
+  pthread_mutex_t lock;
+} JobQueue;
+
+/**
+ * Instantiation functions may not be called
+ * concurrently for the same plugin.
+ */
+static pthread_mutex_t instantiation_lock =
+  PTHREAD_MUTEX_INITIALIZER;
+
+static LV2_URID
+urid_map (
+  LV2_URID_Map_Handle handle,
+  const char *        uri)
+{
+  UridMap * self = (UridMap *) handle;
+  for (uint32_t i = 0; i < self->num_uris; i++)
+    {
+      if (!strcmp (self->uris[i], uri))
+        return i + 1;
+    }
+
+  char ** uris =
+    realloc (
+      self->uris,
+      (self->num_uris + 1) * sizeof (char *));
+  if (!uris)
+    return 0;
+  self->uris = uris;
+  self->uris[self->num_uris] = strdup (uri);
+  if (!self->uris[self->num_uris])
+    return 0;
+  self->num_uris++;
+
+  return self->num_uris;
+}
+
+static const char *
+urid_unmap (
+  LV2_URID_Unmap_Handle handle,
+  LV2_URID              urid)
+{
+  UridMap * self = (UridMap *) handle;
+  if (urid == 0 || urid > self->num_uris)
+    return NULL;
+
+  return self->uris[urid - 1];
+}
+
+static int
+log_vprintf (
+  LV2_Log_Handle handle,
+  LV2_URID       type,
+  const char *   fmt,
+  va_list        ap)
+{
+  return vfprintf (stderr, fmt, ap);
+}
+
+static int
+log_printf (
+  LV2_Log_Handle handle,
+  LV2_URID       type,
+  const char *   fmt,
+  ...)
+{
+  va_list args;
+  va_start (args, fmt);
+  int ret = log_vprintf (handle, type, fmt, args);
+  va_end (args);
+
+  return ret;
+}
+
+static LV2_Worker_Status
+worker_respond (
+  LV2_Worker_Respond_Handle handle,
+  uint32_t                  size,
+  const void *              data)
+{
+  Worker * self = (Worker *) handle;
+  if (self->responses_size + sizeof (uint32_t) + size >
+        WORKER_BUF_SIZE)
+    return LV2_WORKER_ERR_NO_SPACE;
+
+  memcpy (
+    &self->responses[self->responses_size], &size,
+    sizeof (uint32_t));
+  memcpy (
+    &self->responses[
+      self->responses_size + sizeof (uint32_t)],
+    data, size);
+  self->responses_size += sizeof (uint32_t) + size;
+
+  return LV2_WORKER_SUCCESS;
+}
+
+static LV2_Worker_Status
+worker_schedule (
+  LV2_Worker_Schedule_Handle handle,
+  uint32_t                   size,
+  const void *               data)
+{
+  Worker * self = (Worker *) handle;
+  if (!self->iface)
+    return LV2_WORKER_ERR_UNKNOWN;
+
+  /* there is no real-time constraint, so the work
+   * can be done right away */
+  return
+    self->iface->work (
+      self->handle, worker_respond, self, size, data);
+}
+
+/**
+ * Delivers the responses collected during run().
+ */
+static void
+worker_deliver_responses (
+  Worker * self)
+{
+  /* responses may schedule more work, which may
+   * append more responses */
+  uint32_t offset = 0;
+  while (offset < self->responses_size)
+    {
+      uint32_t size;
+      memcpy (
+        &size, &self->responses[offset],
+        sizeof (uint32_t));
+      offset += sizeof (uint32_t);
+      self->iface->work_response (
+        self->handle, size, &self->responses[offset]);
+      offset += size;
+    }
+  self->responses_size = 0;
+}
+
+/**
+ * Reads the whole file into a newly allocated
+ * string.
+ */
+static char *
+read_file (
+  const char * path)
+{
+  FILE * f = fopen (path, "rb");
+  if (!f)
+    return NULL;
+
+  fseek (f, 0, SEEK_END);
+  long size = ftell (f);
+  fseek (f, 0, SEEK_SET);
+  char * str = NULL;
+  if (size >= 0)
+    {
+      str = malloc ((size_t) size + 1);
+      if (str &&
+          fread (str, 1, (size_t) size, f) !=
+            (size_t) size)
+        {
+          free (str);
+          str = NULL;
+        }
+      else if (str)
+        {
+          str[size] = '\0';
+        }
+    }
+  fclose (f);
+
+  return str;
+}
+
+/**
+ * Reads the next Turtle token.
+ *
+ * This is not a full Turtle parser, only enough
+ * to read the port descriptions of the files
+ * generated by ttl_gen and of LV2 presets.
+ *
+ * @return 0 at the end of the string.
+ */
+static int
+ttl_next_token (
+  const char ** str,
+  char *        token,
+  size_t        token_size)
+{
+  const char * s = *str;
+  size_t len = 0;
+
+  /* skip whitespace and comments */
+  while (*s)
+    {
+      if (*s == '#')
+        {
+          while (*s && *s != '\n')
+            s++;
+        }
+      else if (*s == ' ' || *s == '\t' ||
+               *s == '\n' || *s == '\r')
+        {
+          s++;
+        }
+      else
+        break;
+    }
+  if (!*s)
+    return 0;
+
+  if (strchr ("[];,()", *s))
+    {
+      token[len++] = *s++;
+    }
+  else if (*s == '"' || *s == '<')
+    {
+      /* string (without the quotes) or IRI */
+      char end = *s == '"' ? '"' : '>';
+      if (*s == '<')
+        token[len++] = *s;
+      s++;
+      while (*s && *s != end)
+        {
+          if (*s == '\\' && s[1])
+            s++;
+          if (len < token_size - 1)
+            token[len++] = *s;
+          s++;
+        }
+      if (*s)
+        s++;
+    }
+  else
+    {
+      while (*s && !strchr (" \t\r\n[];,()\"", *s))
+        {
+          if (len < token_size - 1)
+            token[len++] = *s;
+          s++;
+        }
+
+      /* a trailing '.' ends the statement */
+      if (len > 1 && token[len - 1] == '.')
+        {
+          len--;
+          s--;
+        }
+    }
+  token[len] = '\0';
+  *str = s;
+
+  return 1;
+}
+
+/**
+ * Calls the given function for each port block
+ * (the objects of lv2:port) in the Turtle file,
+ * until it returns non-zero.
+ *
+ * @return Non-zero if the file could not be read
+ *   or the function failed.
+ */
+static int
+ttl_foreach_port (
+  const char * path,
+  int (*fn) (const PortInfo *, void *),
+  void *       user_data)
+{
+  char * str = read_file (path);
+  if (!str)
+    return -1;
+
+  const char * s = str;
+  char token[256];
+  char prev[256] = "";
+  int depth = 0;
+  int in_ports = 0;
+  PortInfo port;
+  while (ttl_next_token (&s, token, sizeof (token)))
+    {
+      if (!strcmp (token, "["))
+        {
+          depth++;
+          if (depth == 1 && in_ports)
+            {
+              memset (&port, 0, sizeof (port));
+              port.index = -1;
+            }
+        }
+      else if (!strcmp (token, "]"))
+        {
+          if (depth == 1 && in_ports &&
+              fn (&port, user_data))
+            {
+              free (str);
+              return -1;
+            }
+          depth--;
+        }
+      else if (depth == 0)
+        {
+          if (!strcmp (token, "lv2:port"))
+            in_ports = 1;
+          else if (!strcmp (token, ";") ||
+                   !strcmp (token, "."))
+            in_ports = 0;
+        }
+      else if (depth == 1 && in_ports)
+        {
+          if (!strcmp (prev, "lv2:index"))
+            port.index = atoi (token);
+          else if (!strcmp (prev, "lv2:symbol"))
+            snprintf (
+              port.symbol, SYMBOL_SIZE, "%.*s",
+              SYMBOL_SIZE - 1, token);
+          else if (!strcmp (prev, "lv2:default") ||
+                   !strcmp (prev, "pset:value"))
+            {
+              port.value = strtof (token, NULL);
+              port.has_value = 1;
+            }
+          else if (!strcmp (token, "lv2:InputPort"))
+            port.is_input = 1;
+          else if (!strcmp (token, "lv2:ControlPort"))
+            port.type = PORT_TYPE_CONTROL;
+          else if (!strcmp (token, "lv2:AudioPort"))
+            port.type = PORT_TYPE_AUDIO;
+          else if (!strcmp (token, "lv2:CVPort"))
+            port.type = PORT_TYPE_CV;
+          else if (!strcmp (token, "atom:AtomPort"))
+            port.type = PORT_TYPE_ATOM;
+        }
+
+      strcpy (prev, token);
+    }
+  free (str);
+
+  return 0;
+}
+
+static int
+add_plugin_port (
+  const PortInfo * port,
+  void *           user_data)
+{
+  Plugin * self = (Plugin *) user_data;
+  if (port->index < 0)
+    return 0;
+
+  if (port->index >= self->num_ports)
+    {
+      PortInfo * ports =
+        realloc (
+          self->ports,
+          (size_t) (port->index + 1) *
+            sizeof (PortInfo));
+      if (!ports)
+        {
+          fprintf (
+            stderr, "Failed to allocate the ports\n");
+          return -1;
+        }
+      memset (
+        &ports[self->num_ports], 0,
+        (size_t) (port->index + 1 - self->num_ports) *
+          sizeof (PortInfo));
+      self->ports = ports;
+      self->num_ports = port->index + 1;
+    }
+  self->ports[port->index] = *port;
+
+  return 0;
+}
+
+/**
+ * Sets the value of the control input with the
+ * given symbol.
+ *
+ * @return Non-zero if there is no such port.
+ */
+static int
+plugin_set_port_value (
+  Plugin *     self,
+  const char * symbol,
+  float        value)
+{
+  for (int i = 0; i < self->num_ports; i++)
+    {
+      PortInfo * port = &self->ports[i];
+      if (port->type == PORT_TYPE_CONTROL &&
+          port->is_input &&
+          !strcmp (port->symbol, symbol))
+        {
+          port->value = value;
+          return 0;
+        }
+    }
+
+  return -1;
+}
+
+static int
+apply_preset_port (
+  const PortInfo * port,
+  void *           user_data)
+{
+  Plugin * self = (Plugin *) user_data;
+  if (port->has_value &&
+      plugin_set_port_value (
+        self, port->symbol, port->value))
+    {
+      fprintf (
+        stderr, "Ignoring unknown port '%s' in preset\n",
+        port->symbol);
+    }
+
+  return 0;
+}
+
+/**
+ * Loads the DSP library and reads the ports from
+ * the .ttl next to it.
+ *
+ * @return Non-zero on fail.
+ */
+static int
+plugin_load (
+  Plugin *     self,
+  const char * lib_path)
+{
+#ifdef _WOE32
+  self->lib = LoadLibraryA (lib_path);
+#else
+  self->lib = dlopen (lib_path, RTLD_NOW | RTLD_LOCAL);
+#endif
+  if (!self->lib)
+    {
+      fprintf (
+        stderr, "Failed to load %s\n", lib_path);
+      return -1;
+    }
+
+#ifdef _WOE32
+  LV2_Descriptor_Function get_descriptor =
+    (LV2_Descriptor_Function)
+    GetProcAddress (self->lib, "lv2_descriptor");
+#else
+  LV2_Descriptor_Function get_descriptor =
+    (LV2_Descriptor_Function)
+    dlsym (self->lib, "lv2_descriptor");
+#endif
+  if (!get_descriptor ||
+      !(self->descriptor = get_descriptor (0)))
+    {
+      fprintf (
+        stderr, "%s is not an LV2 plugin\n", lib_path);
+      return -1;
+    }
+
+  /* ZFoo_dsp.so -> ZFoo.ttl */
+  char ttl_path[PATH_MAX];
+  snprintf (ttl_path, sizeof (ttl_path), "%s", lib_path);
+  char * suffix = strstr (ttl_path, "_dsp.");
+  if (!suffix)
+    {
+      fprintf (
+        stderr,
+        "Expected a ZPlugins DSP library "
+        "(Z<name>_dsp.*), got %s\n", lib_path);
+      return -1;
+    }
+  strcpy (suffix, ".ttl");
+
+  if (ttl_foreach_port (
+        ttl_path, add_plugin_port, self))
+    {
+      fprintf (
+        stderr, "Failed to read %s\n", ttl_path);
+      return -1;
+    }
+
+  for (int i = 0; i < self->num_ports; i++)
+    {
+      PortInfo * port = &self->ports[i];
+      if (port->type != PORT_TYPE_AUDIO)
+        continue;
+
+      if (port->is_input)
+        self->num_audio_ins++;
+      else
+        self->num_audio_outs++;
+    }
+
+  return 0;
+}
+
+static void
+plugin_unload (
+  Plugin * self)
+{
+  if (self->lib)
+    {
+#ifdef _WOE32
+      FreeLibrary (self->lib);
+#else
+      dlclose (self->lib);
+#endif
+    }
+  free (self->ports);
+}
+
+static void
+instance_free (
+  Instance * self)
+{
+  if (self->handle)
+    {
+      if (self->descriptor->deactivate)
+        self->descriptor->deactivate (self->handle);
+      pthread_mutex_lock (&instantiation_lock);
+      self->descriptor->cleanup (self->handle);
+      pthread_mutex_unlock (&instantiation_lock);
+    }
+
+  if (self->audio_ins)
+    {
+      for (int i = 0; self->audio_ins[i]; i++)
+        free (self->audio_ins[i]);
+      free (self->audio_ins);
+    }
+  if (self->audio_outs)
+    {
+      for (int i = 0; self->audio_outs[i]; i++)
+        free (self->audio_outs[i]);
+      free (self->audio_outs);
+    }
+  free (self->cv_in);
+  free (self->cv_out);
+  free (self->atom_in);
+  free (self->atom_out);
+  free (self->control_values);
+  for (uint32_t i = 0; i < self->urid_map.num_uris; i++)
+    free (self->urid_map.uris[i]);
+  free (self->urid_map.uris);
+  free (self);
+}
+
+/**
+ * Allocates an array of @p num buffers of
+ * @p size frames, terminated by NULL.
+ */
+static float **
+alloc_buffers (
+  int      num,
+  uint32_t size)
+{
+  float ** bufs = calloc ((size_t) num + 1, sizeof (float *));
+  if (!bufs)
+    return NULL;
+
+  for (int i = 0; i < num; i++)
+    {
+      bufs[i] = calloc (size, sizeof (float));
+      if (!bufs[i])
+        return bufs;
+    }
+
+  return bufs;
+}
+
+/**
+ * Returns the buffer connected to the given audio
+ * output.
+ */
+static float *
+instance_get_audio_out (
+  Instance * self,
+  int        idx)
+{
+  if (idx >= self->num_audio_ins)
+    return self->audio_outs[idx];
+
+  switch (self->in_place)
+    {
+    case IN_PLACE_SAME:
+      return self->audio_ins[idx];
+    case IN_PLACE_CROSSED:
+      return
+        self->audio_ins[self->num_audio_ins - 1 - idx];
+    default:
+      return self->audio_outs[idx];
+    }
+}
+
+/**
+ * Creates and activates an instance of the plugin.
+ *
+ * @return The instance, or NULL on fail.
+ */
+static Instance *
+instance_new (
+  RenderSettings * settings,
+  double           samplerate)
+{
+  Plugin * plugin = settings->plugin;
+  uint32_t block_size = settings->block_size;
+
+  Instance * self = calloc (1, sizeof (Instance));
+  if (!self)
+    return NULL;
+
+  self->descriptor = plugin->descriptor;
+  self->num_audio_ins = plugin->num_audio_ins;
+  self->in_place = settings->in_place;
+
+  /* features */
+  self->map.handle = &self->urid_map;
+  self->map.map = urid_map;
+  self->unmap.handle = &self->urid_map;
+  self->unmap.unmap = urid_unmap;
+  self->log.handle = NULL;
+  self->log.printf = log_printf;
+  self->log.vprintf = log_vprintf;
+  self->schedule.handle = &self->worker;
+  self->schedule.schedule_work = worker_schedule;
+
+  LV2_URID atom_Int =
+    urid_map (&self->urid_map, LV2_ATOM__Int);
+  LV2_URID atom_Float =
+    urid_map (&self->urid_map, LV2_ATOM__Float);
+  self->atom_Sequence =
+    urid_map (&self->urid_map, LV2_ATOM__Sequence);
+  self->atom_Chunk =
+    urid_map (&self->urid_map, LV2_ATOM__Chunk);
+
+  self->min_block_length = 1;
+  self->max_block_length = (int32_t) block_size;
+  self->samplerate = (float) samplerate;
+  LV2_Options_Option options[] = {
+    { LV2_OPTIONS_INSTANCE, 0,
+      urid_map (
+        &self->urid_map, LV2_BUF_SIZE__minBlockLength),
+      sizeof (int32_t), atom_Int,
+      &self->min_block_length },
+    { LV2_OPTIONS_INSTANCE, 0,
+      urid_map (
+        &self->urid_map, LV2_BUF_SIZE__maxBlockLength),
+      sizeof (int32_t), atom_Int,
+      &self->max_block_length },
+    { LV2_OPTIONS_INSTANCE, 0,
+      urid_map (
+        &self->urid_map,
+        LV2_BUF_SIZE__nominalBlockLength),
+      sizeof (int32_t), atom_Int,
+      &self->max_block_length },
+    { LV2_OPTIONS_INSTANCE, 0,
+      urid_map (
+        &self->urid_map, LV2_PARAMETERS__sampleRate),
+      sizeof (float), atom_Float,
+      &self->samplerate },
+    { LV2_OPTIONS_INSTANCE, 0, 0, 0, 0, NULL },
+  };
+  memcpy (self->options, options, sizeof (options));
+
+  self->map_feature =
+    (LV2_Feature) { LV2_URID__map, &self->map };
+  self->unmap_feature =
+    (LV2_Feature) { LV2_URID__unmap, &self->unmap };
+  self->log_feature =
+    (LV2_Feature) { LV2_LOG__log, &self->log };
+  self->schedule_feature =
+    (LV2_Feature) {
+      LV2_WORKER__schedule, &self->schedule };
+  self->options_feature =
+    (LV2_Feature) {
+      LV2_OPTIONS__options, self->options };
+  self->bounded_block_feature =
+    (LV2_Feature) {
+      LV2_BUF_SIZE__boundedBlockLength, NULL };
+  self->features[0] = &self->map_feature;
+  self->features[1] = &self->unmap_feature;
+  self->features[2] = &self->log_feature;
+  self->features[3] = &self->schedule_feature;
+  self->features[4] = &self->options_feature;
+  self->features[5] = &self->bounded_block_feature;
+  self->features[6] = NULL;
+
+  /* buffers */
+  self->control_values =
+    calloc ((size_t) plugin->num_ports, sizeof (float));
+  self->audio_ins =
+    alloc_buffers (plugin->num_audio_ins, block_size);
+  self->audio_outs =
+    alloc_buffers (plugin->num_audio_outs, block_size);
+  self->cv_in = calloc (block_size, sizeof (float));
+  self->cv_out = calloc (block_size, sizeof (float));
+  self->atom_in = calloc (1, ATOM_BUF_SIZE);
+  self->atom_out = calloc (1, ATOM_BUF_SIZE);
+  if (!self->control_values || !self->audio_ins ||
+      !self->audio_outs || !self->cv_in ||
+      !self->cv_out || !self->atom_in ||
+      !self->atom_out)
+    goto fail;
+  for (int i = 0; i < plugin->num_audio_ins; i++)
+    if (!self->audio_ins[i])
+      goto fail;
+  for (int i = 0; i < plugin->num_audio_outs; i++)
+    if (!self->audio_outs[i])
+      goto fail;
+
+  pthread_mutex_lock (&instantiation_lock);
+  self->handle =
+    self->descriptor->instantiate (
+      self->descriptor, samplerate, "",
+      self->features);
+  if (self->handle && self->descriptor->extension_data)
+    {
+      self->worker.iface =
+        (const LV2_Worker_Interface *)
+        self->descriptor->extension_data (
+          LV2_WORKER__interface);
+    }
+  pthread_mutex_unlock (&instantiation_lock);
+  if (!self->handle)
+    {
+      fprintf (
+        stderr, "Failed to instantiate %s\n",
+        self->descriptor->URI);
+      goto fail;
+    }
+  self->worker.handle = self->handle;
+
+  /* connect ports */
+  int audio_in_idx = 0;
+  int audio_out_idx = 0;
+  for (int i = 0; i < plugin->num_ports; i++)
+    {
+      PortInfo * port = &plugin->ports[i];
+      void * buf = NULL;
+      switch (port->type)
+        {
+        case PORT_TYPE_CONTROL:
+          self->control_values[i] = port->value;
+          buf = &self->control_values[i];
+          break;
+        case PORT_TYPE_AUDIO:
+          if (port->is_input)
+            buf = self->audio_ins[audio_in_idx++];
+          else
+            buf =
+              instance_get_audio_out (
+                self, audio_out_idx++);
+          break;
+        case PORT_TYPE_CV:
+          buf = port->is_input ? self->cv_in : self->cv_out;
+          break;
+        case PORT_TYPE_ATOM:
+          buf =
+            port->is_input ?
+              self->atom_in : self->atom_out;
+          break;
+        default:
+          break;
+        }
+      self->descriptor->connect_port (
+        self->handle, (uint32_t) i, buf);
+    }
+
+  if (self->descriptor->activate)
+    self->descriptor->activate (self->handle);
+
+  return self;
+
+fail:
+  instance_free (self);
+  return NULL;
+}
+
+static void
+instance_run (
+  Instance * self,
+  uint32_t   nframes)
+{
+  /* empty input sequence */
+  self->atom_in->atom.type = self->atom_Sequence;
+  self->atom_in->atom.size =
+    sizeof (LV2_Atom_Sequence_Body);
+  self->atom_in->body.unit = 0;
+  self->atom_in->body.pad = 0;
+
+  /* the plugin writes the output sequence over
+   * the chunk */
+  self->atom_out->atom.type = self->atom_Chunk;
+  self->atom_out->atom.size =
+    ATOM_BUF_SIZE - sizeof (LV2_Atom);
+
+  self->descriptor->run (self->handle, nframes);
+
+  if (self->worker.iface)
+    worker_deliver_responses (&self->worker);
+}
+
+/**
+ * Renders the file of the given job.
+ *
+ * @return Non-zero on fail.
+ */
+static int
+render_file (
+  RenderSettings * settings,
+  Job *            job)
+{
+  Plugin * plugin = settings->plugin;
+  uint32_t block_size = settings->block_size;
+  SNDFILE * in_file = NULL;
+  SNDFILE * out_file = NULL;
+  float * in_buf = NULL;
+  float * out_buf = NULL;
+  Instance ** instances = NULL;
+  int num_instances = 0;
+  int ret = -1;
+
+  SF_INFO in_info;
+  memset (&in_info, 0, sizeof (in_info));
+  in_file = sf_open (job->in_path, SFM_READ, &in_info);
+  if (!in_file)
+    {
+      fprintf (
+        stderr, "%s: %s\n", job->in_path,
+        sf_strerror (NULL));
+      goto done;
+    }
+
+  /* a mono plugin processes each channel on its own
+   * instance and a mono file is fed to all inputs
+   * of the plugin */
+  int in_channels = in_info.channels;
+  if (in_channels == plugin->num_audio_ins ||
+      in_channels == 1)
+    {
+      num_instances = 1;
+    }
+  else if (plugin->num_audio_ins == 1)
+    {
+      num_instances = in_channels;
+    }
+  else
+    {
+      fprintf (
+        stderr,
+        "%s: cannot process %d channels with a "
+        "plugin with %d audio inputs\n",
+        job->in_path, in_channels,
+        plugin->num_audio_ins);
+      goto done;
+    }
+  int out_channels =
+    num_instances * plugin->num_audio_outs;
+
+  SF_INFO out_info;
+  memset (&out_info, 0, sizeof (out_info));
+  out_info.samplerate = in_info.samplerate;
+  out_info.channels = out_channels;
+  out_info.format = in_info.format;
+  out_file =
+    sf_open (job->out_path, SFM_WRITE, &out_info);
+  if (!out_file)
+    {
+      fprintf (
+        stderr, "%s: %s\n", job->out_path,
+        sf_strerror (NULL));
+      goto done;
+    }
+  sf_command (
+    out_file, SFC_SET_CLIPPING, NULL, SF_TRUE);
+
+  in_buf =
+    malloc (
+      (size_t) block_size * (size_t) in_channels *
+      sizeof (float));
+  out_buf =
+    malloc (
+      (size_t) block_size * (size_t) out_channels *
+      sizeof (float));
+  instances =
+    calloc ((size_t) num_instances, sizeof (Instance *));
+  if (!in_buf || !out_buf || !instances)
+    goto done;
+  for (int i = 0; i < num_instances; i++)
+    {
+      instances[i] =
+        instance_new (settings, in_info.samplerate);
+      if (!instances[i])
+        goto done;
+    }
+
+  sf_count_t tail_frames =
+    (sf_count_t) (settings->tail * in_info.samplerate);
+  while (1)
+    {
+      sf_count_t nframes =
+        sf_readf_float (in_file, in_buf, block_size);
+      if (nframes <= 0)
+        {
+          /* input finished, render the tail */
+          if (tail_frames <= 0)
+            break;
+
+          nframes =
+            tail_frames < block_size ?
+              tail_frames : block_size;
+          tail_frames -= nframes;
+          memset (
+            in_buf, 0,
+            (size_t) nframes * (size_t) in_channels *
+              sizeof (float));
+        }
+
+      for (int i = 0; i < num_instances; i++)
+        {
+          Instance * inst = instances[i];
+
+          /* deinterleave */
+          for (int j = 0; j < plugin->num_audio_ins; j++)
+            {
+              int ch;
+              if (num_instances > 1)
+                ch = i;
+              else if (in_channels == 1)
+                ch = 0;
+              else
+                ch = j;
+              float * dest = inst->audio_ins[j];
+              for (sf_count_t k = 0; k < nframes; k++)
+                dest[k] = in_buf[k * in_channels + ch];
+            }
+
+          instance_run (inst, (uint32_t) nframes);
+
+          /* interleave */
+          for (int j = 0; j < plugin->num_audio_outs; j++)
+            {
+              int ch = i * plugin->num_audio_outs + j;
+              const float * src =
+                instance_get_audio_out (inst, j);
+              for (sf_count_t k = 0; k < nframes; k++)
+                out_buf[k * out_channels + ch] = src[k];
+            }
+        }
+
+      if (sf_writef_float (out_file, out_buf, nframes) !=
+            nframes)
+        {
+          fprintf (
+            stderr, "%s: %s\n", job->out_path,
+            sf_strerror (out_file));
+          goto done;
+        }
+    }
+
+  ret = 0;
+
+done:
+  if (instances)
+    {
+      for (int i = 0; i < num_instances; i++)
+        {
+          if (instances[i])
+            instance_free (instances[i]);
+        }
+      free (instances);
+    }
+  free (in_buf);
+  free (out_buf);
+  if (in_file)
+    sf_close (in_file);
+  if (out_file)
+    {
+      sf_close (out_file);
+
+      /* don't leave a partial file behind */
+      if (ret)
+        remove (job->out_path);
+    }
+
+  return ret;
+}
+
+/**
+ * Renders a generated signal through 2 instances of
+ * the plugin, one processing in place with the
+ * given mode and one with separate buffers, and
+ * compares their outputs.
+ *
+ * @return Non-zero if they differ or on fail.
+ */
+static int
+check_in_place_mode (
+  RenderSettings * settings,
+  InPlaceMode      mode)
+{
+  Plugin * plugin = settings->plugin;
+  uint32_t block_size = settings->block_size;
+  int ret = -1;
+
+  RenderSettings separate_settings = *settings;
+  separate_settings.in_place = IN_PLACE_NONE;
+  RenderSettings in_place_settings = *settings;
+  in_place_settings.in_place = mode;
+  Instance * separate =
+    instance_new (
+      &separate_settings, CHECK_SAMPLERATE);
+  Instance * in_place =
+    instance_new (
+      &in_place_settings, CHECK_SAMPLERATE);
+  if (!separate || !in_place)
+    goto done;
+
+  /* noise in bursts, different on each input */
+  uint32_t seed = 1;
+  for (uint32_t pos = 0; pos < CHECK_LENGTH;
+       pos += block_size)
+    {
+      uint32_t nframes =
+        CHECK_LENGTH - pos < block_size ?
+          CHECK_LENGTH - pos : block_size;
+
+      for (int i = 0; i < plugin->num_audio_ins; i++)
+        {
+          for (uint32_t j = 0; j < nframes; j++)
+            {
+              seed = seed * 1664525u + 1013904223u;
+              float gain =
+                ((pos + j) / CHECK_BURST_LENGTH) % 2 ?
+                  0.05f : 0.8f;
+              float val =
+                gain *
+                ((float) (seed >> 8) / 8388608.f - 1.f);
+              separate->audio_ins[i][j] = val;
+              in_place->audio_ins[i][j] = val;
+            }
+        }
+
+      instance_run (separate, nframes);
+      instance_run (in_place, nframes);
+
+      for (int i = 0; i < plugin->num_audio_outs; i++)
+        {
+          const float * a =
+            instance_get_audio_out (separate, i);
+          const float * b =
+            instance_get_audio_out (in_place, i);
+          for (uint32_t j = 0; j < nframes; j++)
+            {
+              if (memcmp (&a[j], &b[j], sizeof (float)))
+                {
+                  fprintf (
+                    stderr,
+                    "%s: output %d differs at frame %u "
+                    "when processing in place (%s): "
+                    "%g != %g\n",
+                    plugin->descriptor->URI, i,
+                    pos + j,
+                    mode == IN_PLACE_CROSSED ?
+                      "crossed" : "same channel",
+                    (double) b[j], (double) a[j]);
+                  goto done;
+                }
+            }
+        }
+    }
+
+  ret = 0;
+
+done:
+  if (separate)
+    instance_free (separate);
+  if (in_place)
+    instance_free (in_place);
+
+  return ret;
+}
+
+/**
+ * Checks that the plugin gives the same output
+ * with each way of processing in place as with
+ * separate buffers.
+ *
+ * @return Non-zero if it doesn't or on fail.
+ */
+static int
+check_in_place (
+  RenderSettings * settings)
+{
+  if (check_in_place_mode (settings, IN_PLACE_SAME) ||
+      check_in_place_mode (
+        settings, IN_PLACE_CROSSED))
+    return -1;
+
+  printf (
+    "%s gives the same output in place\n",
+    settings->plugin->descriptor->URI);
+
+  return 0;
+}
+
+static void *
+render_thread (
+  void * data)
+{
+  JobQueue * queue = (JobQueue *) data;
+  while (1)
+    {
+      pthread_mutex_lock (&queue->lock);
+      int idx = queue->next_job++;
+      pthread_mutex_unlock (&queue->lock);
+      if (idx >= queue->num_jobs)
+        break;
+
+      Job * job = &queue->jobs[idx];
+      int ret = render_file (queue->settings, job);
+
+      pthread_mutex_lock (&queue->lock);
+      if (ret)
+        queue->num_failed++;
+      else
+        printf ("%s -> %s\n", job->in_path, job->out_path);
+      pthread_mutex_unlock (&queue->lock);
+    }
+
+  return NULL;
+}
+
+static int
+get_num_cpus (void)
+{
+#ifdef _WOE32
+  SYSTEM_INFO info;
+  GetSystemInfo (&info);
+  return (int) info.dwNumberOfProcessors;
+#else
+  long num_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+  return num_cpus > 0 ? (int) num_cpus : 1;
+#endif
+}
+
+static void
+print_usage (
+  const char * prog)
+{
+  fprintf (
+    stderr,
+    "Usage: %s [OPTION]... DSP_LIB INPUT_FILE...\n"
+    "  or:  %s -c [OPTION]... DSP_LIB\n"
+    "Render audio files through a ZPlugins plugin.\n\n"
+    "  -o DIR       write the output files to DIR "
+    "(required)\n"
+    "  -j THREADS   number of files to render in "
+    "parallel (default: number of CPUs)\n"
+    "  -b FRAMES    frames to process per run "
+    "(default: %d)\n"
+    "  -t SECONDS   seconds to render after the end "
+    "of the input (default: 0)\n"
+    "  -P FILE      apply the port values in the given "
+    "LV2 preset file\n"
+    "  -p SYM=VAL   set the value of a control port "
+    "(may be repeated)\n"
+    "  -i           process in place: connect each "
+    "audio output to the buffer of the matching "
+    "input\n"
+    "  -c           check that processing in place "
+    "gives the same output as separate buffers, on "
+    "a generated signal\n"
+    "  -h           show this help\n",
+    prog, prog, DEFAULT_BLOCK_SIZE);
+}
+
+/**
+ * Returns whether the 2 paths point to the same
+ * existing file.
+ */
+static int
+is_same_file (
+  const char * a,
+  const char * b)
+{
+  char real_a[PATH_MAX];
+  char real_b[PATH_MAX];
+#ifdef _WOE32
+  if (!_fullpath (real_a, a, PATH_MAX) ||
+      !_fullpath (real_b, b, PATH_MAX))
+    return 0;
+#else
+  if (!realpath (a, real_a) || !realpath (b, real_b))
+    return 0;
+#endif
+
+  return !strcmp (real_a, real_b);
+}
+
+int
+main (
+  int    argc,
+  char * argv[])
+{
+  RenderSettings settings;
+  memset (&settings, 0, sizeof (settings));
+  settings.block_size = DEFAULT_BLOCK_SIZE;
+  int num_threads = get_num_cpus ();
+  const char * preset_path = NULL;
+  int check = 0;
+
+  /* port values are applied after the preset */
+  const char ** port_values =
+    calloc ((size_t) argc, sizeof (char *));
+  if (!port_values)
+    return 1;
+  int num_port_values = 0;
+
+  int opt;
+  while ((opt = getopt (argc, argv, "o:j:b:t:P:p:ich")) != -1)
+    {
+      switch (opt)
+        {
+        case 'o':
+          settings.out_dir = optarg;
+          break;
+        case 'j':
+          num_threads = atoi (optarg);
+          break;
+        case 'b':
+          settings.block_size =
+            (uint32_t) strtoul (optarg, NULL, 10);
+          break;
+        case 't':
+          settings.tail = strtod (optarg, NULL);
+          break;
+        case 'P':
+          preset_path = optarg;
+          break;
+        case 'p':
+          port_values[num_port_values++] = optarg;
+          break;
+        case 'i':
+          settings.in_place = IN_PLACE_SAME;
+          break;
+        case 'c':
+          check = 1;
+          break;
+        case 'h':
+          print_usage (argv[0]);
+          return 0;
+        default:
+          print_usage (argv[0]);
+          return 1;
+        }
+    }
+
+  if ((check ?
+         argc - optind != 1 :
+         !settings.out_dir || argc - optind < 2) ||
+      num_threads < 1 || settings.block_size < 1)
+    {
+      print_usage (argv[0]);
+      return 1;
+    }
+
+  Plugin plugin;
+  memset (&plugin, 0, sizeof (plugin));
+  settings.plugin = &plugin;
+  int ret = 1;
+  Job * jobs = NULL;
+  int num_jobs = 0;
+  if (plugin_load (&plugin, argv[optind]))
+    goto done;
+
+  if (plugin.num_audio_ins == 0)
+    {
+      fprintf (
+        stderr, "%s has no audio inputs\n",
+        plugin.descriptor->URI);
+      goto done;
+    }
+
+  if (preset_path &&
+      ttl_foreach_port (
+        preset_path, apply_preset_port, &plugin))
+    {
+      fprintf (
+        stderr, "Failed to read %s\n", preset_path);
+      goto done;
+    }
+
+  for (int i = 0; i < num_port_values; i++)
+    {
+      char symbol[SYMBOL_SIZE];
+      const char * eq = strchr (port_values[i], '=');
+      size_t len =
+        eq ? (size_t) (eq - port_values[i]) : 0;
+      if (!eq || len >= SYMBOL_SIZE)
+        {
+          fprintf (
+            stderr, "Invalid port value '%s'\n",
+            port_values[i]);
+          goto done;
+        }
+      memcpy (symbol, port_values[i], len);
+      symbol[len] = '\0';
+      if (plugin_set_port_value (
+            &plugin, symbol, strtof (eq + 1, NULL)))
+        {
+          fprintf (
+            stderr, "Unknown control port '%s'\n",
+            symbol);
+          goto done;
+        }
+    }
+
+  if (check)
+    {
+      ret = check_in_place (&settings) != 0;
+      goto done;
+    }
+
+  /* create a job for each file */
+  num_jobs = argc - optind - 1;
+  jobs = calloc ((size_t) num_jobs, sizeof (Job));
+  if (!jobs)
+    goto done;
+  for (int i = 0; i < num_jobs; i++)
+    {
+      Job * job = &jobs[i];
+      job->in_path = argv[optind + 1 + i];
+
+      const char * basename = strrchr (job->in_path, '/');
+#ifdef _WOE32
+      const char * basename_win =
+        strrchr (job->in_path, '\\');
+      if (basename_win > basename)
+        basename = basename_win;
+#endif
+      basename = basename ? basename + 1 : job->in_path;
+      size_t size =
+        strlen (settings.out_dir) + strlen (basename) + 2;
+      job->out_path = malloc (size);
+      if (!job->out_path)
+        goto done;
+      snprintf (
+        job->out_path, size, "%s/%s", settings.out_dir,
+        basename);
+      if (is_same_file (job->in_path, job->out_path))
+        {
+          fprintf (
+            stderr, "Refusing to overwrite %s\n",
+            job->in_path);
+          goto done;
+        }
+
+      /* jobs writing the same file would clobber
+       * (and on failure remove) each other's
+       * output */
+      for (int j = 0; j < i; j++)
+        {
+          if (strcmp (
+                jobs[j].out_path, job->out_path) == 0)
+            {
+              fprintf (
+                stderr,
+                "%s and %s would both be written to "
+                "%s\n",
+                jobs[j].in_path, job->in_path,
+                job->out_path);
+              goto done;
+            }
+        }
+    }
+
+  /* render */
+  JobQueue queue;
+  memset (&queue, 0, sizeof (queue));
+  queue.settings = &settings;
+  queue.jobs = jobs;
+  queue.num_jobs = num_jobs;
+  pthread_mutex_init (&queue.lock, NULL);
+  if (num_threads > num_jobs)
+    num_threads = num_jobs;
+  pthread_t * threads =
+    calloc ((size_t) num_threads, sizeof (pthread_t));
+  int num_started = 0;
+  if (threads)
+    {
+      for (; num_started < num_threads; num_started++)
+        {
+          if (pthread_create (
+                &threads[num_started], NULL,
+                render_thread, &queue))
+            break;
+        }
+    }
+  if (num_started == 0)
+    {
+      /* render on this thread */
+      render_thread (&queue);
+    }
+  for (int i = 0; i < num_started; i++)
+    pthread_join (threads[i], NULL);
+  free (threads);
+  pthread_mutex_destroy (&queue.lock);
+
+  ret = queue.num_failed > 0;
+
+done:
+  if (jobs)
+    {
+      for (int i = 0; i < num_jobs; i++)
+        free (jobs[i].out_path);
+      free (jobs);
+    }
+  free (port_values);
+  plugin_unload (&plugin);
+
+  return ret;
+}